@@ -0,0 +1,45 @@
+#include <iostream>
+#include <string>
+#include <zmq.hpp>
+
+const char* const ADMIN_DEFAULT_ENDPOINT = "tcp://127.0.0.1:5557"; // Same as ADMIN_ENDPOINT in the server
+const int ADMIN_TIMEOUT_MS = 2000; // Time to wait for the server to answer
+
+/**
+ * @brief Send one command to the server's admin socket and print the reply
+ *
+ * @param argc number of arguments
+ * @param argv the command, "stats", "csv", "dump <seconds> <path>" or "dump off". Put --endpoint <endpoint>
+ * first to query a server that isn't on this machine's default port.
+ * @return int exit code
+ */
+int main(int argc, char** argv) {
+    std::string endpoint = ADMIN_DEFAULT_ENDPOINT;
+    int first = 1;
+    if(argc > 2 && std::string(argv[1]) == "--endpoint") {
+        endpoint = argv[2];
+        first = 3;
+    }
+    std::string command;
+    for(int i = first; i < argc; i++) {
+        command += (i == first ? "" : " ") + std::string(argv[i]);
+    }
+    if(command.empty()) {
+        command = "stats";
+    }
+
+    zmq::context_t context(1);
+    zmq::socket_t request(context, zmq::socket_type::req);
+    request.setsockopt(ZMQ_RCVTIMEO, ADMIN_TIMEOUT_MS);
+    request.setsockopt(ZMQ_LINGER, 0);
+    request.connect(endpoint);
+    request.send(zmq::buffer(command), zmq::send_flags::none);
+
+    zmq::message_t reply;
+    if(!request.recv(reply, zmq::recv_flags::none)) {
+        std::cout << "No answer from " << endpoint << ", is the server running?\n";
+        return 1;
+    }
+    std::cout << reply.to_string() << "\n";
+    return 0; // Return on end
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * @brief Measure how long the client's frame spends sending its state with the old REQ/REP pattern
+ * and with DEALER/ROUTER as the round trip time to the server grows.
+ */
+void runInputBenchmark();
+
+/**
+ * @brief Measure how long the client takes to read and apply a snapshot as the number of replicated
+ * objects grows, looking objects up by network id and by searching their names.
+ */
+void runSnapshotBenchmark();
+
+/**
+ * @brief Measure how many bytes compressing full and delta snapshots saves and how long it takes as the
+ * number of replicated objects grows
+ */
+void runCompressionBenchmark();
+
+/**
+ * @brief Measure how long testing one box against up to 100000 others takes with a loop over sf::FloatRect and
+ * with each bounds batch kernel
+ */
+void runBoundsBenchmark();
+
+/**
+ * @brief Measure how long the spatial hash and a dynamic AABB tree take to move colliders and answer queries as
+ * the level grows, with and without level-wide colliders
+ */
+void runBroadphaseBenchmark();
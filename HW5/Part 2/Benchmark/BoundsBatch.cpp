@@ -0,0 +1,383 @@
+#include "BoundsBatch.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX2__)
+#define BOUNDS_BATCH_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOUNDS_BATCH_SSE
+#endif
+
+#if defined(BOUNDS_BATCH_AVX2)
+#include <immintrin.h>
+#elif defined(BOUNDS_BATCH_SSE)
+#include <emmintrin.h>
+#endif
+
+const float BOUNDS_BATCH_EMPTY = std::numeric_limits<float>::infinity(); // Padding and boxes with no area are stored inside out by this much
+
+/**
+ * @brief Sides of the box being checked, with its width and height made positive
+ */
+struct BoundsQuery {
+    float left; // Left side
+    float top; // Top side
+    float right; // Right side
+    float bottom; // Bottom side
+};
+
+/**
+ * @brief Get the sides of a box the way the kernels compare them
+ *
+ * @param bounds box to check
+ * @param query filled with the sides of the box
+ * @return bool whether the box has any area, one without can't overlap anything
+ */
+static bool makeBoundsQuery(const sf::FloatRect& bounds, BoundsQuery& query) {
+    query.left = std::min(bounds.left, bounds.left + bounds.width);
+    query.right = std::max(bounds.left, bounds.left + bounds.width);
+    query.top = std::min(bounds.top, bounds.top + bounds.height);
+    query.bottom = std::max(bounds.top, bounds.top + bounds.height);
+    return query.left < query.right && query.top < query.bottom;
+}
+
+/**
+ * @brief Count the set bits of a mask
+ *
+ * @param bits mask to count
+ * @return size_t number of bits set
+ */
+static size_t countBits(uint32_t bits) {
+    size_t count = 0;
+    while(bits) {
+        bits &= bits - 1;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Get the lowest set bit of a mask that has one
+ *
+ * @param bits mask with at least one bit set
+ * @return size_t index of the lowest bit set
+ */
+static size_t getLowestBit(uint32_t bits) {
+    size_t index = 0;
+    while(!(bits & 1)) {
+        bits >>= 1;
+        index++;
+    }
+    return index;
+}
+
+/**
+ * @brief Test a box against one box of the batch
+ *
+ * @param query sides of the box being checked
+ * @param left left sides of the batch
+ * @param top top sides of the batch
+ * @param right right sides of the batch
+ * @param bottom bottom sides of the batch
+ * @param index box of the batch to test
+ * @return uint32_t 1 if they overlap, otherwise 0
+ */
+static inline uint32_t testScalar(const BoundsQuery& query, const float* left, const float* top, const float* right, const float* bottom, size_t index) {
+    return left[index] < query.right && query.left < right[index] && top[index] < query.bottom && query.top < bottom[index];
+}
+
+#if defined(BOUNDS_BATCH_SSE)
+/**
+ * @brief Test a box against 4 boxes of the batch
+ *
+ * @param query sides of the box being checked, each repeated in every lane
+ * @param left left sides of the batch
+ * @param top top sides of the batch
+ * @param right right sides of the batch
+ * @param bottom bottom sides of the batch
+ * @param index first of the 4 boxes to test
+ * @return uint32_t bit i set if box index + i overlaps
+ */
+static inline uint32_t testSse(const __m128 query[4], const float* left, const float* top, const float* right, const float* bottom, size_t index) {
+    __m128 overlap = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(left + index), query[2]), _mm_cmplt_ps(query[0], _mm_loadu_ps(right + index)));
+    overlap = _mm_and_ps(overlap, _mm_cmplt_ps(_mm_loadu_ps(top + index), query[3]));
+    overlap = _mm_and_ps(overlap, _mm_cmplt_ps(query[1], _mm_loadu_ps(bottom + index)));
+    return static_cast<uint32_t>(_mm_movemask_ps(overlap));
+}
+#endif
+
+#if defined(BOUNDS_BATCH_AVX2)
+/**
+ * @brief Test a box against 8 boxes of the batch
+ *
+ * @param query sides of the box being checked, each repeated in every lane
+ * @param left left sides of the batch
+ * @param top top sides of the batch
+ * @param right right sides of the batch
+ * @param bottom bottom sides of the batch
+ * @param index first of the 8 boxes to test
+ * @return uint32_t bit i set if box index + i overlaps
+ */
+static inline uint32_t testAvx2(const __m256 query[4], const float* left, const float* top, const float* right, const float* bottom, size_t index) {
+    __m256 overlap = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(left + index), query[2], _CMP_LT_OQ), _mm256_cmp_ps(query[0], _mm256_loadu_ps(right + index), _CMP_LT_OQ));
+    overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(top + index), query[3], _CMP_LT_OQ));
+    overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(query[1], _mm256_loadu_ps(bottom + index), _CMP_LT_OQ));
+    return static_cast<uint32_t>(_mm256_movemask_ps(overlap));
+}
+#endif
+
+/**
+ * @brief Construct an empty Bounds Batch object
+ */
+BoundsBatch::BoundsBatch() {
+    this->count = 0;
+}
+
+/**
+ * @brief Construct a Bounds Batch object holding a list of boxes
+ *
+ * @param bounds boxes to hold, in order
+ */
+BoundsBatch::BoundsBatch(const std::vector<sf::FloatRect>& bounds) {
+    this->count = 0;
+    reserve(bounds.size());
+    for(const sf::FloatRect& box : bounds) {
+        add(box);
+    }
+}
+
+/**
+ * @brief Remove every box, keeping the memory
+ */
+void BoundsBatch::clear() {
+    this->left.clear();
+    this->top.clear();
+    this->right.clear();
+    this->bottom.clear();
+    this->count = 0;
+}
+
+/**
+ * @brief Make room for a number of boxes
+ *
+ * @param count boxes to make room for
+ */
+void BoundsBatch::reserve(size_t count) {
+    size_t padded = (count + BOUNDS_BATCH_LANES - 1) / BOUNDS_BATCH_LANES * BOUNDS_BATCH_LANES;
+    this->left.reserve(padded);
+    this->top.reserve(padded);
+    this->right.reserve(padded);
+    this->bottom.reserve(padded);
+}
+
+/**
+ * @brief Add a box at the end
+ *
+ * @param bounds box to add
+ */
+void BoundsBatch::add(const sf::FloatRect& bounds) {
+    if(this->count == this->left.size()) {
+        // Grow by a whole chunk of padding so the kernels never need a loop for the last few boxes
+        this->left.resize(this->count + BOUNDS_BATCH_LANES, BOUNDS_BATCH_EMPTY);
+        this->top.resize(this->count + BOUNDS_BATCH_LANES, BOUNDS_BATCH_EMPTY);
+        this->right.resize(this->count + BOUNDS_BATCH_LANES, -BOUNDS_BATCH_EMPTY);
+        this->bottom.resize(this->count + BOUNDS_BATCH_LANES, -BOUNDS_BATCH_EMPTY);
+    }
+    this->count++;
+    set(this->count - 1, bounds);
+}
+
+/**
+ * @brief Replace a box
+ *
+ * @param index index of the box
+ * @param bounds new box
+ */
+void BoundsBatch::set(size_t index, const sf::FloatRect& bounds) {
+    BoundsQuery sides;
+    if(!makeBoundsQuery(bounds, sides)) {
+        // Inside out, so it can't overlap anything
+        sides = BoundsQuery{BOUNDS_BATCH_EMPTY, BOUNDS_BATCH_EMPTY, -BOUNDS_BATCH_EMPTY, -BOUNDS_BATCH_EMPTY};
+    }
+    this->left[index] = sides.left;
+    this->top[index] = sides.top;
+    this->right[index] = sides.right;
+    this->bottom[index] = sides.bottom;
+}
+
+/**
+ * @brief Get the number of boxes
+ *
+ * @return size_t number of boxes
+ */
+size_t BoundsBatch::size() const {
+    return this->count;
+}
+
+/**
+ * @brief Check whether a box overlaps any box in the batch
+ *
+ * @param bounds box to check
+ * @param kernel kernel to use, the widest available if the build can't run it
+ * @return bool whether anything overlaps
+ */
+bool BoundsBatch::overlapsAny(const sf::FloatRect& bounds, BoundsKernel kernel) const {
+    return findFirst(bounds, kernel) != BOUNDS_BATCH_NO_HIT;
+}
+
+/**
+ * @brief Find the first box in the batch a box overlaps
+ *
+ * @param bounds box to check
+ * @param kernel kernel to use, the widest available if the build can't run it
+ * @return size_t index of the first box overlapping, BOUNDS_BATCH_NO_HIT if none do
+ */
+size_t BoundsBatch::findFirst(const sf::FloatRect& bounds, BoundsKernel kernel) const {
+    BoundsQuery query;
+    if(!makeBoundsQuery(bounds, query)) {
+        return BOUNDS_BATCH_NO_HIT;
+    }
+    if(!isBoundsKernelAvailable(kernel)) {
+        kernel = BOUNDS_BATCH_KERNEL;
+    }
+
+    // The padding never overlaps, so every kernel can run over whole chunks
+    const float* left = this->left.data();
+    const float* top = this->top.data();
+    const float* right = this->right.data();
+    const float* bottom = this->bottom.data();
+    size_t padded = this->left.size();
+#if defined(BOUNDS_BATCH_AVX2)
+    if(kernel == BoundsKernel::AVX2) {
+        const __m256 sides[4] = {_mm256_set1_ps(query.left), _mm256_set1_ps(query.top), _mm256_set1_ps(query.right), _mm256_set1_ps(query.bottom)};
+        for(size_t i = 0; i < padded; i += 8) {
+            uint32_t bits = testAvx2(sides, left, top, right, bottom, i);
+            if(bits) {
+                return i + getLowestBit(bits);
+            }
+        }
+        return BOUNDS_BATCH_NO_HIT;
+    }
+#endif
+#if defined(BOUNDS_BATCH_SSE)
+    if(kernel == BoundsKernel::SSE) {
+        const __m128 sides[4] = {_mm_set1_ps(query.left), _mm_set1_ps(query.top), _mm_set1_ps(query.right), _mm_set1_ps(query.bottom)};
+        for(size_t i = 0; i < padded; i += 4) {
+            uint32_t bits = testSse(sides, left, top, right, bottom, i);
+            if(bits) {
+                return i + getLowestBit(bits);
+            }
+        }
+        return BOUNDS_BATCH_NO_HIT;
+    }
+#endif
+    for(size_t i = 0; i < this->count; i++) {
+        if(testScalar(query, left, top, right, bottom, i)) {
+            return i;
+        }
+    }
+    return BOUNDS_BATCH_NO_HIT;
+}
+
+/**
+ * @brief Find every box in the batch a box overlaps
+ *
+ * @param bounds box to check
+ * @param hitMask resized and filled with one bit per box, bit i % 32 of word i / 32 set if box i overlaps
+ * @param kernel kernel to use, the widest available if the build can't run it
+ * @return size_t number of boxes overlapping
+ */
+size_t BoundsBatch::findAll(const sf::FloatRect& bounds, std::vector<uint32_t>& hitMask, BoundsKernel kernel) const {
+    hitMask.assign((this->count + 31) / 32, 0);
+    BoundsQuery query;
+    if(!makeBoundsQuery(bounds, query)) {
+        return 0;
+    }
+    if(!isBoundsKernelAvailable(kernel)) {
+        kernel = BOUNDS_BATCH_KERNEL;
+    }
+
+    // Chunks start on a multiple of their width, so each one's bits land inside a single word
+    const float* left = this->left.data();
+    const float* top = this->top.data();
+    const float* right = this->right.data();
+    const float* bottom = this->bottom.data();
+    size_t padded = this->left.size();
+    size_t hits = 0;
+#if defined(BOUNDS_BATCH_AVX2)
+    if(kernel == BoundsKernel::AVX2) {
+        const __m256 sides[4] = {_mm256_set1_ps(query.left), _mm256_set1_ps(query.top), _mm256_set1_ps(query.right), _mm256_set1_ps(query.bottom)};
+        for(size_t i = 0; i < padded; i += 8) {
+            uint32_t bits = testAvx2(sides, left, top, right, bottom, i);
+            if(bits) {
+                hitMask[i / 32] |= bits << (i % 32);
+                hits += countBits(bits);
+            }
+        }
+        return hits;
+    }
+#endif
+#if defined(BOUNDS_BATCH_SSE)
+    if(kernel == BoundsKernel::SSE) {
+        const __m128 sides[4] = {_mm_set1_ps(query.left), _mm_set1_ps(query.top), _mm_set1_ps(query.right), _mm_set1_ps(query.bottom)};
+        for(size_t i = 0; i < padded; i += 4) {
+            uint32_t bits = testSse(sides, left, top, right, bottom, i);
+            if(bits) {
+                hitMask[i / 32] |= bits << (i % 32);
+                hits += countBits(bits);
+            }
+        }
+        return hits;
+    }
+#endif
+    for(size_t i = 0; i < this->count; i++) {
+        uint32_t bit = testScalar(query, left, top, right, bottom, i);
+        hitMask[i / 32] |= bit << (i % 32);
+        hits += bit;
+    }
+    return hits;
+}
+
+/**
+ * @brief Check whether the build can run a kernel
+ *
+ * @param kernel kernel to check
+ * @return bool whether the kernel was compiled in
+ */
+bool isBoundsKernelAvailable(BoundsKernel kernel) {
+    switch(kernel) {
+        case BoundsKernel::AVX2:
+#if defined(BOUNDS_BATCH_AVX2)
+            return true;
+#else
+            return false;
+#endif
+        case BoundsKernel::SSE:
+#if defined(BOUNDS_BATCH_SSE)
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Get the name of a kernel
+ *
+ * @param kernel kernel to name
+ * @return const char* "scalar", "SSE" or "AVX2"
+ */
+const char* getBoundsKernelName(BoundsKernel kernel) {
+    switch(kernel) {
+        case BoundsKernel::AVX2:
+            return "AVX2";
+        case BoundsKernel::SSE:
+            return "SSE";
+        default:
+            return "scalar";
+    }
+}
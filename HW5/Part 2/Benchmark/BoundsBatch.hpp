@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+
+const size_t BOUNDS_BATCH_NO_HIT = SIZE_MAX; // What findFirst returns when nothing overlaps
+const size_t BOUNDS_BATCH_LANES = 8; // Boxes tested at once by the widest kernel, the arrays are padded to a multiple of it
+
+/**
+ * @brief Which kernel tests a box against a batch
+ */
+enum class BoundsKernel {
+    SCALAR, SSE, AVX2
+};
+
+// Widest kernel this build can run. Picked at compile time, AVX2 needs the compiler told it can use it
+// (-mavx2 or /arch:AVX2), SSE2 is always there on x86-64 and anything else uses the scalar kernel.
+#if defined(__AVX2__)
+const BoundsKernel BOUNDS_BATCH_KERNEL = BoundsKernel::AVX2;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+const BoundsKernel BOUNDS_BATCH_KERNEL = BoundsKernel::SSE;
+#else
+const BoundsKernel BOUNDS_BATCH_KERNEL = BoundsKernel::SCALAR;
+#endif
+
+/**
+ * @brief Many boxes stored as one array per side, so one box can be tested against several of them with a
+ * single instruction. Overlap means the same as sf::FloatRect::intersects, boxes that only touch or have
+ * no area never overlap.
+ */
+class BoundsBatch {
+    public:
+        /**
+         * @brief Construct an empty Bounds Batch object
+         */
+        BoundsBatch();
+
+        /**
+         * @brief Construct a Bounds Batch object holding a list of boxes
+         *
+         * @param bounds boxes to hold, in order
+         */
+        explicit BoundsBatch(const std::vector<sf::FloatRect>& bounds);
+
+        /**
+         * @brief Remove every box, keeping the memory
+         */
+        void clear();
+
+        /**
+         * @brief Make room for a number of boxes
+         *
+         * @param count boxes to make room for
+         */
+        void reserve(size_t count);
+
+        /**
+         * @brief Add a box at the end
+         *
+         * @param bounds box to add
+         */
+        void add(const sf::FloatRect& bounds);
+
+        /**
+         * @brief Replace a box
+         *
+         * @param index index of the box
+         * @param bounds new box
+         */
+        void set(size_t index, const sf::FloatRect& bounds);
+
+        /**
+         * @brief Get the number of boxes
+         *
+         * @return size_t number of boxes
+         */
+        size_t size() const;
+
+        /**
+         * @brief Check whether a box overlaps any box in the batch
+         *
+         * @param bounds box to check
+         * @param kernel kernel to use, the widest available if the build can't run it
+         * @return bool whether anything overlaps
+         */
+        bool overlapsAny(const sf::FloatRect& bounds, BoundsKernel kernel = BOUNDS_BATCH_KERNEL) const;
+
+        /**
+         * @brief Find the first box in the batch a box overlaps
+         *
+         * @param bounds box to check
+         * @param kernel kernel to use, the widest available if the build can't run it
+         * @return size_t index of the first box overlapping, BOUNDS_BATCH_NO_HIT if none do
+         */
+        size_t findFirst(const sf::FloatRect& bounds, BoundsKernel kernel = BOUNDS_BATCH_KERNEL) const;
+
+        /**
+         * @brief Find every box in the batch a box overlaps
+         *
+         * @param bounds box to check
+         * @param hitMask resized and filled with one bit per box, bit i % 32 of word i / 32 set if box i overlaps
+         * @param kernel kernel to use, the widest available if the build can't run it
+         * @return size_t number of boxes overlapping
+         */
+        size_t findAll(const sf::FloatRect& bounds, std::vector<uint32_t>& hitMask, BoundsKernel kernel = BOUNDS_BATCH_KERNEL) const;
+
+    private:
+        std::vector<float> left; // Left side of each box, padded with boxes that never overlap
+        std::vector<float> top; // Top side of each box
+        std::vector<float> right; // Right side of each box
+        std::vector<float> bottom; // Bottom side of each box
+        size_t count; // Boxes in the batch, not counting the padding
+};
+
+/**
+ * @brief Check whether the build can run a kernel
+ *
+ * @param kernel kernel to check
+ * @return bool whether the kernel was compiled in
+ */
+bool isBoundsKernelAvailable(BoundsKernel kernel);
+
+/**
+ * @brief Get the name of a kernel
+ *
+ * @param kernel kernel to name
+ * @return const char* "scalar", "SSE" or "AVX2"
+ */
+const char* getBoundsKernelName(BoundsKernel kernel);
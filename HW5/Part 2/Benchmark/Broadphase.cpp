@@ -0,0 +1,51 @@
+#include "Broadphase.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Destroy the Broadphase object
+ */
+Broadphase::~Broadphase() {}
+
+/**
+ * @brief Find where a line segment enters a box
+ *
+ * @param bounds box to check
+ * @param from start of the segment
+ * @param delta end of the segment less its start
+ * @param maxFraction only hits closer than this along the segment count
+ * @param fraction set to how far along the segment the box is entered, 0 if it starts inside
+ * @return bool whether the segment enters the box before maxFraction
+ */
+bool getRayFraction(const sf::FloatRect& bounds, sf::Vector2f from, sf::Vector2f delta, float maxFraction, float& fraction) {
+    float enter = 0.f;
+    float exit = maxFraction;
+    const float start[2] = {from.x, from.y};
+    const float direction[2] = {delta.x, delta.y};
+    const float low[2] = {bounds.left, bounds.top};
+    const float high[2] = {bounds.left + bounds.width, bounds.top + bounds.height};
+
+    // Clip the segment against the slab between the box's sides on each axis
+    for(int axis = 0; axis < 2; axis++) {
+        if(std::fabs(direction[axis]) < 1e-9f) {
+            if(start[axis] < low[axis] || start[axis] > high[axis]) {
+                return false; // Parallel to the slab and outside it
+            }
+            continue;
+        }
+        float inverse = 1.f / direction[axis];
+        float nearSide = (low[axis] - start[axis]) * inverse;
+        float farSide = (high[axis] - start[axis]) * inverse;
+        if(nearSide > farSide) {
+            std::swap(nearSide, farSide);
+        }
+        enter = std::max(enter, nearSide);
+        exit = std::min(exit, farSide);
+        if(enter > exit) {
+            return false;
+        }
+    }
+    fraction = enter;
+    return true;
+}
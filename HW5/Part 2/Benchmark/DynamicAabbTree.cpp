@@ -0,0 +1,474 @@
+#include "DynamicAabbTree.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Get the box around two boxes
+ *
+ * @param a first box
+ * @param b second box
+ * @return sf::FloatRect smallest box containing both
+ */
+static sf::FloatRect combine(const sf::FloatRect& a, const sf::FloatRect& b) {
+    float left = std::min(a.left, b.left);
+    float top = std::min(a.top, b.top);
+    float right = std::max(a.left + a.width, b.left + b.width);
+    float bottom = std::max(a.top + a.height, b.top + b.height);
+    return sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+/**
+ * @brief Get the perimeter of a box, which is what insertion tries to keep small
+ *
+ * @param bounds box to measure
+ * @return float perimeter of the box
+ */
+static float getPerimeter(const sf::FloatRect& bounds) {
+    return 2.f * (bounds.width + bounds.height);
+}
+
+/**
+ * @brief Check whether one box is entirely inside another
+ *
+ * @param outer box that might contain the other
+ * @param inner box that might be contained
+ * @return bool whether inner is inside outer
+ */
+static bool containsBounds(const sf::FloatRect& outer, const sf::FloatRect& inner) {
+    return outer.left <= inner.left && outer.top <= inner.top &&
+        inner.left + inner.width <= outer.left + outer.width && inner.top + inner.height <= outer.top + outer.height;
+}
+
+/**
+ * @brief Check whether two boxes overlap or touch. Fat bounds are only used to skip subtrees, so touching
+ * counts and the exact check is left to the leaves.
+ *
+ * @param a first box
+ * @param b second box
+ * @return bool whether the boxes overlap or touch
+ */
+static bool overlapsBounds(const sf::FloatRect& a, const sf::FloatRect& b) {
+    return a.left <= b.left + b.width && b.left <= a.left + a.width &&
+        a.top <= b.top + b.height && b.top <= a.top + a.height;
+}
+
+/**
+ * @brief Construct an empty Dynamic Aabb Tree object
+ */
+DynamicAabbTree::DynamicAabbTree() {
+    this->root = AABB_TREE_NULL_NODE;
+    this->freeList = AABB_TREE_NULL_NODE;
+    this->count = 0;
+}
+
+/**
+ * @brief Add a collider as a new leaf
+ *
+ * @param collider collider to add
+ * @param bounds current bounds of the collider
+ * @return uint32_t proxy to update or remove the collider with
+ */
+uint32_t DynamicAabbTree::insert(Collider* collider, const sf::FloatRect& bounds) {
+    int32_t leaf = allocateNode();
+    AabbTreeNode& node = this->nodes[leaf];
+    node.bounds = bounds;
+    node.fatBounds = sf::FloatRect(bounds.left - AABB_TREE_MARGIN, bounds.top - AABB_TREE_MARGIN,
+        bounds.width + 2.f * AABB_TREE_MARGIN, bounds.height + 2.f * AABB_TREE_MARGIN);
+    node.collider = collider;
+    node.height = 0;
+    insertLeaf(leaf);
+    this->count++;
+    return static_cast<uint32_t>(leaf);
+}
+
+/**
+ * @brief Move a collider to new bounds. The leaf is only reinserted if the bounds left its fat bounds.
+ *
+ * @param proxy proxy returned when the collider was added
+ * @param bounds new bounds of the collider
+ */
+void DynamicAabbTree::update(uint32_t proxy, const sf::FloatRect& bounds) {
+    int32_t leaf = static_cast<int32_t>(proxy);
+    AabbTreeNode& node = this->nodes[leaf];
+    sf::Vector2f displacement((bounds.left - node.bounds.left) + (bounds.width - node.bounds.width) / 2.f,
+        (bounds.top - node.bounds.top) + (bounds.height - node.bounds.height) / 2.f);
+    node.bounds = bounds;
+    if(containsBounds(node.fatBounds, bounds)) {
+        return; // Still inside its fat bounds, most moves end here
+    }
+
+    // Fatten the new bounds and stretch them the way the collider is moving so it stays inside for longer
+    sf::FloatRect fat(bounds.left - AABB_TREE_MARGIN, bounds.top - AABB_TREE_MARGIN,
+        bounds.width + 2.f * AABB_TREE_MARGIN, bounds.height + 2.f * AABB_TREE_MARGIN);
+    float stretchX = AABB_TREE_DISPLACEMENT_MULTIPLIER * displacement.x;
+    float stretchY = AABB_TREE_DISPLACEMENT_MULTIPLIER * displacement.y;
+    if(stretchX < 0.f) {
+        fat.left += stretchX;
+    }
+    fat.width += std::abs(stretchX);
+    if(stretchY < 0.f) {
+        fat.top += stretchY;
+    }
+    fat.height += std::abs(stretchY);
+
+    removeLeaf(leaf);
+    this->nodes[leaf].fatBounds = fat;
+    insertLeaf(leaf);
+}
+
+/**
+ * @brief Remove a collider's leaf
+ *
+ * @param proxy proxy returned when the collider was added
+ */
+void DynamicAabbTree::remove(uint32_t proxy) {
+    int32_t leaf = static_cast<int32_t>(proxy);
+    removeLeaf(leaf);
+    freeNode(leaf);
+    this->count--;
+}
+
+/**
+ * @brief Find every collider whose bounds overlap a box
+ *
+ * @param bounds box to check
+ * @param hits cleared and filled with the colliders found
+ */
+void DynamicAabbTree::query(const sf::FloatRect& bounds, std::vector<Collider*>& hits) {
+    hits.clear();
+    if(this->root == AABB_TREE_NULL_NODE) {
+        return;
+    }
+
+    this->stack.clear();
+    this->stack.push_back(this->root);
+    while(!this->stack.empty()) {
+        const AabbTreeNode& node = this->nodes[this->stack.back()];
+        this->stack.pop_back();
+        if(!overlapsBounds(node.fatBounds, bounds)) {
+            continue;
+        }
+        if(node.child1 == AABB_TREE_NULL_NODE) {
+            if(node.bounds.intersects(bounds)) {
+                hits.push_back(node.collider);
+            }
+            continue;
+        }
+        this->stack.push_back(node.child1);
+        this->stack.push_back(node.child2);
+    }
+}
+
+/**
+ * @brief Find every collider whose bounds contain a point
+ *
+ * @param point point to check
+ * @param hits cleared and filled with the colliders found
+ */
+void DynamicAabbTree::queryPoint(sf::Vector2f point, std::vector<Collider*>& hits) {
+    hits.clear();
+    if(this->root == AABB_TREE_NULL_NODE) {
+        return;
+    }
+
+    this->stack.clear();
+    this->stack.push_back(this->root);
+    while(!this->stack.empty()) {
+        const AabbTreeNode& node = this->nodes[this->stack.back()];
+        this->stack.pop_back();
+        const sf::FloatRect& fat = node.fatBounds;
+        if(point.x < fat.left || point.y < fat.top || point.x > fat.left + fat.width || point.y > fat.top + fat.height) {
+            continue;
+        }
+        if(node.child1 == AABB_TREE_NULL_NODE) {
+            if(node.bounds.contains(point)) {
+                hits.push_back(node.collider);
+            }
+            continue;
+        }
+        this->stack.push_back(node.child1);
+        this->stack.push_back(node.child2);
+    }
+}
+
+/**
+ * @brief Find the first collider a line segment hits. Subtrees the segment misses, or only enters past the
+ * closest hit so far, are skipped.
+ *
+ * @param from start of the segment
+ * @param to end of the segment
+ * @param hit filled with the closest collider hit
+ * @param ignore collider to skip, usually whatever cast the ray
+ * @return bool whether anything was hit
+ */
+bool DynamicAabbTree::raycast(sf::Vector2f from, sf::Vector2f to, BroadphaseRayHit& hit, const Collider* ignore) {
+    hit = BroadphaseRayHit{nullptr, 1.f};
+    if(this->root == AABB_TREE_NULL_NODE) {
+        return false;
+    }
+
+    sf::Vector2f delta = to - from;
+    this->stack.clear();
+    this->stack.push_back(this->root);
+    while(!this->stack.empty()) {
+        const AabbTreeNode& node = this->nodes[this->stack.back()];
+        this->stack.pop_back();
+        float fraction;
+        if(!getRayFraction(node.fatBounds, from, delta, hit.fraction, fraction)) {
+            continue;
+        }
+        if(node.child1 == AABB_TREE_NULL_NODE) {
+            if(node.collider != ignore && getRayFraction(node.bounds, from, delta, hit.fraction, fraction) &&
+                (!hit.collider || fraction < hit.fraction)) {
+                hit.collider = node.collider;
+                hit.fraction = fraction;
+            }
+            continue;
+        }
+        this->stack.push_back(node.child1);
+        this->stack.push_back(node.child2);
+    }
+    return hit.collider != nullptr;
+}
+
+/**
+ * @brief Get the number of colliders in the tree
+ *
+ * @return size_t number of colliders
+ */
+size_t DynamicAabbTree::size() const {
+    return this->count;
+}
+
+/**
+ * @brief Get the height of the tree
+ *
+ * @return int32_t height of the root, 0 when the tree is empty or has one leaf
+ */
+int32_t DynamicAabbTree::getHeight() const {
+    if(this->root == AABB_TREE_NULL_NODE) {
+        return 0;
+    }
+    return this->nodes[this->root].height;
+}
+
+/**
+ * @brief Get the fattened bounds of a leaf
+ *
+ * @param proxy proxy returned when the collider was added
+ * @return const sf::FloatRect& fat bounds of the leaf
+ */
+const sf::FloatRect& DynamicAabbTree::getFatBounds(uint32_t proxy) const {
+    return this->nodes[proxy].fatBounds;
+}
+
+/**
+ * @brief Take a node from the free list, growing the pool if it is empty
+ *
+ * @return int32_t index of the node
+ */
+int32_t DynamicAabbTree::allocateNode() {
+    int32_t node;
+    if(this->freeList != AABB_TREE_NULL_NODE) {
+        node = this->freeList;
+        this->freeList = this->nodes[node].parent;
+    }
+    else {
+        node = static_cast<int32_t>(this->nodes.size());
+        this->nodes.push_back(AabbTreeNode());
+    }
+
+    AabbTreeNode& entry = this->nodes[node];
+    entry.collider = nullptr;
+    entry.parent = AABB_TREE_NULL_NODE;
+    entry.child1 = AABB_TREE_NULL_NODE;
+    entry.child2 = AABB_TREE_NULL_NODE;
+    entry.height = 0;
+    return node;
+}
+
+/**
+ * @brief Put a node back on the free list
+ *
+ * @param node index of the node
+ */
+void DynamicAabbTree::freeNode(int32_t node) {
+    AabbTreeNode& entry = this->nodes[node];
+    entry.collider = nullptr;
+    entry.parent = this->freeList;
+    entry.height = -1;
+    this->freeList = node;
+}
+
+/**
+ * @brief Place a leaf next to the sibling that grows the tree's boxes the least, then refit and rebalance
+ * every node above it
+ *
+ * @param leaf index of the leaf
+ */
+void DynamicAabbTree::insertLeaf(int32_t leaf) {
+    if(this->root == AABB_TREE_NULL_NODE) {
+        this->root = leaf;
+        this->nodes[leaf].parent = AABB_TREE_NULL_NODE;
+        return;
+    }
+
+    // Walk down towards the cheapest sibling. Pairing with a node costs the perimeter of the new parent, and
+    // every node above it grows by what that node grows by.
+    sf::FloatRect leafBounds = this->nodes[leaf].fatBounds;
+    int32_t index = this->root;
+    while(this->nodes[index].child1 != AABB_TREE_NULL_NODE) {
+        const AabbTreeNode& node = this->nodes[index];
+        float perimeter = getPerimeter(node.fatBounds);
+        float combinedPerimeter = getPerimeter(combine(node.fatBounds, leafBounds));
+        float cost = 2.f * combinedPerimeter; // Pair with this node
+        float inheritanceCost = 2.f * (combinedPerimeter - perimeter); // Growth of this node if we go further
+
+        float childCost[2];
+        const int32_t children[2] = {node.child1, node.child2};
+        for(int i = 0; i < 2; i++) {
+            const AabbTreeNode& child = this->nodes[children[i]];
+            float grownPerimeter = getPerimeter(combine(child.fatBounds, leafBounds));
+            if(child.child1 != AABB_TREE_NULL_NODE) {
+                grownPerimeter -= getPerimeter(child.fatBounds); // Only the growth is paid for inner nodes
+            }
+            childCost[i] = grownPerimeter + inheritanceCost;
+        }
+
+        if(cost < childCost[0] && cost < childCost[1]) {
+            break;
+        }
+        index = childCost[0] < childCost[1] ? children[0] : children[1];
+    }
+
+    // Put a new parent in the sibling's place with the sibling and the leaf under it
+    int32_t sibling = index;
+    int32_t newParent = allocateNode();
+    AabbTreeNode& parent = this->nodes[newParent];
+    int32_t oldParent = this->nodes[sibling].parent;
+    parent.parent = oldParent;
+    parent.fatBounds = combine(leafBounds, this->nodes[sibling].fatBounds);
+    parent.height = this->nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+    this->nodes[sibling].parent = newParent;
+    this->nodes[leaf].parent = newParent;
+
+    if(oldParent == AABB_TREE_NULL_NODE) {
+        this->root = newParent;
+    }
+    else if(this->nodes[oldParent].child1 == sibling) {
+        this->nodes[oldParent].child1 = newParent;
+    }
+    else {
+        this->nodes[oldParent].child2 = newParent;
+    }
+
+    refit(this->nodes[leaf].parent);
+}
+
+/**
+ * @brief Take a leaf out of the tree, replacing its parent with its sibling, then refit and rebalance every
+ * node above it
+ *
+ * @param leaf index of the leaf
+ */
+void DynamicAabbTree::removeLeaf(int32_t leaf) {
+    if(leaf == this->root) {
+        this->root = AABB_TREE_NULL_NODE;
+        return;
+    }
+
+    int32_t parent = this->nodes[leaf].parent;
+    int32_t grandParent = this->nodes[parent].parent;
+    int32_t sibling = this->nodes[parent].child1 == leaf ? this->nodes[parent].child2 : this->nodes[parent].child1;
+    freeNode(parent);
+
+    if(grandParent == AABB_TREE_NULL_NODE) {
+        this->root = sibling;
+        this->nodes[sibling].parent = AABB_TREE_NULL_NODE;
+        return;
+    }
+
+    if(this->nodes[grandParent].child1 == parent) {
+        this->nodes[grandParent].child1 = sibling;
+    }
+    else {
+        this->nodes[grandParent].child2 = sibling;
+    }
+    this->nodes[sibling].parent = grandParent;
+    refit(grandParent);
+}
+
+/**
+ * @brief Rotate a node's children if one side is more than one level taller than the other
+ *
+ * @param node index of the node
+ * @return int32_t index of the node now in its place
+ */
+int32_t DynamicAabbTree::balance(int32_t node) {
+    AabbTreeNode& a = this->nodes[node];
+    if(a.child1 == AABB_TREE_NULL_NODE) {
+        return node;
+    }
+
+    int32_t indexB = a.child1;
+    int32_t indexC = a.child2;
+    int32_t heightDifference = this->nodes[indexC].height - this->nodes[indexB].height;
+    if(heightDifference >= -1 && heightDifference <= 1) {
+        return node;
+    }
+
+    // Lift the taller child into this node's place. It keeps its taller child and this node takes the other,
+    // the same rotation either way round.
+    int32_t tall = heightDifference > 1 ? indexC : indexB;
+    int32_t shortChild = heightDifference > 1 ? indexB : indexC;
+    AabbTreeNode& lifted = this->nodes[tall];
+    int32_t indexF = lifted.child1;
+    int32_t indexG = lifted.child2;
+
+    lifted.child1 = node;
+    lifted.parent = a.parent;
+    a.parent = tall;
+    if(lifted.parent == AABB_TREE_NULL_NODE) {
+        this->root = tall;
+    }
+    else if(this->nodes[lifted.parent].child1 == node) {
+        this->nodes[lifted.parent].child1 = tall;
+    }
+    else {
+        this->nodes[lifted.parent].child2 = tall;
+    }
+
+    int32_t keep = this->nodes[indexF].height > this->nodes[indexG].height ? indexF : indexG;
+    int32_t give = keep == indexF ? indexG : indexF;
+    lifted.child2 = keep;
+    a.child1 = shortChild;
+    a.child2 = give;
+    this->nodes[give].parent = node;
+
+    a.fatBounds = combine(this->nodes[shortChild].fatBounds, this->nodes[give].fatBounds);
+    a.height = 1 + std::max(this->nodes[shortChild].height, this->nodes[give].height);
+    lifted.fatBounds = combine(a.fatBounds, this->nodes[keep].fatBounds);
+    lifted.height = 1 + std::max(a.height, this->nodes[keep].height);
+    return tall;
+}
+
+/**
+ * @brief Recompute the box and height of every node from one up to the root, rebalancing on the way
+ *
+ * @param node first node to refit
+ */
+void DynamicAabbTree::refit(int32_t node) {
+    int32_t index = node;
+    while(index != AABB_TREE_NULL_NODE) {
+        index = balance(index);
+        AabbTreeNode& entry = this->nodes[index];
+        const AabbTreeNode& child1 = this->nodes[entry.child1];
+        const AabbTreeNode& child2 = this->nodes[entry.child2];
+        entry.height = 1 + std::max(child1.height, child2.height);
+        entry.fatBounds = combine(child1.fatBounds, child2.fatBounds);
+        index = entry.parent;
+    }
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+
+#include "Broadphase.hpp"
+
+const float AABB_TREE_MARGIN = 4.f; // Leaves are fattened by this much on every side so small moves don't reinsert them
+const float AABB_TREE_DISPLACEMENT_MULTIPLIER = 4.f; // Leaves are also stretched this many moves ahead in the direction they moved
+const int32_t AABB_TREE_NULL_NODE = -1; // Index of a node that doesn't exist
+
+/**
+ * @brief A node of the tree. Leaves hold one collider, inner nodes hold the box around both children.
+ */
+struct AabbTreeNode {
+    sf::FloatRect fatBounds; // Box around the children, or the fattened bounds of a leaf
+    sf::FloatRect bounds; // Exact bounds of a leaf's collider when it was last updated
+    Collider* collider; // Collider of a leaf, nullptr for inner and free nodes
+    int32_t parent; // Parent node, or the next free node when the node is free
+    int32_t child1; // First child, AABB_TREE_NULL_NODE for leaves
+    int32_t child2; // Second child, AABB_TREE_NULL_NODE for leaves
+    int32_t height; // Height of the subtree, 0 for leaves and -1 for free nodes
+};
+
+/**
+ * @brief Dynamic bounding volume hierarchy broadphase. Every collider is a leaf of a balanced binary tree and
+ * every inner node is the box around its two children, so queries skip whole subtrees that don't overlap.
+ * Unlike a grid it doesn't care how large or small colliders are, a death zone 20000 wide is one leaf like a
+ * bullet is. Leaves are fattened, so a collider only moves in the tree once it leaves its fat bounds.
+ * Proxies are leaf indices and stay the same while the collider is in the tree.
+ */
+class DynamicAabbTree : public Broadphase {
+    public:
+        /**
+         * @brief Construct an empty Dynamic Aabb Tree object
+         */
+        DynamicAabbTree();
+
+        /**
+         * @brief Add a collider as a new leaf
+         *
+         * @param collider collider to add
+         * @param bounds current bounds of the collider
+         * @return uint32_t proxy to update or remove the collider with
+         */
+        uint32_t insert(Collider* collider, const sf::FloatRect& bounds) override;
+
+        /**
+         * @brief Move a collider to new bounds. The leaf is only reinserted if the bounds left its fat bounds.
+         *
+         * @param proxy proxy returned when the collider was added
+         * @param bounds new bounds of the collider
+         */
+        void update(uint32_t proxy, const sf::FloatRect& bounds) override;
+
+        /**
+         * @brief Remove a collider's leaf
+         *
+         * @param proxy proxy returned when the collider was added
+         */
+        void remove(uint32_t proxy) override;
+
+        /**
+         * @brief Find every collider whose bounds overlap a box
+         *
+         * @param bounds box to check
+         * @param hits cleared and filled with the colliders found
+         */
+        void query(const sf::FloatRect& bounds, std::vector<Collider*>& hits) override;
+
+        /**
+         * @brief Find every collider whose bounds contain a point
+         *
+         * @param point point to check
+         * @param hits cleared and filled with the colliders found
+         */
+        void queryPoint(sf::Vector2f point, std::vector<Collider*>& hits) override;
+
+        /**
+         * @brief Find the first collider a line segment hits. Subtrees the segment misses, or only enters
+         * past the closest hit so far, are skipped.
+         *
+         * @param from start of the segment
+         * @param to end of the segment
+         * @param hit filled with the closest collider hit
+         * @param ignore collider to skip, usually whatever cast the ray
+         * @return bool whether anything was hit
+         */
+        bool raycast(sf::Vector2f from, sf::Vector2f to, BroadphaseRayHit& hit, const Collider* ignore = nullptr) override;
+
+        /**
+         * @brief Get the number of colliders in the tree
+         *
+         * @return size_t number of colliders
+         */
+        size_t size() const override;
+
+        /**
+         * @brief Get the height of the tree
+         *
+         * @return int32_t height of the root, 0 when the tree is empty or has one leaf
+         */
+        int32_t getHeight() const;
+
+        /**
+         * @brief Get the fattened bounds of a leaf
+         *
+         * @param proxy proxy returned when the collider was added
+         * @return const sf::FloatRect& fat bounds of the leaf
+         */
+        const sf::FloatRect& getFatBounds(uint32_t proxy) const;
+
+    private:
+        /**
+         * @brief Take a node from the free list, growing the pool if it is empty
+         *
+         * @return int32_t index of the node
+         */
+        int32_t allocateNode();
+
+        /**
+         * @brief Put a node back on the free list
+         *
+         * @param node index of the node
+         */
+        void freeNode(int32_t node);
+
+        /**
+         * @brief Place a leaf next to the sibling that grows the tree's boxes the least, then refit and
+         * rebalance every node above it
+         *
+         * @param leaf index of the leaf
+         */
+        void insertLeaf(int32_t leaf);
+
+        /**
+         * @brief Take a leaf out of the tree, replacing its parent with its sibling, then refit and rebalance
+         * every node above it
+         *
+         * @param leaf index of the leaf
+         */
+        void removeLeaf(int32_t leaf);
+
+        /**
+         * @brief Rotate a node's children if one side is more than one level taller than the other
+         *
+         * @param node index of the node
+         * @return int32_t index of the node now in its place
+         */
+        int32_t balance(int32_t node);
+
+        /**
+         * @brief Recompute the box and height of every node from one up to the root, rebalancing on the way
+         *
+         * @param node first node to refit
+         */
+        void refit(int32_t node);
+
+        std::vector<AabbTreeNode> nodes; // Every node, used or free
+        int32_t root; // Index of the root, AABB_TREE_NULL_NODE when the tree is empty
+        int32_t freeList; // First free node
+        size_t count; // Leaves in the tree
+        std::vector<int32_t> stack; // Reused by queries to walk the tree
+};
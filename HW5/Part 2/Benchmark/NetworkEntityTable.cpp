@@ -0,0 +1,42 @@
+#include "NetworkEntityTable.hpp"
+
+/**
+ * @brief Get the entry of a network id, growing the table if the id is new
+ *
+ * @param id network id
+ * @return NetworkEntity& entry of the id, not bound if the id hasn't been matched yet
+ */
+NetworkEntity& NetworkEntityTable::get(uint16_t id) {
+    if(id >= this->entities.size()) {
+        this->entities.resize(static_cast<size_t>(id) + 1, NetworkEntity{false, SnapshotRecordType::OBJECT, NETWORK_NO_INDEX});
+    }
+    return this->entities[id];
+}
+
+/**
+ * @brief Forget what a network id was matched to, the server may give the id to something else
+ *
+ * @param id network id
+ */
+void NetworkEntityTable::unbind(uint16_t id) {
+    if(id < this->entities.size()) {
+        this->entities[id].bound = false;
+        this->entities[id].index = NETWORK_NO_INDEX;
+    }
+}
+
+/**
+ * @brief Match a network id to a local object or client
+ *
+ * @param id network id
+ * @param type type of the entity
+ * @param index index of the local object or client, NETWORK_NO_INDEX if there is none
+ * @return NetworkEntity& entry of the id
+ */
+NetworkEntity& NetworkEntityTable::bind(uint16_t id, SnapshotRecordType type, size_t index) {
+    NetworkEntity& entity = get(id);
+    entity.bound = true;
+    entity.type = type;
+    entity.index = index;
+    return entity;
+}
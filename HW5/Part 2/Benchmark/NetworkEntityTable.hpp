@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Snapshot.hpp"
+
+const size_t NETWORK_NO_INDEX = SIZE_MAX; // Index of an entity that has nothing local to apply it to
+
+/**
+ * @brief What a network id has been matched to locally
+ */
+struct NetworkEntity {
+    bool bound; // Whether the id has been matched yet
+    SnapshotRecordType type; // Type of the entity the id was matched as
+    size_t index; // Index of the local object or client, NETWORK_NO_INDEX if there is none
+};
+
+/**
+ * @brief Dense table from network id to local entity. Ids are compact, so looking one up is a single
+ * index instead of searching every object by name.
+ */
+class NetworkEntityTable {
+    public:
+        /**
+         * @brief Get the entry of a network id, growing the table if the id is new
+         *
+         * @param id network id
+         * @return NetworkEntity& entry of the id, not bound if the id hasn't been matched yet
+         */
+        NetworkEntity& get(uint16_t id);
+
+        /**
+         * @brief Forget what a network id was matched to, the server may give the id to something else
+         *
+         * @param id network id
+         */
+        void unbind(uint16_t id);
+
+        /**
+         * @brief Match a network id to a local object or client
+         *
+         * @param id network id
+         * @param type type of the entity
+         * @param index index of the local object or client, NETWORK_NO_INDEX if there is none
+         * @return NetworkEntity& entry of the id
+         */
+        NetworkEntity& bind(uint16_t id, SnapshotRecordType type, size_t index);
+
+    private:
+        std::vector<NetworkEntity> entities; // Entry of every id seen so far, indexed by id
+};
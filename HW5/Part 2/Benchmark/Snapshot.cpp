@@ -0,0 +1,801 @@
+#include "Snapshot.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+/**
+ * @brief Write a 16 bit value in little-endian order
+ *
+ * @param out where to write
+ * @param value value to write
+ */
+static void writeU16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+/**
+ * @brief Write a 32 bit value in little-endian order
+ *
+ * @param out where to write
+ * @param value value to write
+ */
+static void writeU32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+/**
+ * @brief Write a float as its bit pattern in little-endian order
+ *
+ * @param out where to write
+ * @param value value to write
+ */
+static void writeF32(uint8_t* out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(out, bits);
+}
+
+/**
+ * @brief Read a 16 bit little-endian value
+ *
+ * @param in where to read from
+ * @return uint16_t value read
+ */
+static uint16_t readU16(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+/**
+ * @brief Read a 32 bit little-endian value
+ *
+ * @param in where to read from
+ * @return uint32_t value read
+ */
+static uint32_t readU32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) | (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+/**
+ * @brief Read a float from its little-endian bit pattern
+ *
+ * @param in where to read from
+ * @return float value read
+ */
+static float readF32(const uint8_t* in) {
+    uint32_t bits = readU32(in);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Get the size of the packed positions of a quantized record
+ *
+ * @param fieldMask fields contained in the record
+ * @return size_t size of the packed x and y in bytes
+ */
+static size_t packedPositionSize(uint8_t fieldMask) {
+    int bits = 0;
+    if(fieldMask & FIELD_X) {
+        bits += POSITION_BITS;
+    }
+    if(fieldMask & FIELD_Y) {
+        bits += POSITION_BITS;
+    }
+    return (bits + 7) / 8;
+}
+
+/**
+ * @brief Pack the quantized positions of a record
+ *
+ * @param out where to write
+ * @param fieldMask fields contained in the record
+ * @param x x position
+ * @param y y position
+ */
+static void writePackedPositions(uint8_t* out, uint8_t fieldMask, float x, float y) {
+    const uint64_t mask = (uint64_t(1) << POSITION_BITS) - 1;
+    uint64_t packed = 0;
+    int shift = 0;
+    if(fieldMask & FIELD_X) {
+        packed |= (static_cast<uint64_t>(static_cast<uint32_t>(quantizePosition(x, POSITION_ORIGIN_X))) & mask) << shift;
+        shift += POSITION_BITS;
+    }
+    if(fieldMask & FIELD_Y) {
+        packed |= (static_cast<uint64_t>(static_cast<uint32_t>(quantizePosition(y, POSITION_ORIGIN_Y))) & mask) << shift;
+    }
+    size_t size = packedPositionSize(fieldMask);
+    for(size_t i = 0; i < size; i++) {
+        out[i] = static_cast<uint8_t>(packed >> (i * 8));
+    }
+}
+
+/**
+ * @brief Unpack one quantized position of a record
+ *
+ * @param in start of the packed positions
+ * @param fieldMask fields contained in the record
+ * @param index 0 for x, 1 for y
+ * @return int32_t fixed point position
+ */
+static int32_t readPackedPosition(const uint8_t* in, uint8_t fieldMask, int index) {
+    uint64_t packed = 0;
+    size_t size = packedPositionSize(fieldMask);
+    for(size_t i = 0; i < size; i++) {
+        packed |= static_cast<uint64_t>(in[i]) << (i * 8);
+    }
+    int shift = (index == 1 && (fieldMask & FIELD_X)) ? POSITION_BITS : 0;
+    uint32_t bits = static_cast<uint32_t>((packed >> shift) & ((uint64_t(1) << POSITION_BITS) - 1));
+
+    // Sign extend from POSITION_BITS
+    uint32_t sign = uint32_t(1) << (POSITION_BITS - 1);
+    return static_cast<int32_t>((bits ^ sign) - sign);
+}
+
+/**
+ * @brief Get the size of a record from its field mask
+ *
+ * @param fieldMask fields contained in the record
+ * @return size_t size of the record in bytes
+ */
+static size_t recordSize(uint8_t fieldMask) {
+    size_t size = SNAPSHOT_RECORD_HEADER_SIZE;
+    if(fieldMask & FIELD_FLAGS) {
+        size += 1;
+    }
+    if(fieldMask & FIELD_QUANTIZED) {
+        size += packedPositionSize(fieldMask);
+    }
+    else {
+        if(fieldMask & FIELD_X) {
+            size += 4;
+        }
+        if(fieldMask & FIELD_Y) {
+            size += 4;
+        }
+    }
+    if(fieldMask & FIELD_SIZE) {
+        size += 8;
+    }
+    if(fieldMask & FIELD_SEQUENCE) {
+        size += 4;
+    }
+    return size;
+}
+
+/**
+ * @brief Check if the x and y of a record type are positions in the world
+ *
+ * @param recordType type of record
+ * @return bool whether the record's x and y can be quantized
+ */
+static bool hasWorldPosition(SnapshotRecordType recordType) {
+    return recordType == SnapshotRecordType::OBJECT || recordType == SnapshotRecordType::PLAYER || recordType == SnapshotRecordType::INPUT_ACK;
+}
+
+/**
+ * @brief Turn a position into fixed point, clamped to what fits in POSITION_BITS
+ *
+ * @param value position to quantize
+ * @param origin position the fixed point value is relative to
+ * @return int32_t fixed point position
+ */
+int32_t quantizePosition(float value, float origin) {
+    const double limit = std::ldexp(1.0, POSITION_BITS - 1);
+    double scaled = std::ldexp(static_cast<double>(value) - origin, POSITION_FRACTION_BITS);
+    if(std::isnan(scaled)) {
+        return 0;
+    }
+    scaled = std::min(std::max(scaled, -limit), limit - 1.0);
+    return static_cast<int32_t>(std::lround(scaled));
+}
+
+/**
+ * @brief Turn a fixed point position back into a position. Exact, so every machine gets the same value.
+ *
+ * @param quantized fixed point position
+ * @param origin position the fixed point value is relative to
+ * @return float position
+ */
+float dequantizePosition(int32_t quantized, float origin) {
+    return static_cast<float>(std::ldexp(static_cast<double>(quantized), -POSITION_FRACTION_BITS) + origin);
+}
+
+/**
+ * @brief Round a position to what it will be after being sent, so the sender keeps exactly what the
+ * receiver sees. Returns the position as is when QUANTIZE_POSITIONS is off.
+ *
+ * @param value position to round
+ * @param origin position the fixed point value is relative to
+ * @return float rounded position
+ */
+float snapPosition(float value, float origin) {
+    if(!QUANTIZE_POSITIONS) {
+        return value;
+    }
+    return dequantizePosition(quantizePosition(value, origin), origin);
+}
+
+/**
+ * @brief Get the topic a client's snapshots are published under. The name is zero terminated so that
+ * subscribing to one client's topic never matches another client whose name starts the same way.
+ *
+ * @param clientName name of the client
+ * @return std::string topic to publish or subscribe to
+ */
+std::string getClientTopic(const std::string& clientName) {
+    return clientName + '\0';
+}
+
+/**
+ * @brief Get the current time of a monotonic clock in microseconds. The value wraps around every
+ * ~71 minutes, so only ever compare two timestamps by subtracting them.
+ *
+ * @return uint32_t current timestamp
+ */
+uint32_t getNetworkTime() {
+    auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count());
+}
+
+/**
+ * @brief Construct a new Snapshot Writer object
+ *
+ * @param type type of message to write
+ * @param tick tick the message belongs to
+ */
+SnapshotWriter::SnapshotWriter(SnapshotMessageType type, uint32_t tick) {
+    reset(type, tick);
+}
+
+/**
+ * @brief Clear all records and start a new message, keeping the allocated buffer
+ *
+ * @param type type of message to write
+ * @param tick tick the message belongs to
+ * @param baseTick tick a delta is relative to
+ */
+void SnapshotWriter::reset(SnapshotMessageType type, uint32_t tick, uint32_t baseTick) {
+    this->recordCount = 0;
+    this->buffer.resize(SNAPSHOT_HEADER_SIZE);
+
+    uint8_t* header = this->buffer.data();
+    writeU32(header, SNAPSHOT_MAGIC);
+    header[4] = SNAPSHOT_VERSION;
+    header[5] = static_cast<uint8_t>(type);
+    writeU16(header + 6, 0);
+    writeU32(header + 8, tick);
+    writeU32(header + 12, baseTick);
+    writeU32(header + 16, 0);
+}
+
+/**
+ * @brief Set the timestamp of the message. Clients send the time the message was sent and the
+ * server echoes the newest one it has received from that client.
+ *
+ * @param timestamp timestamp from getNetworkTime
+ */
+void SnapshotWriter::setTimestamp(uint32_t timestamp) {
+    writeU32(this->buffer.data() + 16, timestamp);
+}
+
+/**
+ * @brief Add an object record with every field to the message
+ *
+ * @param id network id of the object
+ * @param name name of the object
+ * @param x x position
+ * @param y y position
+ */
+void SnapshotWriter::addObject(uint16_t id, const std::string& name, float x, float y) {
+    addRecord(SnapshotRecordType::OBJECT, FIELD_ALL, id, name.data(), name.size(), 0, x, y);
+}
+
+/**
+ * @brief Add a player record with every field to the message
+ *
+ * @param id network id of the player
+ * @param name name of the player's client
+ * @param isActive whether the client is still active
+ * @param x x position
+ * @param y y position
+ */
+void SnapshotWriter::addPlayer(uint16_t id, const std::string& name, bool isActive, float x, float y) {
+    addRecord(SnapshotRecordType::PLAYER, FIELD_ALL, id, name.data(), name.size(), isActive ? 1 : 0, x, y);
+}
+
+/**
+ * @brief Add an event record to the message
+ *
+ * @param sequence sequence number of the event in its channel
+ * @param eventType type of event
+ * @param name name the event is about
+ * @param nameLength length of the name
+ */
+void SnapshotWriter::addEvent(uint32_t sequence, SnapshotEventType eventType, const char* name, size_t nameLength) {
+    addRecord(SnapshotRecordType::EVENT, FIELD_FLAGS | FIELD_SEQUENCE, NETWORK_NO_ID, name, nameLength, static_cast<uint8_t>(eventType), 0.f, 0.f, 0.f, 0.f, sequence);
+}
+
+/**
+ * @brief Add a record acknowledging every event up to a sequence number
+ *
+ * @param sequence sequence number of the last event received in order
+ */
+void SnapshotWriter::addEventAck(uint32_t sequence) {
+    addRecord(SnapshotRecordType::EVENT_ACK, FIELD_SEQUENCE, NETWORK_NO_ID, "", 0, 0, 0.f, 0.f, 0.f, 0.f, sequence);
+}
+
+/**
+ * @brief Add a record listing what the client supports
+ *
+ * @param capabilities CAPABILITY_ bits, sent as the record's flags
+ */
+void SnapshotWriter::addCapabilities(uint8_t capabilities) {
+    addRecord(SnapshotRecordType::CAPABILITIES, FIELD_FLAGS, NETWORK_NO_ID, "", 0, capabilities, 0.f, 0.f);
+}
+
+/**
+ * @brief Add a record with the area of the world the client's camera is showing
+ *
+ * @param left left of the view
+ * @param top top of the view
+ * @param width width of the view
+ * @param height height of the view
+ */
+void SnapshotWriter::addView(float left, float top, float width, float height) {
+    addRecord(SnapshotRecordType::VIEW, FIELD_X | FIELD_Y | FIELD_SIZE, NETWORK_NO_ID, "", 0, 0, left, top, width, height);
+}
+
+/**
+ * @brief Add a record with one frame of a client's input
+ *
+ * @param name name of the client
+ * @param sequence sequence number of the input
+ * @param keys keys pressed, packed with packKeys
+ * @param elapsed seconds of the frame the keys were held for
+ */
+void SnapshotWriter::addInput(const std::string& name, uint32_t sequence, uint8_t keys, float elapsed) {
+    addRecord(SnapshotRecordType::INPUT, FIELD_FLAGS | FIELD_X | FIELD_SEQUENCE, NETWORK_NO_ID, name.data(), name.size(), keys, elapsed, 0.f, 0.f, 0.f, sequence);
+}
+
+/**
+ * @brief Add a record with the last input the server has simulated for a client and where that
+ * left the client's player
+ *
+ * @param name name of the client
+ * @param sequence sequence number of the last simulated input
+ * @param x x position of the player after the input
+ * @param y y position of the player after the input
+ */
+void SnapshotWriter::addInputAck(const std::string& name, uint32_t sequence, float x, float y) {
+    addRecord(SnapshotRecordType::INPUT_ACK, FIELD_X | FIELD_Y | FIELD_SEQUENCE, NETWORK_NO_ID, name.data(), name.size(), 0, x, y, 0.f, 0.f, sequence);
+}
+
+/**
+ * @brief Add a record with how long the server's latest ticks took, for load testing
+ *
+ * @param simulationMicros length of the latest simulation tick in microseconds
+ * @param publishMicros length of the latest send tick in microseconds
+ * @param clientCount number of clients connected to the server
+ * @param publishAllocations heap allocations the latest send tick made, sent as the record's width
+ */
+void SnapshotWriter::addServerStats(float simulationMicros, float publishMicros, uint32_t clientCount, uint32_t publishAllocations) {
+    addRecord(SnapshotRecordType::SERVER_STATS, FIELD_X | FIELD_Y | FIELD_SIZE | FIELD_SEQUENCE, NETWORK_NO_ID, "", 0, 0, simulationMicros, publishMicros,
+              static_cast<float>(publishAllocations), 0.f, clientCount);
+}
+
+/**
+ * @brief Add a record with a projectile that hit a replicated entity on the client's screen
+ *
+ * @param targetId network id of the entity hit
+ * @param left left of the projectile
+ * @param top top of the projectile
+ * @param width width of the projectile
+ * @param height height of the projectile
+ */
+void SnapshotWriter::addShot(uint16_t targetId, float left, float top, float width, float height) {
+    addRecord(SnapshotRecordType::SHOT, FIELD_X | FIELD_Y | FIELD_SIZE, targetId, "", 0, 0, left, top, width, height);
+}
+
+/**
+ * @brief Add a record containing only the fields in the field mask
+ *
+ * @param recordType type of record
+ * @param fieldMask fields to write
+ * @param id network id of the entity
+ * @param name name of the entity, at most SNAPSHOT_NAME_LENGTH bytes are used
+ * @param nameLength length of the name
+ * @param flags flags of the entity
+ * @param x x position
+ * @param y y position
+ * @param width width, only written with FIELD_SIZE
+ * @param height height, only written with FIELD_SIZE
+ * @param sequence sequence number, only written with FIELD_SEQUENCE
+ * @return bool whether the record was added, false if the message already holds SNAPSHOT_MAX_RECORDS
+ */
+bool SnapshotWriter::addRecord(SnapshotRecordType recordType, uint8_t fieldMask, uint16_t id, const char* name, size_t nameLength, uint8_t flags, float x, float y, float width, float height, uint32_t sequence) {
+    // The count would wrap and readers would stop at the wrong record
+    if(this->recordCount == SNAPSHOT_MAX_RECORDS) {
+        return false;
+    }
+
+    fieldMask &= ~FIELD_QUANTIZED;
+    if(QUANTIZE_POSITIONS && hasWorldPosition(recordType) && (fieldMask & (FIELD_X | FIELD_Y))) {
+        fieldMask |= FIELD_QUANTIZED;
+    }
+
+    size_t offset = this->buffer.size();
+    this->buffer.resize(offset + recordSize(fieldMask));
+
+    uint8_t* record = this->buffer.data() + offset;
+    record[0] = static_cast<uint8_t>(recordType);
+    record[1] = fieldMask;
+    std::memset(record + 2, 0, SNAPSHOT_NAME_LENGTH);
+    std::memcpy(record + 2, name, std::min(nameLength, SNAPSHOT_NAME_LENGTH));
+    writeU16(record + 2 + SNAPSHOT_NAME_LENGTH, id);
+
+    uint8_t* field = record + SNAPSHOT_RECORD_HEADER_SIZE;
+    if(fieldMask & FIELD_FLAGS) {
+        *field = flags;
+        field += 1;
+    }
+    if(fieldMask & FIELD_QUANTIZED) {
+        writePackedPositions(field, fieldMask, x, y);
+        field += packedPositionSize(fieldMask);
+    }
+    else {
+        if(fieldMask & FIELD_X) {
+            writeF32(field, x);
+            field += 4;
+        }
+        if(fieldMask & FIELD_Y) {
+            writeF32(field, y);
+            field += 4;
+        }
+    }
+    if(fieldMask & FIELD_SIZE) {
+        writeF32(field, width);
+        writeF32(field + 4, height);
+        field += 8;
+    }
+    if(fieldMask & FIELD_SEQUENCE) {
+        writeU32(field, sequence);
+    }
+
+    this->recordCount++;
+    writeU16(this->buffer.data() + 6, this->recordCount);
+    return true;
+}
+
+/**
+ * @brief Swap the encoded message out for another buffer, so a finished message can be handed off
+ * without copying it. The writer keeps the other buffer's memory for the next message.
+ *
+ * @param other buffer to swap with, holds the encoded message afterwards
+ */
+void SnapshotWriter::swapBuffer(std::vector<uint8_t>& other) {
+    std::swap(this->buffer, other);
+}
+
+/**
+ * @brief Get the data of the message
+ *
+ * @return const uint8_t* pointer to the start of the message
+ */
+const uint8_t* SnapshotWriter::data() const {
+    return this->buffer.data();
+}
+
+/**
+ * @brief Get the size of the message
+ *
+ * @return size_t size of the message in bytes
+ */
+size_t SnapshotWriter::size() const {
+    return this->buffer.size();
+}
+
+/**
+ * @brief Construct an empty Snapshot Record View object
+ */
+SnapshotRecordView::SnapshotRecordView() {
+    this->record = nullptr;
+}
+
+/**
+ * @brief Construct a new Snapshot Record View object
+ *
+ * @param record pointer to the start of the record
+ */
+SnapshotRecordView::SnapshotRecordView(const uint8_t* record) {
+    this->record = record;
+}
+
+/**
+ * @brief Get the record type
+ *
+ * @return SnapshotRecordType type of the record
+ */
+SnapshotRecordType SnapshotRecordView::getType() const {
+    return static_cast<SnapshotRecordType>(this->record[0]);
+}
+
+/**
+ * @brief Get the fields contained in the record
+ *
+ * @return uint8_t mask of FIELD_* values
+ */
+uint8_t SnapshotRecordView::getFieldMask() const {
+    return this->record[1];
+}
+
+/**
+ * @brief Check if a field is contained in the record
+ *
+ * @param field FIELD_* value to check
+ * @return bool whether the field is in the record
+ */
+bool SnapshotRecordView::hasField(uint8_t field) const {
+    return (this->record[1] & field) != 0;
+}
+
+/**
+ * @brief Get the network id of the entity in the record
+ *
+ * @return uint16_t network id, NETWORK_NO_ID if the record isn't an entity
+ */
+uint16_t SnapshotRecordView::getId() const {
+    return readU16(this->record + 2 + SNAPSHOT_NAME_LENGTH);
+}
+
+/**
+ * @brief Get the flags byte, 0 if the record doesn't contain it
+ *
+ * @return uint8_t flags of the record
+ */
+uint8_t SnapshotRecordView::getFlags() const {
+    if(!hasField(FIELD_FLAGS)) {
+        return 0;
+    }
+    return this->record[SNAPSHOT_RECORD_HEADER_SIZE];
+}
+
+/**
+ * @brief Get if the player in the record is active
+ *
+ * @return bool whether the player is active
+ */
+bool SnapshotRecordView::isActive() const {
+    return getFlags() != 0;
+}
+
+/**
+ * @brief Get the event type of an event record
+ *
+ * @return SnapshotEventType type of the event
+ */
+SnapshotEventType SnapshotRecordView::getEventType() const {
+    return static_cast<SnapshotEventType>(getFlags());
+}
+
+/**
+ * @brief Get the x position, 0 if the record doesn't contain it
+ *
+ * @return float x position
+ */
+float SnapshotRecordView::getX() const {
+    if(!hasField(FIELD_X)) {
+        return 0.f;
+    }
+    const uint8_t* field = this->record + recordSize(getFieldMask() & FIELD_FLAGS);
+    if(hasField(FIELD_QUANTIZED)) {
+        return dequantizePosition(readPackedPosition(field, getFieldMask(), 0), POSITION_ORIGIN_X);
+    }
+    return readF32(field);
+}
+
+/**
+ * @brief Get the y position, 0 if the record doesn't contain it
+ *
+ * @return float y position
+ */
+float SnapshotRecordView::getY() const {
+    if(!hasField(FIELD_Y)) {
+        return 0.f;
+    }
+    if(hasField(FIELD_QUANTIZED)) {
+        const uint8_t* field = this->record + recordSize(getFieldMask() & FIELD_FLAGS);
+        return dequantizePosition(readPackedPosition(field, getFieldMask(), 1), POSITION_ORIGIN_Y);
+    }
+    return readF32(this->record + recordSize(getFieldMask() & (FIELD_FLAGS | FIELD_X)));
+}
+
+/**
+ * @brief Get the width, 0 if the record doesn't contain it
+ *
+ * @return float width
+ */
+float SnapshotRecordView::getWidth() const {
+    if(!hasField(FIELD_SIZE)) {
+        return 0.f;
+    }
+    return readF32(this->record + recordSize(getFieldMask() & (FIELD_FLAGS | FIELD_X | FIELD_Y | FIELD_QUANTIZED)));
+}
+
+/**
+ * @brief Get the height, 0 if the record doesn't contain it
+ *
+ * @return float height
+ */
+float SnapshotRecordView::getHeight() const {
+    if(!hasField(FIELD_SIZE)) {
+        return 0.f;
+    }
+    return readF32(this->record + recordSize(getFieldMask() & (FIELD_FLAGS | FIELD_X | FIELD_Y | FIELD_QUANTIZED)) + 4);
+}
+
+/**
+ * @brief Get the sequence number, 0 if the record doesn't contain it
+ *
+ * @return uint32_t sequence number
+ */
+uint32_t SnapshotRecordView::getSequence() const {
+    if(!hasField(FIELD_SEQUENCE)) {
+        return 0;
+    }
+    return readU32(this->record + recordSize(getFieldMask() & (FIELD_FLAGS | FIELD_X | FIELD_Y | FIELD_SIZE | FIELD_QUANTIZED)));
+}
+
+/**
+ * @brief Get a pointer to the name bytes in the record
+ *
+ * @return const char* name, zero padded to SNAPSHOT_NAME_LENGTH
+ */
+const char* SnapshotRecordView::getNameData() const {
+    return reinterpret_cast<const char*>(this->record + 2);
+}
+
+/**
+ * @brief Get the name as a string. This allocates, use nameEquals for comparisons.
+ *
+ * @return std::string name in the record
+ */
+std::string SnapshotRecordView::getName() const {
+    const char* name = getNameData();
+    size_t length = 0;
+    while(length < SNAPSHOT_NAME_LENGTH && name[length] != '\0') {
+        length++;
+    }
+    return std::string(name, length);
+}
+
+/**
+ * @brief Compare the name in the record without copying it
+ *
+ * @param name name to compare to
+ * @return bool whether the names match
+ */
+bool SnapshotRecordView::nameEquals(const std::string& name) const {
+    if(name.size() > SNAPSHOT_NAME_LENGTH) {
+        return false;
+    }
+    const char* recordName = getNameData();
+    if(std::memcmp(recordName, name.data(), name.size()) != 0) {
+        return false;
+    }
+    // The record name has to end where the compared name does
+    return name.size() == SNAPSHOT_NAME_LENGTH || recordName[name.size()] == '\0';
+}
+
+/**
+ * @brief Get the size of the record in bytes
+ *
+ * @return size_t size of the record
+ */
+size_t SnapshotRecordView::size() const {
+    return recordSize(getFieldMask());
+}
+
+/**
+ * @brief Construct a new Snapshot Reader object over received bytes. The bytes must outlive the reader.
+ *
+ * @param data received message
+ * @param size size of the received message
+ */
+SnapshotReader::SnapshotReader(const void* data, size_t size) {
+    this->data = static_cast<const uint8_t*>(data);
+    this->size = size;
+    this->offset = SNAPSHOT_HEADER_SIZE;
+    this->recordsRead = 0;
+}
+
+/**
+ * @brief Check the magic, version and that every record fits within the message
+ *
+ * @return bool whether the message can be read
+ */
+bool SnapshotReader::isValid() const {
+    if(this->size < SNAPSHOT_HEADER_SIZE) {
+        return false;
+    }
+    if(readU32(this->data) != SNAPSHOT_MAGIC || this->data[4] != SNAPSHOT_VERSION) {
+        return false;
+    }
+
+    // Walk the records once so nextRecord never reads past the end
+    size_t recordOffset = SNAPSHOT_HEADER_SIZE;
+    for(uint16_t i = 0; i < getRecordCount(); i++) {
+        if(recordOffset + SNAPSHOT_RECORD_HEADER_SIZE > this->size) {
+            return false;
+        }
+        recordOffset += recordSize(this->data[recordOffset + 1]);
+    }
+    return recordOffset == this->size;
+}
+
+/**
+ * @brief Get the Message Type
+ *
+ * @return SnapshotMessageType type of message
+ */
+SnapshotMessageType SnapshotReader::getMessageType() const {
+    return static_cast<SnapshotMessageType>(this->data[5]);
+}
+
+/**
+ * @brief Get the tick the message belongs to. For client state messages this is the last snapshot
+ * tick the client received.
+ *
+ * @return uint32_t tick
+ */
+uint32_t SnapshotReader::getTick() const {
+    return readU32(this->data + 8);
+}
+
+/**
+ * @brief Get the tick a delta snapshot is relative to
+ *
+ * @return uint32_t base tick
+ */
+uint32_t SnapshotReader::getBaseTick() const {
+    return readU32(this->data + 12);
+}
+
+/**
+ * @brief Get the timestamp of the message
+ *
+ * @return uint32_t timestamp
+ */
+uint32_t SnapshotReader::getTimestamp() const {
+    return readU32(this->data + 16);
+}
+
+/**
+ * @brief Get the number of records in the message
+ *
+ * @return uint16_t number of records
+ */
+uint16_t SnapshotReader::getRecordCount() const {
+    return readU16(this->data + 6);
+}
+
+/**
+ * @brief Read the next record of the message
+ *
+ * @param record view to set to the next record
+ * @return bool false once every record has been read
+ */
+bool SnapshotReader::nextRecord(SnapshotRecordView& record) {
+    if(this->recordsRead >= getRecordCount()) {
+        return false;
+    }
+    record = SnapshotRecordView(this->data + this->offset);
+    this->offset += record.size();
+    this->recordsRead++;
+    return true;
+}
@@ -0,0 +1,219 @@
+#include "SnapshotCompression.hpp"
+
+#include <algorithm>
+
+const uint32_t COMPRESSION_NO_POSITION = 0xFFFFFFFF; // Hash table entry that hasn't been seen yet
+
+/**
+ * @brief Read 32 bits in little-endian order
+ *
+ * @param in where to read
+ * @return uint32_t value read
+ */
+static uint32_t readCompressedU32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) | (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+/**
+ * @brief Append 32 bits in little-endian order
+ *
+ * @param out where to append
+ * @param value value to append
+ */
+static void appendCompressedU32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 24));
+}
+
+/**
+ * @brief Append the part of a length that didn't fit in the token
+ *
+ * @param out where to append
+ * @param extra length minus the 15 in the token
+ */
+static void appendExtraLength(std::vector<uint8_t>& out, size_t extra) {
+    while(extra >= 255) {
+        out.push_back(255);
+        extra -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(extra));
+}
+
+/**
+ * @brief Read the part of a length that didn't fit in the token
+ *
+ * @param in where to read, moved past the length
+ * @param end end of the message
+ * @param length length to add to
+ * @return bool false if the message ends inside the length
+ */
+static bool readExtraLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if(in >= end) {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while(byte == 255);
+    return true;
+}
+
+/**
+ * @brief Append a sequence of literals followed by a match
+ *
+ * @param out where to append
+ * @param literals bytes to copy as is
+ * @param literalCount number of literals
+ * @param offset distance back to the match, 0 for the last sequence which has no match
+ * @param matchLength length of the match, at least COMPRESSION_MIN_MATCH unless offset is 0
+ */
+static void appendSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength) {
+    size_t matchCode = offset == 0 ? 0 : matchLength - COMPRESSION_MIN_MATCH;
+    uint8_t token = static_cast<uint8_t>((literalCount < 15 ? literalCount : 15) << 4);
+    token |= static_cast<uint8_t>(matchCode < 15 ? matchCode : 15);
+    out.push_back(token);
+    if(literalCount >= 15) {
+        appendExtraLength(out, literalCount - 15);
+    }
+    out.insert(out.end(), literals, literals + literalCount);
+    if(offset == 0) {
+        return;
+    }
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if(matchCode >= 15) {
+        appendExtraLength(out, matchCode - 15);
+    }
+}
+
+/**
+ * @brief Check if a received message is a compressed snapshot
+ *
+ * @param data received bytes
+ * @param size number of received bytes
+ * @return bool whether the message starts with the compressed magic
+ */
+bool isCompressedSnapshot(const void* data, size_t size) {
+    return size >= COMPRESSED_HEADER_SIZE && readCompressedU32(static_cast<const uint8_t*>(data)) == COMPRESSED_MAGIC;
+}
+
+/**
+ * @brief Decompress a compressed snapshot. The message is never trusted, every length and offset is
+ * checked against both buffers.
+ *
+ * @param data received bytes
+ * @param size number of received bytes
+ * @param out filled with the snapshot, its capacity is kept between messages
+ * @return bool false if the message is corrupt
+ */
+bool decompressSnapshot(const void* data, size_t size, std::vector<uint8_t>& out) {
+    if(!isCompressedSnapshot(data, size)) {
+        return false;
+    }
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    const uint8_t* end = in + size;
+    size_t rawSize = readCompressedU32(in + 4);
+    if(rawSize > COMPRESSION_MAX_SIZE) {
+        return false;
+    }
+    in += COMPRESSED_HEADER_SIZE;
+    out.resize(rawSize);
+
+    size_t written = 0;
+    while(true) {
+        if(in >= end) {
+            return false;
+        }
+        uint8_t token = *in++;
+
+        size_t literalCount = token >> 4;
+        if(literalCount == 15 && !readExtraLength(in, end, literalCount)) {
+            return false;
+        }
+        if(literalCount > static_cast<size_t>(end - in) || literalCount > rawSize - written) {
+            return false;
+        }
+        std::memcpy(out.data() + written, in, literalCount);
+        in += literalCount;
+        written += literalCount;
+        if(in == end) {
+            break; // Last sequence has no match
+        }
+
+        if(end - in < 2) {
+            return false;
+        }
+        size_t offset = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        size_t matchLength = (token & 15) + COMPRESSION_MIN_MATCH;
+        if((token & 15) == 15 && !readExtraLength(in, end, matchLength)) {
+            return false;
+        }
+        if(offset == 0 || offset > written || matchLength > rawSize - written) {
+            return false;
+        }
+        // Byte by byte, a match can overlap the bytes it is writing to repeat a run
+        uint8_t* match = out.data() + written - offset;
+        uint8_t* target = out.data() + written;
+        for(size_t i = 0; i < matchLength; i++) {
+            target[i] = match[i];
+        }
+        written += matchLength;
+    }
+    return written == rawSize;
+}
+
+/**
+ * @brief Construct a new Snapshot Compressor object
+ */
+SnapshotCompressor::SnapshotCompressor() {
+    this->hashTable.resize(static_cast<size_t>(1) << COMPRESSION_HASH_BITS);
+}
+
+/**
+ * @brief Compress a snapshot
+ *
+ * @param data snapshot to compress
+ * @param size size of the snapshot in bytes
+ * @param out filled with the compressed message, its capacity is kept between messages
+ * @return bool false if compressing didn't make the snapshot smaller, send it as is instead
+ */
+bool SnapshotCompressor::compress(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    out.clear();
+    if(size > COMPRESSION_MAX_SIZE) {
+        return false;
+    }
+    appendCompressedU32(out, COMPRESSED_MAGIC);
+    appendCompressedU32(out, static_cast<uint32_t>(size));
+    std::fill(this->hashTable.begin(), this->hashTable.end(), COMPRESSION_NO_POSITION);
+
+    // Greedy, take the first match the hash table finds. Snapshots are small and sent every tick, so
+    // a fast pass beats searching for the longest match.
+    size_t anchor = 0;
+    size_t position = 0;
+    while(position + COMPRESSION_MIN_MATCH <= size) {
+        uint32_t sequence = readCompressedU32(data + position);
+        uint32_t hash = (sequence * 2654435761u) >> (32 - COMPRESSION_HASH_BITS);
+        uint32_t candidate = this->hashTable[hash];
+        this->hashTable[hash] = static_cast<uint32_t>(position);
+
+        if(candidate == COMPRESSION_NO_POSITION || position - candidate > COMPRESSION_MAX_OFFSET || readCompressedU32(data + candidate) != sequence) {
+            position++;
+            continue;
+        }
+
+        size_t matchLength = COMPRESSION_MIN_MATCH;
+        while(position + matchLength < size && data[candidate + matchLength] == data[position + matchLength]) {
+            matchLength++;
+        }
+        appendSequence(out, data + anchor, position - anchor, position - candidate, matchLength);
+        position += matchLength;
+        anchor = position;
+    }
+    appendSequence(out, data + anchor, size - anchor, 0, 0);
+
+    return out.size() < size;
+}
@@ -0,0 +1,161 @@
+#include "SnapshotInterpolator.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Construct a new Snapshot Interpolator object
+ *
+ * @param delay seconds remote entities are drawn behind the server
+ */
+SnapshotInterpolator::SnapshotInterpolator(double delay) {
+    this->delay = delay;
+    this->clockOffset = 0.0;
+    this->hasClock = false;
+}
+
+/**
+ * @brief Add the positions of every entity in a received snapshot
+ *
+ * @param state full world state of the snapshot
+ * @param removed entities removed by the snapshot
+ * @param serverTime server time of the snapshot in seconds
+ * @param localTime local time the snapshot arrived in seconds
+ */
+void SnapshotInterpolator::addSnapshot(const WorldState& state, const std::vector<EntityState>& removed, double serverTime, double localTime) {
+    // Smooth the clock so one late snapshot doesn't make everything jump
+    double offset = localTime - serverTime;
+    if(!this->hasClock) {
+        this->clockOffset = offset;
+        this->hasClock = true;
+    }
+    else {
+        this->clockOffset += (offset - this->clockOffset) * CLOCK_SMOOTHING;
+    }
+
+    for(const EntityState& entityState : state.entities) {
+        InterpolatedEntity& entity = findEntity(entityState);
+        if(entity.removed) {
+            // Came back into view, its old positions would make it slide across from where it left
+            entity.next = 0;
+            entity.count = 0;
+        }
+        entity.latest = entityState;
+        entity.removed = false;
+
+        PositionSample& sample = entity.samples[entity.next];
+        sample.time = serverTime;
+        sample.x = entityState.x;
+        sample.y = entityState.y;
+        entity.next = (entity.next + 1) % INTERPOLATION_SAMPLES;
+        entity.count = std::min(entity.count + 1, INTERPOLATION_SAMPLES);
+    }
+    for(const EntityState& entityState : removed) {
+        findEntity(entityState).removed = true;
+    }
+}
+
+/**
+ * @brief Get the server time entities should be drawn at
+ *
+ * @param localTime current local time in seconds
+ * @return double server time in seconds
+ */
+double SnapshotInterpolator::getRenderTime(double localTime) const {
+    return localTime - this->clockOffset - this->delay;
+}
+
+/**
+ * @brief Get the position of an entity at a server time. Positions between two snapshots are
+ * interpolated, and past the newest snapshot they are extrapolated for up to MAX_EXTRAPOLATION.
+ *
+ * @param entity entity to sample
+ * @param renderTime server time to sample at
+ * @return EntityState latest state of the entity at the sampled position
+ */
+EntityState SnapshotInterpolator::sample(const InterpolatedEntity& entity, double renderTime) const {
+    EntityState state = entity.latest;
+    if(entity.count < 2) {
+        return state;
+    }
+
+    // Walk from the newest sample back to the first one at or before the render time
+    size_t newest = (entity.next + INTERPOLATION_SAMPLES - 1) % INTERPOLATION_SAMPLES;
+    const PositionSample* after = &entity.samples[newest];
+    for(size_t i = 1; i < entity.count; i++) {
+        const PositionSample* before = &entity.samples[(newest + INTERPOLATION_SAMPLES - i) % INTERPOLATION_SAMPLES];
+        if(before->time <= renderTime || i == entity.count - 1) {
+            double span = after->time - before->time;
+            if(span <= 0.0) {
+                break;
+            }
+
+            // Past the newest snapshot this extrapolates, but only so far
+            double latestTime = entity.samples[newest].time + MAX_EXTRAPOLATION;
+            double t = (std::max(std::min(renderTime, latestTime), before->time) - before->time) / span;
+            state.x = before->x + static_cast<float>((after->x - before->x) * t);
+            state.y = before->y + static_cast<float>((after->y - before->y) * t);
+            break;
+        }
+        after = before;
+    }
+    return state;
+}
+
+/**
+ * @brief Get every entity that has been received
+ *
+ * @return std::vector<InterpolatedEntity>& buffered entities
+ */
+std::vector<InterpolatedEntity>& SnapshotInterpolator::getEntities() {
+    return this->entities;
+}
+
+/**
+ * @brief Forget the entities that have been removed from the snapshot
+ */
+void SnapshotInterpolator::clearRemoved() {
+    bool anyRemoved = false;
+    for(const InterpolatedEntity& entity : this->entities) {
+        if(entity.removed) {
+            this->entityIndex[entity.latest.id] = 0;
+            anyRemoved = true;
+        }
+    }
+    if(!anyRemoved) {
+        return;
+    }
+
+    this->entities.erase(std::remove_if(this->entities.begin(), this->entities.end(), [](const InterpolatedEntity& entity) {
+        return entity.removed;
+    }), this->entities.end());
+
+    // Everything after a removed entity moved down
+    for(size_t i = 0; i < this->entities.size(); i++) {
+        this->entityIndex[this->entities[i].latest.id] = i + 1;
+    }
+}
+
+/**
+ * @brief Find the buffered entity for an entity state by its network id, adding it if it's new
+ *
+ * @param entity entity to find
+ * @return InterpolatedEntity& buffered entity
+ */
+InterpolatedEntity& SnapshotInterpolator::findEntity(const EntityState& entity) {
+    if(entity.id >= this->entityIndex.size()) {
+        this->entityIndex.resize(static_cast<size_t>(entity.id) + 1, 0);
+    }
+    size_t& index = this->entityIndex[entity.id];
+    if(index != 0) {
+        return this->entities[index - 1];
+    }
+
+    InterpolatedEntity interpolated;
+    interpolated.latest = entity;
+    interpolated.next = 0;
+    interpolated.count = 0;
+    interpolated.removed = false;
+    this->entities.push_back(interpolated);
+    index = this->entities.size();
+    return this->entities.back();
+}
@@ -0,0 +1,281 @@
+#include "SpatialHash.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+const float SPATIAL_HASH_MAX_COORDINATE = 1073741824.f; // Cells past 2^30 in any direction are clamped to it
+
+/**
+ * @brief Construct an empty Spatial Hash object
+ *
+ * @param cellSize width and height of a cell
+ */
+SpatialHash::SpatialHash(float cellSize) {
+    this->cellSize = cellSize;
+    this->queryStamp = 0;
+    this->count = 0;
+}
+
+/**
+ * @brief Add a collider
+ *
+ * @param collider collider to add
+ * @param bounds current bounds of the collider
+ * @return uint32_t proxy to update or remove the collider with
+ */
+uint32_t SpatialHash::insert(Collider* collider, const sf::FloatRect& bounds) {
+    uint32_t proxy;
+    if(!this->freeProxies.empty()) {
+        proxy = this->freeProxies.back();
+        this->freeProxies.pop_back();
+    }
+    else {
+        proxy = static_cast<uint32_t>(this->proxies.size());
+        this->proxies.push_back(SpatialHashProxy());
+    }
+
+    SpatialHashProxy& entry = this->proxies[proxy];
+    entry.collider = collider;
+    entry.bounds = bounds;
+    entry.minX = getCell(bounds.left);
+    entry.minY = getCell(bounds.top);
+    entry.maxX = getCell(bounds.left + bounds.width);
+    entry.maxY = getCell(bounds.top + bounds.height);
+    entry.queryStamp = this->queryStamp;
+    addToCells(proxy);
+    this->count++;
+    return proxy;
+}
+
+/**
+ * @brief Move a collider to new bounds, only touching the cells if it crossed into different ones
+ *
+ * @param proxy proxy returned when the collider was added
+ * @param bounds new bounds of the collider
+ */
+void SpatialHash::update(uint32_t proxy, const sf::FloatRect& bounds) {
+    SpatialHashProxy& entry = this->proxies[proxy];
+    entry.bounds = bounds;
+    int32_t minX = getCell(bounds.left);
+    int32_t minY = getCell(bounds.top);
+    int32_t maxX = getCell(bounds.left + bounds.width);
+    int32_t maxY = getCell(bounds.top + bounds.height);
+    if(minX == entry.minX && minY == entry.minY && maxX == entry.maxX && maxY == entry.maxY) {
+        return; // Still in the same cells, most moves end here
+    }
+
+    removeFromCells(proxy);
+    entry.minX = minX;
+    entry.minY = minY;
+    entry.maxX = maxX;
+    entry.maxY = maxY;
+    addToCells(proxy);
+}
+
+/**
+ * @brief Remove a collider
+ *
+ * @param proxy proxy returned when the collider was added
+ */
+void SpatialHash::remove(uint32_t proxy) {
+    removeFromCells(proxy);
+    this->proxies[proxy].collider = nullptr;
+    this->freeProxies.push_back(proxy);
+    this->count--;
+}
+
+/**
+ * @brief Find every collider whose bounds overlap a box, each reported once
+ *
+ * @param bounds box to check
+ * @param hits cleared and filled with the colliders found
+ */
+void SpatialHash::query(const sf::FloatRect& bounds, std::vector<Collider*>& hits) {
+    hits.clear();
+    this->queryStamp++;
+
+    for(uint32_t proxy : this->oversized) {
+        SpatialHashProxy& entry = this->proxies[proxy];
+        if(entry.bounds.intersects(bounds)) {
+            hits.push_back(entry.collider);
+        }
+    }
+
+    int32_t minX = getCell(bounds.left);
+    int32_t minY = getCell(bounds.top);
+    int32_t maxX = getCell(bounds.left + bounds.width);
+    int32_t maxY = getCell(bounds.top + bounds.height);
+    for(int32_t y = minY; y <= maxY; y++) {
+        for(int32_t x = minX; x <= maxX; x++) {
+            auto cell = this->cells.find(getCellKey(x, y));
+            if(cell == this->cells.end()) {
+                continue;
+            }
+            for(uint32_t proxy : cell->second) {
+                SpatialHashProxy& entry = this->proxies[proxy];
+                if(entry.queryStamp == this->queryStamp) {
+                    continue; // Already seen in another cell
+                }
+                entry.queryStamp = this->queryStamp;
+                if(entry.bounds.intersects(bounds)) {
+                    hits.push_back(entry.collider);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Find every collider whose bounds contain a point, only looking in the point's cell
+ *
+ * @param point point to check
+ * @param hits cleared and filled with the colliders found
+ */
+void SpatialHash::queryPoint(sf::Vector2f point, std::vector<Collider*>& hits) {
+    hits.clear();
+    for(uint32_t proxy : this->oversized) {
+        if(this->proxies[proxy].bounds.contains(point)) {
+            hits.push_back(this->proxies[proxy].collider);
+        }
+    }
+
+    auto cell = this->cells.find(getCellKey(getCell(point.x), getCell(point.y)));
+    if(cell == this->cells.end()) {
+        return;
+    }
+    for(uint32_t proxy : cell->second) {
+        if(this->proxies[proxy].bounds.contains(point)) {
+            hits.push_back(this->proxies[proxy].collider);
+        }
+    }
+}
+
+/**
+ * @brief Find the first collider a line segment hits, checking the colliders in the cells around the
+ * segment
+ *
+ * @param from start of the segment
+ * @param to end of the segment
+ * @param hit filled with the closest collider hit
+ * @param ignore collider to skip, usually whatever cast the ray
+ * @return bool whether anything was hit
+ */
+bool SpatialHash::raycast(sf::Vector2f from, sf::Vector2f to, BroadphaseRayHit& hit, const Collider* ignore) {
+    hit = BroadphaseRayHit{nullptr, 1.f};
+    sf::Vector2f delta = to - from;
+    this->queryStamp++;
+
+    // Every collider the segment can touch is filed under a cell of the box around it
+    auto testProxies = [&](const std::vector<uint32_t>& proxies) {
+        for(uint32_t proxy : proxies) {
+            SpatialHashProxy& entry = this->proxies[proxy];
+            if(entry.queryStamp == this->queryStamp || entry.collider == ignore) {
+                continue;
+            }
+            entry.queryStamp = this->queryStamp;
+            float fraction;
+            if(getRayFraction(entry.bounds, from, delta, hit.fraction, fraction) && (!hit.collider || fraction < hit.fraction)) {
+                hit.collider = entry.collider;
+                hit.fraction = fraction;
+            }
+        }
+    };
+    testProxies(this->oversized);
+
+    int32_t minX = getCell(std::min(from.x, to.x));
+    int32_t minY = getCell(std::min(from.y, to.y));
+    int32_t maxX = getCell(std::max(from.x, to.x));
+    int32_t maxY = getCell(std::max(from.y, to.y));
+    for(int32_t y = minY; y <= maxY; y++) {
+        for(int32_t x = minX; x <= maxX; x++) {
+            auto cell = this->cells.find(getCellKey(x, y));
+            if(cell != this->cells.end()) {
+                testProxies(cell->second);
+            }
+        }
+    }
+    return hit.collider != nullptr;
+}
+
+/**
+ * @brief Get the number of colliders in the hash
+ *
+ * @return size_t number of colliders
+ */
+size_t SpatialHash::size() const {
+    return this->count;
+}
+
+/**
+ * @brief Get the cell a coordinate falls in
+ *
+ * @param coordinate x or y coordinate
+ * @return int32_t column or row of the cell
+ */
+int32_t SpatialHash::getCell(float coordinate) const {
+    float cell = std::floor(coordinate / this->cellSize);
+    return static_cast<int32_t>(std::max(-SPATIAL_HASH_MAX_COORDINATE, std::min(SPATIAL_HASH_MAX_COORDINATE, cell)));
+}
+
+/**
+ * @brief Get the key a cell is stored under
+ *
+ * @param x column of the cell
+ * @param y row of the cell
+ * @return uint64_t key of the cell
+ */
+uint64_t SpatialHash::getCellKey(int32_t x, int32_t y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+/**
+ * @brief File a proxy under every cell its range covers, or in the oversized list
+ *
+ * @param proxy proxy to add
+ */
+void SpatialHash::addToCells(uint32_t proxy) {
+    SpatialHashProxy& entry = this->proxies[proxy];
+    uint64_t cellCount = static_cast<uint64_t>(entry.maxX - entry.minX + 1) * static_cast<uint64_t>(entry.maxY - entry.minY + 1);
+    entry.oversized = cellCount > SPATIAL_HASH_MAX_CELLS;
+    if(entry.oversized) {
+        this->oversized.push_back(proxy);
+        return;
+    }
+    for(int32_t y = entry.minY; y <= entry.maxY; y++) {
+        for(int32_t x = entry.minX; x <= entry.maxX; x++) {
+            this->cells[getCellKey(x, y)].push_back(proxy);
+        }
+    }
+}
+
+/**
+ * @brief Take a proxy out of every cell its range covers, or out of the oversized list
+ *
+ * @param proxy proxy to remove
+ */
+void SpatialHash::removeFromCells(uint32_t proxy) {
+    SpatialHashProxy& entry = this->proxies[proxy];
+    if(entry.oversized) {
+        this->oversized.erase(std::find(this->oversized.begin(), this->oversized.end(), proxy));
+        return;
+    }
+    for(int32_t y = entry.minY; y <= entry.maxY; y++) {
+        for(int32_t x = entry.minX; x <= entry.maxX; x++) {
+            auto cell = this->cells.find(getCellKey(x, y));
+            if(cell == this->cells.end()) {
+                continue;
+            }
+            // Order in a cell doesn't matter, swap the last proxy into the gap
+            std::vector<uint32_t>& cellProxies = cell->second;
+            auto found = std::find(cellProxies.begin(), cellProxies.end(), proxy);
+            if(found != cellProxies.end()) {
+                *found = cellProxies.back();
+                cellProxies.pop_back();
+            }
+            // Drop empty cells so colliders crossing the world don't leave a trail of them behind
+            if(cellProxies.empty()) {
+                this->cells.erase(cell);
+            }
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Benchmarks.hpp"
+
+/**
+ * @brief Run the benchmarks. With no arguments every benchmark is run, otherwise only the ones named.
+ *
+ * @param argc number of arguments
+ * @param argv benchmark names, "input", "snapshot", "compression", "bounds" or "broadphase"
+ * @return int exit code
+ */
+int main(int argc, char** argv) {
+    std::vector<std::string> names(argv + 1, argv + argc);
+    if(names.empty()) {
+        names = {"input", "snapshot", "compression", "bounds", "broadphase"};
+    }
+
+    for(const std::string& name : names) {
+        if(name == "input") {
+            runInputBenchmark();
+        }
+        else if(name == "snapshot") {
+            runSnapshotBenchmark();
+        }
+        else if(name == "compression") {
+            runCompressionBenchmark();
+        }
+        else if(name == "bounds") {
+            runBoundsBenchmark();
+        }
+        else if(name == "broadphase") {
+            runBroadphaseBenchmark();
+        }
+        else {
+            std::cout << "Unknown benchmark " << name << ", expected input, snapshot, compression, bounds or broadphase\n";
+            return 1;
+        }
+        std::cout << "\n";
+    }
+
+    return 0; // Return on end
+}
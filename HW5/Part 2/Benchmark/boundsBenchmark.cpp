@@ -0,0 +1,108 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "BoundsBatch.hpp"
+#include "Benchmarks.hpp"
+
+const std::vector<size_t> BOUNDS_BENCHMARK_COUNTS = {1, 10, 100, 1000, 10000, 100000}; // Boxes in the batch, from one death zone to a huge level
+const size_t BOUNDS_BENCHMARK_TESTS = 4000000; // Boxes tested for each measurement, split over however many queries that takes
+const size_t BOUNDS_BENCHMARK_ROW = 1000; // Boxes in each row of the level
+
+/**
+ * @brief Lay out a level of boxes on a grid, none of them touching
+ *
+ * @param count number of boxes
+ * @return std::vector<sf::FloatRect> the boxes
+ */
+std::vector<sf::FloatRect> buildBoundsLevel(size_t count) {
+    std::vector<sf::FloatRect> level;
+    for(size_t i = 0; i < count; i++) {
+        float x = static_cast<float>(i % BOUNDS_BENCHMARK_ROW) * 30.f;
+        float y = static_cast<float>(i / BOUNDS_BENCHMARK_ROW) * 30.f;
+        level.push_back(sf::FloatRect(x, y, 20.f, 20.f));
+    }
+    return level;
+}
+
+/**
+ * @brief Time a query run enough times to test BOUNDS_BENCHMARK_TESTS boxes
+ *
+ * @param count boxes each query tests
+ * @param query query to run, returns the index it found
+ * @param found set to the index the last query found
+ * @return double mean nanoseconds per query
+ */
+template<typename Query>
+double measureBoundsQuery(size_t count, Query query, size_t& found) {
+    size_t queries = BOUNDS_BENCHMARK_TESTS / count;
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < queries; i++) {
+        found = query();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / queries;
+}
+
+/**
+ * @brief Measure how long testing one box against many takes with the old loop over sf::FloatRect and with
+ * each bounds batch kernel this build can run, as the number of boxes grows
+ */
+void runBoundsBenchmark() {
+    const BoundsKernel kernels[3] = {BoundsKernel::SCALAR, BoundsKernel::SSE, BoundsKernel::AVX2};
+
+    std::cout << "Widest kernel built: " << getBoundsKernelName(BOUNDS_BATCH_KERNEL) << "\n";
+    std::cout << std::setw(10) << "boxes" << std::setw(12) << "loop ns";
+    for(BoundsKernel kernel : kernels) {
+        if(isBoundsKernelAvailable(kernel)) {
+            std::cout << std::setw(12) << (std::string(getBoundsKernelName(kernel)) + " ns");
+        }
+    }
+    std::cout << std::setw(12) << "mask ns" << std::setw(10) << "speedup" << "\n";
+
+    for(size_t count : BOUNDS_BENCHMARK_COUNTS) {
+        std::vector<sf::FloatRect> level = buildBoundsLevel(count);
+        BoundsBatch batch(level);
+
+        // Only the last box overlaps, so every query has to look at all of them
+        sf::FloatRect query(level.back().left + 5.f, level.back().top + 5.f, 10.f, 10.f);
+        bool valid = true;
+        size_t found = 0;
+
+        double loopNs = measureBoundsQuery(count, [&]() {
+            for(size_t i = 0; i < level.size(); i++) {
+                if(query.intersects(level[i])) {
+                    return i;
+                }
+            }
+            return BOUNDS_BATCH_NO_HIT;
+        }, found);
+        valid = valid && found == count - 1;
+
+        std::cout << std::setw(10) << count << std::setw(12) << std::fixed << std::setprecision(1) << loopNs;
+        double bestNs = loopNs;
+        for(BoundsKernel kernel : kernels) {
+            if(!isBoundsKernelAvailable(kernel)) {
+                continue;
+            }
+            double kernelNs = measureBoundsQuery(count, [&]() {
+                return batch.findFirst(query, kernel);
+            }, found);
+            valid = valid && found == count - 1;
+            bestNs = std::min(bestNs, kernelNs);
+            std::cout << std::setw(12) << kernelNs;
+        }
+
+        std::vector<uint32_t> hitMask;
+        double maskNs = measureBoundsQuery(count, [&]() {
+            return batch.findAll(query, hitMask);
+        }, found);
+        valid = valid && found == 1 && (hitMask[(count - 1) / 32] >> ((count - 1) % 32) & 1);
+
+        std::cout << std::setw(12) << maskNs << std::setw(9) << std::setprecision(2) << loopNs / bestNs << "x"
+                  << (valid ? "" : "  MISMATCH") << "\n";
+    }
+}
@@ -0,0 +1,218 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "SpatialHash.hpp"
+#include "DynamicAabbTree.hpp"
+#include "Benchmarks.hpp"
+
+const std::vector<size_t> BROADPHASE_BENCHMARK_COUNTS = {100, 1000, 10000}; // Small colliders in the level
+const std::vector<size_t> BROADPHASE_BENCHMARK_LARGE = {0, 20}; // Level-wide colliders like the death zone and sidebars
+const size_t BROADPHASE_BENCHMARK_FRAMES = 200; // Frames timed for each measurement
+const size_t BROADPHASE_BENCHMARK_MOVERS = 5; // One collider in this many moves every frame
+const size_t BROADPHASE_BENCHMARK_CHECKED = 10; // Frames between checking every query against a linear scan
+
+/**
+ * @brief Collider the broadphases are given, they only ever compare the pointers
+ */
+class Collider {};
+
+/**
+ * @brief Level every broadphase is measured on, so each sees the same colliders making the same moves
+ */
+struct BroadphaseLevel {
+    std::vector<Collider> colliders; // Colliders, small ones first
+    std::vector<sf::FloatRect> bounds; // Current bounds of each collider
+    std::vector<sf::Vector2f> moves; // Move of each small collider on every frame
+    size_t movers; // Small colliders at the front that move
+};
+
+/**
+ * @brief Scatter small colliders the size of players and bullets over a level, plus a few level-wide ones
+ *
+ * @param count number of small colliders
+ * @param large number of level-wide colliders
+ * @return BroadphaseLevel the level
+ */
+BroadphaseLevel buildBroadphaseLevel(size_t count, size_t large) {
+    std::mt19937 random(1);
+    float width = 30.f * static_cast<float>(count);
+    std::uniform_real_distribution<float> x(0.f, width);
+    std::uniform_real_distribution<float> y(0.f, 600.f);
+    std::uniform_real_distribution<float> size(2.f, 25.f);
+    std::uniform_real_distribution<float> move(-3.f, 3.f);
+
+    BroadphaseLevel level;
+    level.colliders.resize(count + large);
+    level.movers = count / BROADPHASE_BENCHMARK_MOVERS;
+    for(size_t i = 0; i < count; i++) {
+        level.bounds.push_back(sf::FloatRect(x(random), y(random), size(random), size(random)));
+        level.moves.push_back(sf::Vector2f(move(random), move(random)));
+    }
+    for(size_t i = 0; i < large; i++) {
+        level.bounds.push_back(sf::FloatRect(x(random) - 5000.f, y(random), 20000.f, 300.f));
+    }
+    return level;
+}
+
+/**
+ * @brief Check an overlap query found exactly the colliders a linear scan finds
+ *
+ * @param level level the broadphase holds
+ * @param box box that was queried
+ * @param hits colliders the broadphase found
+ * @return bool whether they match
+ */
+bool checkBroadphaseQuery(BroadphaseLevel& level, const sf::FloatRect& box, std::vector<Collider*> hits) {
+    std::vector<Collider*> expected;
+    for(size_t i = 0; i < level.bounds.size(); i++) {
+        if(level.bounds[i].intersects(box)) {
+            expected.push_back(&level.colliders[i]);
+        }
+    }
+    std::sort(hits.begin(), hits.end());
+    std::sort(expected.begin(), expected.end());
+    return hits == expected;
+}
+
+/**
+ * @brief Check a point query found exactly the colliders a linear scan finds
+ *
+ * @param level level the broadphase holds
+ * @param point point that was queried
+ * @param hits colliders the broadphase found
+ * @return bool whether they match
+ */
+bool checkBroadphasePoint(BroadphaseLevel& level, sf::Vector2f point, std::vector<Collider*> hits) {
+    std::vector<Collider*> expected;
+    for(size_t i = 0; i < level.bounds.size(); i++) {
+        if(level.bounds[i].contains(point)) {
+            expected.push_back(&level.colliders[i]);
+        }
+    }
+    std::sort(hits.begin(), hits.end());
+    std::sort(expected.begin(), expected.end());
+    return hits == expected;
+}
+
+/**
+ * @brief Check a raycast hit as close as a linear scan says it could
+ *
+ * @param level level the broadphase holds
+ * @param from start of the ray
+ * @param to end of the ray
+ * @param ignore collider the ray skipped
+ * @param found whether the broadphase hit anything
+ * @param hit what it hit
+ * @return bool whether it matches
+ */
+bool checkBroadphaseRay(const BroadphaseLevel& level, sf::Vector2f from, sf::Vector2f to, const Collider* ignore, bool found,
+                        const BroadphaseRayHit& hit) {
+    bool expectedFound = false;
+    float expectedFraction = 1.f;
+    for(size_t i = 0; i < level.bounds.size(); i++) {
+        float fraction;
+        if(&level.colliders[i] != ignore && getRayFraction(level.bounds[i], from, to - from, expectedFraction, fraction) &&
+           (!expectedFound || fraction < expectedFraction)) {
+            expectedFound = true;
+            expectedFraction = fraction;
+        }
+    }
+    // Colliders the same distance along the ray could be reported in either order, only the distance must match
+    return found == expectedFound && (!found || hit.fraction == expectedFraction);
+}
+
+/**
+ * @brief Run a level through a broadphase. Every frame the movers move and each one queries its bounds, its
+ * center and a ray ahead of it, like the game checks players, enemies and bullets.
+ *
+ * @param broadphase empty broadphase to measure
+ * @param level level to run, left as it was after the last frame
+ * @param updateUs set to the mean microseconds spent moving colliders each frame
+ * @param queryUs set to the mean microseconds spent on queries each frame
+ * @return bool whether every checked query matched a linear scan
+ */
+bool measureBroadphase(Broadphase& broadphase, BroadphaseLevel& level, double& updateUs, double& queryUs) {
+    std::vector<uint32_t> proxies;
+    for(size_t i = 0; i < level.bounds.size(); i++) {
+        proxies.push_back(broadphase.insert(&level.colliders[i], level.bounds[i]));
+    }
+
+    std::vector<Collider*> hits;
+    BroadphaseRayHit hit;
+    bool valid = broadphase.size() == level.bounds.size();
+    double updateTotal = 0.0;
+    double queryTotal = 0.0;
+    for(size_t frame = 0; frame < BROADPHASE_BENCHMARK_FRAMES; frame++) {
+        // Turn around every so often so movers stay near where they started
+        float direction = (frame / 50) % 2 == 0 ? 1.f : -1.f;
+        auto start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < level.movers; i++) {
+            level.bounds[i].left += level.moves[i].x * direction;
+            level.bounds[i].top += level.moves[i].y * direction;
+            broadphase.update(proxies[i], level.bounds[i]);
+        }
+        auto moved = std::chrono::steady_clock::now();
+
+        bool checked = frame % BROADPHASE_BENCHMARK_CHECKED == 0;
+        for(size_t i = 0; i < level.movers; i++) {
+            const sf::FloatRect& box = level.bounds[i];
+            sf::Vector2f center(box.left + box.width / 2.f, box.top + box.height / 2.f);
+            sf::Vector2f ahead = center + level.moves[i] * direction * 20.f;
+
+            broadphase.query(box, hits);
+            valid = valid && (!checked || checkBroadphaseQuery(level, box, hits));
+            broadphase.queryPoint(center, hits);
+            valid = valid && (!checked || checkBroadphasePoint(level, center, hits));
+            bool found = broadphase.raycast(center, ahead, hit, &level.colliders[i]);
+            valid = valid && (!checked || checkBroadphaseRay(level, center, ahead, &level.colliders[i], found, hit));
+        }
+        auto queried = std::chrono::steady_clock::now();
+
+        updateTotal += std::chrono::duration<double, std::micro>(moved - start).count();
+        if(!checked) {
+            queryTotal += std::chrono::duration<double, std::micro>(queried - moved).count();
+        }
+    }
+
+    // Removing has to leave nothing behind for the broadphase to be reused
+    for(uint32_t proxy : proxies) {
+        broadphase.remove(proxy);
+    }
+    valid = valid && broadphase.size() == 0;
+
+    size_t timedFrames = BROADPHASE_BENCHMARK_FRAMES - (BROADPHASE_BENCHMARK_FRAMES + BROADPHASE_BENCHMARK_CHECKED - 1) / BROADPHASE_BENCHMARK_CHECKED;
+    updateUs = updateTotal / BROADPHASE_BENCHMARK_FRAMES;
+    queryUs = queryTotal / timedFrames;
+    return valid;
+}
+
+/**
+ * @brief Measure how long the spatial hash the game uses and a dynamic AABB tree take to move colliders and
+ * answer overlap, point and ray queries as the level grows, with and without level-wide colliders, checking
+ * both find the same colliders as a linear scan
+ */
+void runBroadphaseBenchmark() {
+    std::cout << std::setw(10) << "colliders" << std::setw(8) << "large" << std::setw(16) << "hash move us"
+              << std::setw(16) << "hash query us" << std::setw(16) << "tree move us" << std::setw(16) << "tree query us" << "\n";
+
+    for(size_t count : BROADPHASE_BENCHMARK_COUNTS) {
+        for(size_t large : BROADPHASE_BENCHMARK_LARGE) {
+            SpatialHash hash;
+            DynamicAabbTree tree;
+            double hashUpdateUs, hashQueryUs, treeUpdateUs, treeQueryUs;
+
+            BroadphaseLevel hashLevel = buildBroadphaseLevel(count, large);
+            bool valid = measureBroadphase(hash, hashLevel, hashUpdateUs, hashQueryUs);
+            BroadphaseLevel treeLevel = buildBroadphaseLevel(count, large);
+            valid = measureBroadphase(tree, treeLevel, treeUpdateUs, treeQueryUs) && valid;
+
+            std::cout << std::setw(10) << count << std::setw(8) << large << std::fixed << std::setprecision(1)
+                      << std::setw(16) << hashUpdateUs << std::setw(16) << hashQueryUs << std::setw(16) << treeUpdateUs
+                      << std::setw(16) << treeQueryUs << (valid ? "" : "  MISMATCH") << "\n";
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Snapshot.hpp"
+#include "SnapshotHistory.hpp"
+#include "SnapshotCompression.hpp"
+#include "Benchmarks.hpp"
+
+const std::vector<size_t> COMPRESSION_BENCHMARK_OBJECTS = {25, 100, 1000, 4000}; // Replicated object counts to measure, 25 is about the EC maze
+const int COMPRESSION_BENCHMARK_RUNS = 200; // Times each snapshot is compressed and decompressed
+const size_t COMPRESSION_BENCHMARK_MOVING = 8; // One in this many objects moves between the two ticks of a delta
+
+/**
+ * @brief Size and timing of compressing one snapshot
+ */
+struct CompressionStats {
+    size_t rawBytes; // Size of the snapshot
+    size_t compressedBytes; // Size of the compressed message, the raw size if compressing didn't help
+    double encodeUs; // Mean time compressing the snapshot
+    double decodeUs; // Mean time decompressing it
+    bool valid; // Whether decompressing gave back the snapshot
+};
+
+/**
+ * @brief Build a world of maze parts like the EC level, every part a different size on a grid
+ *
+ * @param state state to fill in
+ * @param objectCount number of replicated objects
+ * @param tick tick being built, moves one in COMPRESSION_BENCHMARK_MOVING objects
+ */
+void buildCompressionState(WorldState& state, size_t objectCount, uint32_t tick) {
+    for(size_t i = 0; i < objectCount; i++) {
+        float x = 99.f + static_cast<float>((i * 26) % 400);
+        float y = static_cast<float>((i * 26) / 400) * 26.f;
+        if(i % COMPRESSION_BENCHMARK_MOVING == 0) {
+            x += static_cast<float>(tick) * 1.5f;
+        }
+        float width = i % 2 == 0 ? 8.f + static_cast<float>(i % 97) : 8.f;
+        float height = i % 2 == 0 ? 8.f : 7.f + static_cast<float>(i % 131);
+        state.entities.push_back(makeEntityState(SnapshotRecordType::OBJECT, static_cast<uint16_t>(i + 1), "mazePart" + std::to_string(i), 0, x, y, width, height));
+    }
+    sortWorldState(state);
+}
+
+/**
+ * @brief Compress and decompress a snapshot COMPRESSION_BENCHMARK_RUNS times
+ *
+ * @param writer written snapshot
+ * @return CompressionStats size and timing
+ */
+CompressionStats measureCompression(const SnapshotWriter& writer) {
+    SnapshotCompressor compressor;
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> decompressed;
+
+    CompressionStats stats;
+    stats.rawBytes = writer.size();
+    stats.compressedBytes = writer.size();
+    stats.encodeUs = 0.0;
+    stats.decodeUs = 0.0;
+    stats.valid = true;
+
+    bool smaller = false;
+    for(int run = 0; run < COMPRESSION_BENCHMARK_RUNS; run++) {
+        auto encodeStart = std::chrono::steady_clock::now();
+        smaller = compressor.compress(writer.data(), writer.size(), compressed);
+        auto encodeEnd = std::chrono::steady_clock::now();
+        stats.encodeUs += std::chrono::duration<double, std::micro>(encodeEnd - encodeStart).count();
+
+        auto decodeStart = std::chrono::steady_clock::now();
+        bool decoded = decompressSnapshot(compressed.data(), compressed.size(), decompressed);
+        auto decodeEnd = std::chrono::steady_clock::now();
+        stats.decodeUs += std::chrono::duration<double, std::micro>(decodeEnd - decodeStart).count();
+        stats.valid = stats.valid && decoded && decompressed.size() == writer.size() && std::memcmp(decompressed.data(), writer.data(), writer.size()) == 0;
+    }
+    if(smaller) {
+        stats.compressedBytes = compressed.size();
+    }
+    stats.encodeUs /= COMPRESSION_BENCHMARK_RUNS;
+    stats.decodeUs /= COMPRESSION_BENCHMARK_RUNS;
+    return stats;
+}
+
+/**
+ * @brief Print the stats of a snapshot as a row of the results table
+ *
+ * @param kind full or delta
+ * @param objectCount number of replicated objects
+ * @param stats stats of the snapshot
+ */
+void printCompressionStats(const char* kind, size_t objectCount, const CompressionStats& stats) {
+    double saved = 100.0 * (1.0 - static_cast<double>(stats.compressedBytes) / stats.rawBytes);
+    std::cout << std::setw(8) << kind << std::setw(10) << objectCount
+              << std::setw(12) << stats.rawBytes << std::setw(12) << stats.compressedBytes
+              << std::setw(10) << std::fixed << std::setprecision(1) << saved
+              << std::setw(12) << std::setprecision(2) << stats.encodeUs
+              << std::setw(12) << stats.decodeUs
+              << std::setw(8) << (stats.rawBytes >= COMPRESSION_THRESHOLD ? "yes" : "no")
+              << (stats.valid ? "" : "  MISMATCH") << "\n";
+}
+
+/**
+ * @brief Measure how many bytes compressing full and delta snapshots saves and how long it takes as the
+ * number of replicated objects grows
+ */
+void runCompressionBenchmark() {
+    std::cout << std::setw(8) << "kind" << std::setw(10) << "objects"
+              << std::setw(12) << "bytes" << std::setw(12) << "compressed"
+              << std::setw(10) << "saved %" << std::setw(12) << "encode us"
+              << std::setw(12) << "decode us" << std::setw(8) << "sent" << "\n";
+
+    InterestArea everything = {SNAPSHOT_NO_TICK, false, 0.f, 0.f, 0.f, 0.f};
+    for(size_t objectCount : COMPRESSION_BENCHMARK_OBJECTS) {
+        SnapshotHistory history(SNAPSHOT_HISTORY_SIZE);
+        SnapshotWriter writer(SnapshotMessageType::SNAPSHOT, 0);
+        buildCompressionState(history.beginTick(0), objectCount, 0);
+        buildCompressionState(history.beginTick(1), objectCount, 1);
+
+        // What a joining client gets
+        writer.reset(SnapshotMessageType::SNAPSHOT, 1);
+        writeFullSnapshot(writer, *history.find(1), everything);
+        printCompressionStats("full", objectCount, measureCompression(writer));
+
+        // What every client gets each tick after that
+        writer.reset(SnapshotMessageType::SNAPSHOT_DELTA, 1, 0);
+        writeDeltaSnapshot(writer, *history.find(0), everything, *history.find(1), everything);
+        printCompressionStats("delta", objectCount, measureCompression(writer));
+    }
+}
@@ -0,0 +1,193 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <zmq.hpp>
+
+#include "Snapshot.hpp"
+#include "Benchmarks.hpp"
+
+const char* BENCHMARK_ENDPOINT = "tcp://127.0.0.1:5565"; // Endpoint the benchmark server listens on
+const int BENCHMARK_FRAMES = 300; // Frames measured per run
+const int BENCHMARK_FRAME_MS = 4; // Time between frames, not counted in the frame time
+const int BENCHMARK_SEND_HWM = 8; // Same as SENDER_HWM in the client
+const int BENCHMARK_RECEIVE_HWM = 8; // Small so that a slow server pushes back on the client quickly
+const int BENCHMARK_POLL_MS = 50; // How often the servers check if they should stop
+const std::vector<int> BENCHMARK_DELAYS = {0, 5, 20, 50}; // Simulated round trip times in milliseconds
+
+/**
+ * @brief Time spent sending the client's state each frame
+ */
+struct FrameStats {
+    double mean; // Mean frame time in microseconds
+    double p99; // 99th percentile frame time in microseconds
+    double max; // Longest frame time in microseconds
+    uint32_t dropped; // Messages dropped because the send queue was full, or never answered
+};
+
+/**
+ * @brief Sleep for a number of milliseconds
+ *
+ * @param ms milliseconds to sleep for
+ */
+void sleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/**
+ * @brief Lock-step server, every request is answered after the simulated round trip time
+ *
+ * @param context ZMQ context
+ * @param delay simulated round trip time in milliseconds
+ * @param running cleared when the server should stop
+ */
+void replyServer(zmq::context_t* context, int delay, std::atomic<bool>* running) {
+    zmq::socket_t replier{*context, zmq::socket_type::rep};
+    replier.setsockopt(ZMQ_RCVTIMEO, BENCHMARK_POLL_MS);
+    replier.setsockopt(ZMQ_LINGER, 0);
+    replier.bind(BENCHMARK_ENDPOINT);
+
+    while(*running) {
+        zmq::message_t message;
+        if(!replier.recv(message, zmq::recv_flags::none)) {
+            continue;
+        }
+        sleepMs(delay);
+        replier.send(zmq::buffer("Reply Success!"), zmq::send_flags::none);
+    }
+}
+
+/**
+ * @brief Streaming server, every message takes the simulated round trip time to handle and nothing is
+ * sent back
+ *
+ * @param context ZMQ context
+ * @param delay simulated round trip time in milliseconds
+ * @param running cleared when the server should stop
+ */
+void routerServer(zmq::context_t* context, int delay, std::atomic<bool>* running) {
+    zmq::socket_t receiver{*context, zmq::socket_type::router};
+    receiver.setsockopt(ZMQ_RCVTIMEO, BENCHMARK_POLL_MS);
+    receiver.setsockopt(ZMQ_RCVHWM, BENCHMARK_RECEIVE_HWM);
+    receiver.setsockopt(ZMQ_LINGER, 0);
+    receiver.bind(BENCHMARK_ENDPOINT);
+
+    while(*running) {
+        zmq::message_t identity;
+        zmq::message_t message;
+        if(!receiver.recv(identity, zmq::recv_flags::none)) {
+            continue;
+        }
+        if(identity.more() && receiver.recv(message, zmq::recv_flags::none)) {
+            sleepMs(delay);
+        }
+    }
+}
+
+/**
+ * @brief Work out the stats of a run
+ *
+ * @param frameTimes time of each frame in microseconds
+ * @param dropped messages dropped during the run
+ * @return FrameStats stats of the run
+ */
+FrameStats getFrameStats(std::vector<double>& frameTimes, uint32_t dropped) {
+    std::sort(frameTimes.begin(), frameTimes.end());
+    double total = 0.0;
+    for(double frameTime : frameTimes) {
+        total += frameTime;
+    }
+
+    FrameStats stats;
+    stats.mean = total / frameTimes.size();
+    stats.p99 = frameTimes[(frameTimes.size() * 99) / 100];
+    stats.max = frameTimes.back();
+    stats.dropped = dropped;
+    return stats;
+}
+
+/**
+ * @brief Run the client for a number of frames, sending its state once per frame
+ *
+ * @param streaming true for a dealer socket that never waits, false for the old request/reply
+ * @param delay simulated round trip time in milliseconds
+ * @return FrameStats time spent sending each frame
+ */
+FrameStats runClient(bool streaming, int delay) {
+    zmq::context_t context{1};
+    std::atomic<bool> running{true};
+    std::thread server(streaming ? routerServer : replyServer, &context, delay, &running);
+
+    zmq::socket_t sender{context, streaming ? zmq::socket_type::dealer : zmq::socket_type::req};
+    sender.setsockopt(ZMQ_SNDHWM, BENCHMARK_SEND_HWM);
+    sender.setsockopt(ZMQ_LINGER, 0);
+    sender.connect(BENCHMARK_ENDPOINT);
+
+    // Same message the client sends every frame
+    SnapshotWriter writer(SnapshotMessageType::CLIENT_STATE, SNAPSHOT_NO_TICK);
+    writer.addPlayer(NETWORK_NO_ID, "One", true, 150.f, 360.f);
+    writer.addView(0.f, 0.f, 300.f, 400.f);
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(BENCHMARK_FRAMES);
+    uint32_t dropped = 0;
+    for(int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+        auto start = std::chrono::steady_clock::now();
+
+        writer.setTimestamp(getNetworkTime());
+        if(streaming) {
+            if(!sender.send(zmq::buffer(writer.data(), writer.size()), zmq::send_flags::dontwait)) {
+                dropped++;
+            }
+        }
+        else {
+            sender.send(zmq::buffer(writer.data(), writer.size()), zmq::send_flags::none);
+            zmq::message_t reply;
+            if(!sender.recv(reply, zmq::recv_flags::none)) {
+                dropped++;
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        frameTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        sleepMs(BENCHMARK_FRAME_MS);
+    }
+
+    running = false;
+    server.join();
+    sender.close();
+    return getFrameStats(frameTimes, dropped);
+}
+
+/**
+ * @brief Print the stats of a run as a row of the results table
+ *
+ * @param mode name of the socket pattern
+ * @param delay simulated round trip time in milliseconds
+ * @param stats stats of the run
+ */
+void printFrameStats(const char* mode, int delay, const FrameStats& stats) {
+    std::cout << std::setw(10) << mode << std::setw(10) << delay
+              << std::setw(14) << std::fixed << std::setprecision(1) << stats.mean
+              << std::setw(14) << stats.p99
+              << std::setw(14) << stats.max
+              << std::setw(10) << stats.dropped << "\n";
+}
+
+/**
+ * @brief Measure how long the client's frame spends sending its state with the old REQ/REP pattern
+ * and with DEALER/ROUTER as the round trip time to the server grows.
+ */
+void runInputBenchmark() {
+    std::cout << std::setw(10) << "mode" << std::setw(10) << "rtt ms"
+              << std::setw(14) << "mean us" << std::setw(14) << "p99 us"
+              << std::setw(14) << "max us" << std::setw(10) << "dropped" << "\n";
+
+    for(int delay : BENCHMARK_DELAYS) {
+        printFrameStats("req/rep", delay, runClient(false, delay));
+        printFrameStats("dealer", delay, runClient(true, delay));
+    }
+}
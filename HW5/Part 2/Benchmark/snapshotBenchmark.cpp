@@ -0,0 +1,210 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Snapshot.hpp"
+#include "SnapshotHistory.hpp"
+#include "SnapshotInterpolator.hpp"
+#include "NetworkEntityTable.hpp"
+#include "Benchmarks.hpp"
+
+const std::vector<size_t> SNAPSHOT_BENCHMARK_OBJECTS = {100, 1000, 10000}; // Replicated object counts to measure
+const int SNAPSHOT_BENCHMARK_TICKS = 60; // Snapshots applied per run when looking up by id
+const int SNAPSHOT_BENCHMARK_NAME_TICKS = 4; // Snapshots applied per run when searching names, it is quadratic
+
+/**
+ * @brief Stand in for a GameObject on the client, without the SFML collider
+ */
+struct BenchmarkObject {
+    std::string name; // Name of the object
+    float x; // X position
+    float y; // Y position
+};
+
+/**
+ * @brief Time spent on each snapshot of a run
+ */
+struct SnapshotStats {
+    double readUs; // Mean time rebuilding the world state and buffering it for interpolation
+    double applyUs; // Mean time moving every local object to its interpolated position
+    size_t bytes; // Mean size of a delta snapshot
+};
+
+/**
+ * @brief Get the name of a replicated object
+ *
+ * @param index index of the object
+ * @return std::string name of the object
+ */
+std::string getBenchmarkObjectName(size_t index) {
+    return "object" + std::to_string(index);
+}
+
+/**
+ * @brief Build the server's world state at a tick. Every object moves every tick, the worst case for
+ * the client.
+ *
+ * @param state state to fill in
+ * @param objectCount number of replicated objects
+ * @param tick tick being built
+ */
+void buildBenchmarkState(WorldState& state, size_t objectCount, uint32_t tick) {
+    for(size_t i = 0; i < objectCount; i++) {
+        float x = static_cast<float>(i % 100) * 16.f + tick;
+        float y = static_cast<float>(i / 100) * 16.f;
+        state.entities.push_back(makeEntityState(SnapshotRecordType::OBJECT, static_cast<uint16_t>(i + 1), getBenchmarkObjectName(i), 0, x, y, 16.f, 16.f));
+    }
+    sortWorldState(state);
+}
+
+/**
+ * @brief Move a local object to the state of an entity by searching every object's name, like the
+ * client did before network ids. The name is copied out of each object like GameObject::getName used to.
+ *
+ * @param objects local objects
+ * @param entity interpolated entity state
+ */
+void applyByName(std::vector<BenchmarkObject>& objects, const EntityState& entity) {
+    for(size_t i = 0; i < objects.size(); i++) {
+        std::string name = objects[i].name;
+        if(entityNameEquals(entity, name)) {
+            objects[i].x = entity.x;
+            objects[i].y = entity.y;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Move a local object to the state of an entity through the network id table, matching the id by
+ * name only the first time it is seen like Client::bindEntity
+ *
+ * @param objects local objects
+ * @param table network id table
+ * @param entity interpolated entity state
+ */
+void applyById(std::vector<BenchmarkObject>& objects, NetworkEntityTable& table, const EntityState& entity) {
+    NetworkEntity* networkEntity = &table.get(entity.id);
+    if(!networkEntity->bound) {
+        networkEntity = &table.bind(entity.id, entity.type, NETWORK_NO_INDEX);
+        for(size_t i = 0; i < objects.size(); i++) {
+            if(entityNameEquals(entity, objects[i].name)) {
+                networkEntity->index = i;
+                break;
+            }
+        }
+    }
+    if(networkEntity->index != NETWORK_NO_INDEX) {
+        objects[networkEntity->index].x = entity.x;
+        objects[networkEntity->index].y = entity.y;
+    }
+}
+
+/**
+ * @brief Send a run of snapshots from a server to a client and measure the client's side of each one.
+ * The first full snapshot isn't measured, it is where the client matches ids to its objects.
+ *
+ * @param objectCount number of replicated objects
+ * @param byId true to look objects up by network id, false to search their names
+ * @return SnapshotStats time spent on each snapshot
+ */
+SnapshotStats runSnapshotClient(size_t objectCount, bool byId) {
+    SnapshotHistory serverHistory(SNAPSHOT_HISTORY_SIZE);
+    SnapshotHistory clientHistory(SNAPSHOT_HISTORY_SIZE);
+    SnapshotWriter writer(SnapshotMessageType::SNAPSHOT, 0);
+    SnapshotInterpolator interpolator(INTERPOLATION_DELAY);
+    NetworkEntityTable table;
+    WorldState received;
+    std::vector<EntityState> removed;
+    InterestArea everything = {SNAPSHOT_NO_TICK, false, 0.f, 0.f, 0.f, 0.f};
+
+    std::vector<BenchmarkObject> objects;
+    for(size_t i = 0; i < objectCount; i++) {
+        objects.push_back(BenchmarkObject{getBenchmarkObjectName(i), 0.f, 0.f});
+    }
+
+    double readUs = 0.0;
+    double applyUs = 0.0;
+    size_t bytes = 0;
+    int ticks = byId ? SNAPSHOT_BENCHMARK_TICKS : SNAPSHOT_BENCHMARK_NAME_TICKS;
+    for(int tick = 0; tick <= ticks; tick++) {
+        // Server, a delta against the previous tick like a client that acknowledges every snapshot
+        WorldState& current = serverHistory.beginTick(tick);
+        buildBenchmarkState(current, objectCount, tick);
+        const WorldState* baseline = serverHistory.find(tick - 1);
+        if(baseline) {
+            writer.reset(SnapshotMessageType::SNAPSHOT_DELTA, tick, baseline->tick);
+            writeDeltaSnapshot(writer, *baseline, everything, current, everything);
+        }
+        else {
+            writer.reset(SnapshotMessageType::SNAPSHOT, tick);
+            writeFullSnapshot(writer, current, everything);
+        }
+
+        // Client, the same steps as Client::subscriberFunction and Client::updateRemoteEntities
+        auto readStart = std::chrono::steady_clock::now();
+        SnapshotReader snapshot(writer.data(), writer.size());
+        readWorldState(snapshot, clientHistory, received, removed);
+        WorldState& state = clientHistory.beginTick(received.tick);
+        std::swap(state.entities, received.entities);
+        double serverTime = tick / static_cast<double>(SNAPSHOT_TICK_RATE);
+        interpolator.addSnapshot(state, removed, serverTime, serverTime + INTERPOLATION_DELAY);
+
+        auto applyStart = std::chrono::steady_clock::now();
+        double renderTime = interpolator.getRenderTime(serverTime + INTERPOLATION_DELAY);
+        for(InterpolatedEntity& entity : interpolator.getEntities()) {
+            EntityState sampled = interpolator.sample(entity, renderTime);
+            if(byId) {
+                applyById(objects, table, sampled);
+            }
+            else {
+                applyByName(objects, sampled);
+            }
+        }
+        interpolator.clearRemoved();
+        auto applyEnd = std::chrono::steady_clock::now();
+
+        if(tick > 0) {
+            readUs += std::chrono::duration<double, std::micro>(applyStart - readStart).count();
+            applyUs += std::chrono::duration<double, std::micro>(applyEnd - applyStart).count();
+            bytes += writer.size();
+        }
+    }
+
+    SnapshotStats stats;
+    stats.readUs = readUs / ticks;
+    stats.applyUs = applyUs / ticks;
+    stats.bytes = bytes / ticks;
+    return stats;
+}
+
+/**
+ * @brief Print the stats of a run as a row of the results table
+ *
+ * @param mode how objects were looked up
+ * @param objectCount number of replicated objects
+ * @param stats stats of the run
+ */
+void printSnapshotStats(const char* mode, size_t objectCount, const SnapshotStats& stats) {
+    std::cout << std::setw(10) << mode << std::setw(10) << objectCount
+              << std::setw(14) << std::fixed << std::setprecision(1) << stats.readUs
+              << std::setw(14) << stats.applyUs
+              << std::setw(12) << stats.bytes << "\n";
+}
+
+/**
+ * @brief Measure how long the client takes to read and apply a snapshot as the number of replicated
+ * objects grows, looking objects up by network id and by searching their names.
+ */
+void runSnapshotBenchmark() {
+    std::cout << std::setw(10) << "lookup" << std::setw(10) << "objects"
+              << std::setw(14) << "read us" << std::setw(14) << "apply us"
+              << std::setw(12) << "bytes" << "\n";
+
+    for(size_t objectCount : SNAPSHOT_BENCHMARK_OBJECTS) {
+        printSnapshotStats("id", objectCount, runSnapshotClient(objectCount, true));
+        printSnapshotStats("name", objectCount, runSnapshotClient(objectCount, false));
+    }
+}
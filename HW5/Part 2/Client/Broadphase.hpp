@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+
+class Collider;
+
+const uint32_t BROADPHASE_NO_PROXY = UINT32_MAX; // Proxy of a collider that isn't in a broadphase
+
+/**
+ * @brief Closest collider a ray hit
+ */
+struct BroadphaseRayHit {
+    Collider* collider; // Collider hit, nullptr if there was none
+    float fraction; // How far along the ray it was hit, 0 at the start and 1 at the end
+};
+
+/**
+ * @brief Finds which colliders might touch each other without testing every pair. Colliders are added once
+ * with their bounds, updated whenever they move and answer overlap, point and ray queries against the bounds
+ * they were last updated with.
+ */
+class Broadphase {
+    public:
+        /**
+         * @brief Destroy the Broadphase object
+         */
+        virtual ~Broadphase();
+
+        /**
+         * @brief Add a collider
+         *
+         * @param collider collider to add
+         * @param bounds current bounds of the collider
+         * @return uint32_t proxy to update or remove the collider with
+         */
+        virtual uint32_t insert(Collider* collider, const sf::FloatRect& bounds) = 0;
+
+        /**
+         * @brief Move a collider to new bounds
+         *
+         * @param proxy proxy returned when the collider was added
+         * @param bounds new bounds of the collider
+         */
+        virtual void update(uint32_t proxy, const sf::FloatRect& bounds) = 0;
+
+        /**
+         * @brief Remove a collider
+         *
+         * @param proxy proxy returned when the collider was added
+         */
+        virtual void remove(uint32_t proxy) = 0;
+
+        /**
+         * @brief Find every collider whose bounds overlap a box, each reported once
+         *
+         * @param bounds box to check
+         * @param hits cleared and filled with the colliders found
+         */
+        virtual void query(const sf::FloatRect& bounds, std::vector<Collider*>& hits) = 0;
+
+        /**
+         * @brief Find every collider whose bounds contain a point
+         *
+         * @param point point to check
+         * @param hits cleared and filled with the colliders found
+         */
+        virtual void queryPoint(sf::Vector2f point, std::vector<Collider*>& hits) = 0;
+
+        /**
+         * @brief Find the first collider a line segment hits
+         *
+         * @param from start of the segment
+         * @param to end of the segment
+         * @param hit filled with the closest collider hit
+         * @param ignore collider to skip, usually whatever cast the ray
+         * @return bool whether anything was hit
+         */
+        virtual bool raycast(sf::Vector2f from, sf::Vector2f to, BroadphaseRayHit& hit, const Collider* ignore = nullptr) = 0;
+
+        /**
+         * @brief Get the number of colliders in the broadphase
+         *
+         * @return size_t number of colliders
+         */
+        virtual size_t size() const = 0;
+};
+
+/**
+ * @brief Find where a line segment enters a box
+ *
+ * @param bounds box to check
+ * @param from start of the segment
+ * @param delta end of the segment less its start
+ * @param maxFraction only hits closer than this along the segment count
+ * @param fraction set to how far along the segment the box is entered, 0 if it starts inside
+ * @return bool whether the segment enters the box before maxFraction
+ */
+bool getRayFraction(const sf::FloatRect& bounds, sf::Vector2f from, sf::Vector2f delta, float maxFraction, float& fraction);
@@ -3,150 +3,364 @@
 std::string CLIENT_ID = "One";
 
 /**
- * @brief Will take a server message in the format Object/Character,PositionX,PositionY
+ * @brief Write the client's state into a client state message
  * 
- * @param message message to parse
- * @return std::vector<std::string> vector list of parsed message
+ * @param writer message being written
+ * @param client client to write into the message
+ * @param ackTick last snapshot tick received from the server
+ * @param ackEvent last event received in order from the server
+ * @param viewBounds area of the world the client is showing
+ * @param inputs inputs the server hasn't acknowledged yet
+ * @param shots shots fired since the last message
  */
-std::vector<std::string> parseServerMessage(std::string message, char parseBy) {
-    std::vector<std::string> output;
-
-    std::istringstream iss(message);
-    std::string parsed;
+void writeClientMessage(SnapshotWriter& writer, PlayerClient* client, uint32_t ackTick, uint32_t ackEvent, const sf::FloatRect& viewBounds, const InputHistory& inputs, const std::vector<ShotReport>& shots) {
+    sf::Vector2f playerPosition = client->player->getPosition();
+    writer.reset(SnapshotMessageType::CLIENT_STATE, ackTick);
+    writer.addPlayer(NETWORK_NO_ID, client->name, client->isActive, playerPosition.x, playerPosition.y);
+    writer.addView(viewBounds.left, viewBounds.top, viewBounds.width, viewBounds.height);
+    writer.addEventAck(ackEvent);
+    writer.addCapabilities(CAPABILITY_COMPRESSION);
 
-    while(std::getline(iss, parsed, parseBy)) {
-        output.push_back(parsed);
+    // Every unacknowledged input is resent, so a dropped message doesn't lose any
+    size_t first = inputs.size() > INPUT_SEND_MAX ? inputs.size() - INPUT_SEND_MAX : 0;
+    for(size_t i = first; i < inputs.size(); i++) {
+        const InputCommand& input = inputs.at(i);
+        writer.addInput(client->name, input.sequence, packKeys(input.keys), input.elapsed);
+    }
+    for(const ShotReport& shot : shots) {
+        writer.addShot(shot.targetId, shot.bounds.left, shot.bounds.top, shot.bounds.width, shot.bounds.height);
     }
-
-    return output;
 }
 
 /**
- * @brief Create a Client Message object string
+ * @brief Get the current local time
  * 
- * @param client client to convert into string
- * @return std::string string format of client
+ * @return double seconds of a monotonic clock
  */
-std::string createClientMessage(PlayerClient* client) {
-    sf::Vector2f playerPosition = client->player->getPosition();
-    std::string isActiveString;
-    if(client->isActive) {
-        isActiveString = "true";
-    }
-    else {
-        isActiveString = "false";
-    }
-    return client->name + "," + isActiveString + "," + std::to_string(playerPosition.x) + "," + std::to_string(playerPosition.y);
+double getLocalTime() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 /**
- * @brief Construct a new Client object and set up replier and publisher sockets
+ * @brief Construct a new Client object and set up sender and subscriber sockets
  */
-Client::Client(PlayerClient* thisClient, std::vector<PlayerClient>* playerClients) {
+Client::Client(PlayerClient* thisClient, std::vector<PlayerClient>* playerClients) : clientWriter(SnapshotMessageType::CLIENT_STATE, 0), history(SNAPSHOT_HISTORY_SIZE), inputHistory(INPUT_HISTORY_SIZE), interpolator(INTERPOLATION_DELAY) {
     this->context = zmq::context_t{1};
-    this->requester = zmq::socket_t{context, zmq::socket_type::req};
+    this->sender = zmq::socket_t{context, zmq::socket_type::dealer};
     this->subscriber = zmq::socket_t{context, zmq::socket_type::sub};
     this->thisClient = thisClient;
     this->clients = playerClients;
+    this->lastReceivedTick = SNAPSHOT_NO_TICK;
+    this->eventAck = 0;
+    this->roundTripTime = 0;
+    this->droppedMessages = 0;
+    this->hasCorrection = false;
+    this->hitsTaken = 0;
 
-    requester.connect("tcp://localhost:5555");
+    sender.setsockopt(ZMQ_SNDHWM, SENDER_HWM);
+    sender.setsockopt(ZMQ_LINGER, SENDER_LINGER);
+    sender.setsockopt(ZMQ_IMMEDIATE, 1); // Don't queue up states while the server isn't there
+    sender.connect("tcp://localhost:5555");
     subscriber.connect("tcp://localhost:5556");
-    subscriber.setsockopt(ZMQ_SUBSCRIBE, "", strlen("")); // Subscribe to all messages
+    std::string topic = getClientTopic(CLIENT_ID);
+    subscriber.setsockopt(ZMQ_SUBSCRIBE, topic.data(), topic.size()); // Subscribe to this client's snapshots
     std::cout << "Successfully started client " << CLIENT_ID << "!\n";
 }
 
 /**
- * @brief Function to be run by the requester socket
+ * @brief Send the client's state to the server without waiting for a reply. If the server isn't
+ * keeping up the message is dropped, the next frame's state replaces it anyway.
+ * 
+ * @param playerClient client to send
  */
-void Client::requesterFunction(PlayerClient* playerClient) {
+void Client::senderFunction(PlayerClient* playerClient) {
 
     // Generate message with Client info
-    std::string message = createClientMessage(playerClient);
+    writeClientMessage(this->clientWriter, playerClient, this->lastReceivedTick, this->eventAck, this->viewBounds, this->inputHistory, this->pendingShots);
+    this->clientWriter.setTimestamp(getNetworkTime());
+    this->pendingShots.clear();
+
+    zmq::send_result_t sent = sender.send(zmq::buffer(this->clientWriter.data(), this->clientWriter.size()), zmq::send_flags::dontwait);
+    if(!sent) {
+        this->droppedMessages++;
+    }
+}
+
+/**
+ * @brief Move this client's player by a frame of input straight away and remember the input so it
+ * can be sent to the server and replayed if the server corrects the player's position
+ * 
+ * @param keys keys held during the frame
+ * @param elapsed length of the frame in seconds
+ */
+void Client::predictInput(KeysPressed keys, float elapsed) {
+    applyCorrection();
+    const InputCommand& input = this->inputHistory.push(keys, elapsed);
+    simulateInput(this->thisClient->player, input);
+}
+
+/**
+ * @brief Report a projectile that hit something to the server if it hit a remote player. The server
+ * decides whether it really hit, like everything else in the state it is lost if the message is.
+ * 
+ * @param target collider the projectile hit
+ * @param bounds bounds of the projectile
+ * @return bool whether the target is a remote player
+ */
+bool Client::reportShot(const Collider* target, const sf::FloatRect& bounds) {
+    for(const PlayerClient& client : *this->clients) {
+        if(client.player == target && client.networkId != NETWORK_NO_ID) {
+            this->pendingShots.push_back(ShotReport{client.networkId, bounds});
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Get how many times the server says this client's player was shot since the last call
+ * 
+ * @return int number of hits taken
+ */
+int Client::takeHits() {
+    return this->hitsTaken.exchange(0);
+}
+
+/**
+ * @brief Move this client's player to the latest position acknowledged by the server and replay the
+ * inputs the server hasn't simulated yet on top of it
+ */
+void Client::applyCorrection() {
+    uint32_t sequence;
+    sf::Vector2f position;
+    {
+        std::lock_guard<std::mutex> lock(this->correctionMutex);
+        if(!this->hasCorrection) {
+            return;
+        }
+        this->hasCorrection = false;
+        sequence = this->correctionSequence;
+        position = this->correctionPosition;
+    }
+
+    this->inputHistory.acknowledge(sequence);
+    Player* player = this->thisClient->player;
+    player->setPosition(position);
+    for(size_t i = 0; i < this->inputHistory.size(); i++) {
+        simulateInput(player, this->inputHistory.at(i));
+    }
+}
+
+/**
+ * @brief Get the time between sending a state and receiving the first snapshot that includes it
+ * 
+ * @return uint32_t round trip time in microseconds
+ */
+uint32_t Client::getRoundTripTime() const {
+    return this->roundTripTime;
+}
+
+/**
+ * @brief Get the number of state messages dropped because the send queue was full
+ * 
+ * @return uint32_t number of dropped messages
+ */
+uint32_t Client::getDroppedMessages() const {
+    return this->droppedMessages;
+}
+
+/**
+ * @brief Set the area of the world this client is showing, the server only sends what is around it
+ * 
+ * @param view view the window is drawn with
+ */
+void Client::setViewBounds(const sf::View& view) {
+    sf::Vector2f size = view.getSize();
+    sf::Vector2f center = view.getCenter();
+    this->viewBounds = sf::FloatRect(center.x - size.x / 2.f, center.y - size.y / 2.f, size.x, size.y);
+}
 
-    requester.send(zmq::buffer(message), zmq::send_flags::none);
+/**
+ * @brief Apply the state of a replicated entity to the local objects and clients
+ * 
+ * @param entity state received from the server
+ * @param objects objects that can be updated
+ */
+void Client::applyEntityState(const EntityState& entity, std::vector<GameObject*>* objects) {
+    NetworkEntity* networkEntity = &this->networkEntities.get(entity.id);
+    if(!networkEntity->bound || networkEntity->type != entity.type) {
+        networkEntity = &bindEntity(entity, objects);
+    }
+    else if(entity.type == SnapshotRecordType::PLAYER && networkEntity->index != NETWORK_NO_INDEX) {
+        // Disconnects erase from the client list, so make sure the index still points at the same client
+        size_t index = networkEntity->index;
+        if(index >= this->clients->size() || this->clients->at(index).networkId != entity.id) {
+            networkEntity = &bindEntity(entity, objects);
+        }
+    }
+    if(networkEntity->index == NETWORK_NO_INDEX) {
+        return; // Our own player or an object this client doesn't have
+    }
+
+    if(entity.type == SnapshotRecordType::OBJECT) {
+        Collider* collider = objects->at(networkEntity->index)->getCollider();
+        sf::Vector2f currentPosition = collider->getPosition();
+        collider->move(entity.x - currentPosition.x, entity.y - currentPosition.y);
+    }
+    else if(entity.type == SnapshotRecordType::PLAYER) {
+        PlayerClient& client = this->clients->at(networkEntity->index);
+        client.isActive = entity.flags != 0;
+        if(client.isActive) {
+            client.player->setPosition(entity.x, entity.y);
+        }
+    }
+}
+
+/**
+ * @brief Match the network id of an entity to a local object or client by its name, creating a client
+ * for a player that hasn't been seen before. Only done the first time an id is seen.
+ * 
+ * @param entity state received from the server
+ * @param objects objects that can be updated
+ * @return NetworkEntity& entry of the entity's id
+ */
+NetworkEntity& Client::bindEntity(const EntityState& entity, std::vector<GameObject*>* objects) {
+    if(entity.type == SnapshotRecordType::OBJECT) {
+        for(size_t i = 0; i < objects->size(); i++) {
+            if(entityNameEquals(entity, objects->at(i)->getName())) {
+                objects->at(i)->setNetworkId(entity.id);
+                return this->networkEntities.bind(entity.id, entity.type, i);
+            }
+        }
+        return this->networkEntities.bind(entity.id, entity.type, NETWORK_NO_INDEX);
+    }
+    if(entity.type != SnapshotRecordType::PLAYER || entityNameEquals(entity, CLIENT_ID)) {
+        return this->networkEntities.bind(entity.id, entity.type, NETWORK_NO_INDEX);
+    }
 
-    zmq::message_t recievingMessage;
-    requester.recv(recievingMessage, zmq::recv_flags::none);
+    for(size_t i = 0; i < this->clients->size(); i++) {
+        if(entityNameEquals(entity, this->clients->at(i).name)) {
+            this->clients->at(i).networkId = entity.id;
+            return this->networkEntities.bind(entity.id, entity.type, i);
+        }
+    }
+
+    Player* player = new Player(300, 400, "player.png", (300 / 2) - 22.f, 400 - 40.f, 100.f, 50.f, 300.f, 1.f, 1.f);
+    player->setCollisionEnabled(true);
+    player->setPosition(entity.x, entity.y);
+    PlayerClient newClient = {getEntityName(entity), player, entity.flags != 0, entity.id};
+    clients->push_back(newClient);
+    return this->networkEntities.bind(entity.id, entity.type, this->clients->size() - 1);
 }
 
 /**
- * @brief Function to be run by the subscriber socket
+ * @brief Move the remote players and objects to where they were INTERPOLATION_DELAY ago on the server.
+ * Call once per frame from the main thread.
  * 
- * @param objects objects to publish
+ * @param objects objects that can be updated
  */
-void Client::subscriberFunction(std::vector<GameObject*>* objects, EventManager* manager) {
+void Client::updateRemoteEntities(std::vector<GameObject*>* objects) {
+    std::lock_guard<std::mutex> lock(this->interpolationMutex);
+    double renderTime = this->interpolator.getRenderTime(getLocalTime());
+
+    for(InterpolatedEntity& entity : this->interpolator.getEntities()) {
+        if(!entity.removed) {
+            applyEntityState(this->interpolator.sample(entity, renderTime), objects);
+        }
+        else {
+            // Players that left our view stop being drawn until they come back into it
+            NetworkEntity& networkEntity = this->networkEntities.get(entity.latest.id);
+            size_t index = networkEntity.index;
+            if(networkEntity.bound && networkEntity.type == SnapshotRecordType::PLAYER && index < this->clients->size() && this->clients->at(index).networkId == entity.latest.id) {
+                this->clients->at(index).isActive = false;
+            }
+            this->networkEntities.unbind(entity.latest.id);
+        }
+    }
+    this->interpolator.clearRemoved();
+}
+
+/**
+ * @brief Function to be run by the subscriber socket. Received snapshots are only buffered here,
+ * they are applied on the main thread by updateRemoteEntities.
+ * 
+ * @param manager event manager to raise received events on
+ */
+void Client::subscriberFunction(EventManager* manager) {
     // Loop-de-loop
     while(true) {
+        // Snapshots are sent as [topic, snapshot]
+        zmq::message_t topicMessage;
         zmq::message_t serverMessage;
-        subscriber.recv(serverMessage, zmq::recv_flags::none);
-        std::string message = std::string(static_cast<char*>(serverMessage.data()), serverMessage.size());
-
-        // Seperate publish message into lines, each containing an object/player
-        std::vector<std::string> lines = parseServerMessage(message, '\n');
-
-        for(std::string line : lines) {
-            std::vector<std::string> data = parseServerMessage(line, ',');
-
-            if(data[0] == "Object") {
-                std::string objID = data[1];
-                float xPos = stof(data[2]);
-                float yPos = stof(data[3]);
-                
-                for(int i = 0; i < objects->size(); i++) {
-                    if((*objects).at(i)->getName() == objID) {
-                        sf::Vector2f currentPosition = (*objects).at(i)->getCollider()->getPosition();
-                        (*objects).at(i)->getCollider()->move(xPos - currentPosition.x, yPos - currentPosition.y);
-                        break;
-                    }
-                }
-            }
-            else if(data[0] == "Event") {
-                if(data[1] == "ClientDisconnect") {
-                    std::string clientName = data[2];
-                    manager->registerEvent(new EventClientDisconnectHandler(manager, new EventClientDisconnect(clientName, this->clients)));
-                }
+        if(!subscriber.recv(topicMessage, zmq::recv_flags::none) || !topicMessage.more()) {
+            continue;
+        }
+        if(!subscriber.recv(serverMessage, zmq::recv_flags::none) || serverMessage.size() == 0) {
+            continue;
+        }
+
+        // Large snapshots, like the full one we get when joining, may arrive compressed
+        const void* snapshotData = serverMessage.data();
+        size_t snapshotSize = serverMessage.size();
+        if(isCompressedSnapshot(snapshotData, snapshotSize)) {
+            if(!decompressSnapshot(snapshotData, snapshotSize, this->decompressedSnapshot)) {
+                continue;
             }
-            else { // data[0] == "Player"
-                bool playerClientExists = false;
+            snapshotData = this->decompressedSnapshot.data();
+            snapshotSize = this->decompressedSnapshot.size();
+        }
+
+        SnapshotReader snapshot(snapshotData, snapshotSize);
+        if(!snapshot.isValid()) {
+            continue;
+        }
+        if(snapshot.getMessageType() != SnapshotMessageType::SNAPSHOT && snapshot.getMessageType() != SnapshotMessageType::SNAPSHOT_DELTA) {
+            continue;
+        }
+
+        // Rebuild the full state, a delta against a snapshot we no longer have is dropped and the
+        // server will resync us once our acknowledged tick falls out of its history
+        if(!readWorldState(snapshot, this->history, this->receivedState, this->removedEntities)) {
+            continue;
+        }
+        WorldState& state = this->history.beginTick(this->receivedState.tick);
+        std::swap(state.entities, this->receivedState.entities);
+
+        {
+            std::lock_guard<std::mutex> lock(this->interpolationMutex);
+            double serverTime = state.tick / static_cast<double>(SNAPSHOT_TICK_RATE);
+            this->interpolator.addSnapshot(state, this->removedEntities, serverTime, getLocalTime());
+        }
 
-                std::string clientID = data[1];
-                bool isActiveClient;
-                if(data[2] == "true") {
-                    isActiveClient = true;
+        SnapshotRecordView record;
+        while(snapshot.nextRecord(record)) {
+            if(record.getType() == SnapshotRecordType::EVENT) {
+                // Events are resent until acknowledged, only handle each one the first time it arrives
+                if(!this->eventReceiver.receive(record)) {
+                    continue;
                 }
-                else {
-                    isActiveClient = false;
+                if(record.getEventType() == SnapshotEventType::CLIENT_DISCONNECT) {
+                    std::string clientName = record.getName();
+                    manager->registerEvent(new EventClientDisconnectHandler(manager, new EventClientDisconnect(clientName, this->clients)));
                 }
-                float xPos = stof(data[3]);
-                float yPos = stof(data[4]);
-                sf::Vector2f position = sf::Vector2f(xPos, yPos);
-                
-                if(clientID != CLIENT_ID) {
-                    for(int i = 0; i < this->clients->size(); i++) {
-                        if(this->clients->at(i).name == clientID) {
-                            this->clients->at(i).isActive = isActiveClient;
-                            if(!isActiveClient) {
-                                // this->clients->at(i).player->setCollisionEnabled(false);
-                                // this->clients->erase(this->clients->begin() + i);
-                            }
-                            else {
-                                this->clients->at(i).player->setPosition(position);
-                            }
-                            playerClientExists = true;
-                            break;
-                        }
-                    }
-                    if(!playerClientExists) {
-                        Player* player = new Player(300, 400, "player.png", (300 / 2) - 22.f, 400 - 40.f, 100.f, 50.f, 300.f, 1.f, 1.f);
-                        player->setCollisionEnabled(true);
-                        player->setPosition(position);
-                        PlayerClient newClient = {clientID, player, isActiveClient};
-                        clients->push_back(newClient);
-                    }
+                else if(record.getEventType() == SnapshotEventType::PLAYER_HIT && record.nameEquals(CLIENT_ID)) {
+                    // Lives are taken on the main thread the next time it checks
+                    this->hitsTaken++;
                 }
-                playerClientExists = false;
+            }
+            else if(record.getType() == SnapshotRecordType::INPUT_ACK && record.nameEquals(CLIENT_ID)) {
+                // Applied on the main thread the next time an input is predicted
+                std::lock_guard<std::mutex> lock(this->correctionMutex);
+                this->hasCorrection = true;
+                this->correctionSequence = record.getSequence();
+                this->correctionPosition = sf::Vector2f(record.getX(), record.getY());
             }
         }
 
+        this->eventAck = this->eventReceiver.getLastSequence();
+        this->lastReceivedTick = state.tick;
+        if(snapshot.getTimestamp() != 0) {
+            this->roundTripTime = getNetworkTime() - snapshot.getTimestamp();
+        }
     }
 }
\ No newline at end of file
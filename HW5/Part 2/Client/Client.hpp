@@ -5,12 +5,32 @@
 #include <thread>
 #include <iostream>
 #include <vector>
+#include <atomic>
+#include <mutex>
 #include <zmq.hpp>
 
 #include "Player.hpp"
 #include "Timeline.hpp"
 #include "GameObject.hpp"
 #include "EventManager.hpp"
+#include "Snapshot.hpp"
+#include "SnapshotHistory.hpp"
+#include "InputHistory.hpp"
+#include "SnapshotInterpolator.hpp"
+#include "NetworkEntityTable.hpp"
+#include "EventChannel.hpp"
+#include "SnapshotCompression.hpp"
+
+const int SENDER_HWM = 8; // Max state messages queued for the server before new ones are dropped
+const int SENDER_LINGER = 500; // Milliseconds queued messages are still sent for once the client closes
+
+/**
+ * @brief A projectile that hit a remote player on this client's screen, sent with the next state
+ */
+struct ShotReport {
+    uint16_t targetId; // Network id of the player hit
+    sf::FloatRect bounds; // Bounds of the projectile when it hit
+};
 
 /**
  * @brief Client class responsible for handling client calls and server information
@@ -18,26 +38,130 @@
 class Client {
     public:
         /**
-         * @brief Construct a new Client object and set up replier and publisher sockets
+         * @brief Construct a new Client object and set up sender and subscriber sockets
          */
         Client(PlayerClient* thisClient, std::vector<PlayerClient>* clients);
 
         /**
-         * @brief Function to be run by the requester socket
+         * @brief Send the client's state to the server without waiting for a reply. If the server isn't
+         * keeping up the message is dropped, the next frame's state replaces it anyway.
+         * 
+         * @param playerClient client to send
+         */
+        void senderFunction(PlayerClient* playerClient);
+
+        /**
+         * @brief Move this client's player by a frame of input straight away and remember the input so it
+         * can be sent to the server and replayed if the server corrects the player's position
+         * 
+         * @param keys keys held during the frame
+         * @param elapsed length of the frame in seconds
+         */
+        void predictInput(KeysPressed keys, float elapsed);
+
+        /**
+         * @brief Report a projectile that hit something to the server if it hit a remote player. The server
+         * decides whether it really hit, like everything else in the state it is lost if the message is.
+         * 
+         * @param target collider the projectile hit
+         * @param bounds bounds of the projectile
+         * @return bool whether the target is a remote player
+         */
+        bool reportShot(const Collider* target, const sf::FloatRect& bounds);
+
+        /**
+         * @brief Get how many times the server says this client's player was shot since the last call
+         * 
+         * @return int number of hits taken
+         */
+        int takeHits();
+
+        /**
+         * @brief Get the time between sending a state and receiving the first snapshot that includes it
+         * 
+         * @return uint32_t round trip time in microseconds
+         */
+        uint32_t getRoundTripTime() const;
+
+        /**
+         * @brief Get the number of state messages dropped because the send queue was full
+         * 
+         * @return uint32_t number of dropped messages
+         */
+        uint32_t getDroppedMessages() const;
+
+        /**
+         * @brief Set the area of the world this client is showing, the server only sends what is around it
+         * 
+         * @param view view the window is drawn with
+         */
+        void setViewBounds(const sf::View& view);
+
+        /**
+         * @brief Function to be run by the subscriber socket. Received snapshots are only buffered here,
+         * they are applied on the main thread by updateRemoteEntities.
+         * 
+         * @param manager event manager to raise received events on
          */
-        void requesterFunction(PlayerClient* playerClient);
+        void subscriberFunction(EventManager* manager);
 
         /**
-         * @brief Function to be run by the subscriber socket
+         * @brief Move the remote players and objects to where they were INTERPOLATION_DELAY ago on the server.
+         * Call once per frame from the main thread.
          * 
-         * @param objects objects to publish
+         * @param objects objects that can be updated
          */
-        void subscriberFunction(std::vector<GameObject*>* objects, EventManager* manager);
+        void updateRemoteEntities(std::vector<GameObject*>* objects);
 
     private:
+        /**
+         * @brief Apply the state of a replicated entity to the local objects and clients
+         * 
+         * @param entity state received from the server
+         * @param objects objects that can be updated
+         */
+        void applyEntityState(const EntityState& entity, std::vector<GameObject*>* objects);
+
+        /**
+         * @brief Match the network id of an entity to a local object or client by its name, creating a client
+         * for a player that hasn't been seen before. Only done the first time an id is seen.
+         * 
+         * @param entity state received from the server
+         * @param objects objects that can be updated
+         * @return NetworkEntity& entry of the entity's id
+         */
+        NetworkEntity& bindEntity(const EntityState& entity, std::vector<GameObject*>* objects);
+
+        /**
+         * @brief Move this client's player to the latest position acknowledged by the server and replay the
+         * inputs the server hasn't simulated yet on top of it
+         */
+        void applyCorrection();
+
         zmq::context_t context; // ZMQ socket context
-        zmq::socket_t requester; // Requester socket
+        zmq::socket_t sender; // Dealer socket the client's state is streamed through
         zmq::socket_t subscriber; // Subscriber socket
         std::vector<PlayerClient>* clients; // Clients currently in the server
         PlayerClient* thisClient; // Reference to current client
+        sf::FloatRect viewBounds; // Area of the world the client is showing
+        SnapshotWriter clientWriter; // Reused buffer the client state is written into
+        SnapshotHistory history; // Recently received world states that deltas are applied to
+        std::vector<uint8_t> decompressedSnapshot; // Latest compressed snapshot once decompressed, only used on the subscriber thread
+        WorldState receivedState; // State being rebuilt from the latest snapshot
+        std::vector<EntityState> removedEntities; // Entities removed by the latest snapshot
+        std::atomic<uint32_t> lastReceivedTick; // Last snapshot tick received, acknowledged to the server
+        EventReceiver eventReceiver; // Puts the server's events back in order, only used on the subscriber thread
+        std::atomic<uint32_t> eventAck; // Last event received in order, acknowledged to the server
+        std::atomic<uint32_t> roundTripTime; // Latest round trip time in microseconds
+        uint32_t droppedMessages; // State messages dropped because the send queue was full
+        InputHistory inputHistory; // Predicted inputs the server hasn't acknowledged yet
+        std::vector<ShotReport> pendingShots; // Shots to send with the next state, only used on the main thread
+        std::atomic<int> hitsTaken; // PLAYER_HIT events about this client received since takeHits was called
+        std::mutex correctionMutex; // Guards the correction between the subscriber and main threads
+        bool hasCorrection; // Whether a correction has arrived since the last one was applied
+        uint32_t correctionSequence; // Last input sequence the server has simulated
+        sf::Vector2f correctionPosition; // Position of the player after that input on the server
+        SnapshotInterpolator interpolator; // Received snapshots remote entities are drawn from
+        std::mutex interpolationMutex; // Guards the interpolator between the subscriber and main threads
+        NetworkEntityTable networkEntities; // Local object or client of each network id, only used on the main thread
 };
\ No newline at end of file
@@ -1,12 +1,33 @@
 #include "Collider.hpp"
 
-// Global List containing all collionable objects
-std::vector<Collider*> collisionObjects;
+// Bounds of every collider with collision enabled, read by collision checks instead of getGlobalBounds
+ColliderStore colliderStore;
+
+static SpatialHash collisionHash;
+
+// Broadphase every collider with collision enabled is registered in
+Broadphase& collisionBroadphase = collisionHash;
+
+// Reused for every broadphase query so checking collisions doesn't allocate
+static std::vector<Collider*> collisionHits;
 
 /**
- * @brief Destroy the Collider object
+ * @brief Construct a new Collider object with collision disabled
  */
-Collider::~Collider() {}
+Collider::Collider() {
+    collisionEnabled = false;
+    collisionProxy = BROADPHASE_NO_PROXY;
+    storeHandle = COLLIDER_STORE_NO_HANDLE;
+}
+
+/**
+ * @brief Destroy the Collider object, removing it from the broadphase
+ */
+Collider::~Collider() {
+    if(collisionProxy != BROADPHASE_NO_PROXY) {
+        setCollisionEnabled(false);
+    }
+}
 
 /**
  * @brief Set Collision to be enabled or disabled
@@ -16,13 +37,18 @@ Collider::~Collider() {}
 void Collider::setCollisionEnabled(bool enabled) {
     collisionEnabled = enabled;
     if(enabled) {
-        collisionObjects.push_back(this);
+        if(collisionProxy == BROADPHASE_NO_PROXY) {
+            sf::FloatRect bounds = getGlobalBounds();
+            storeHandle = colliderStore.add(this, bounds);
+            collisionProxy = collisionBroadphase.insert(this, bounds);
+        }
     }
     else {
-        // Remove from the global list
-        auto toRemove = std::find(collisionObjects.begin(), collisionObjects.end(), this);
-        if(toRemove != collisionObjects.end()) {
-            collisionObjects.erase(toRemove);
+        if(collisionProxy != BROADPHASE_NO_PROXY) {
+            colliderStore.remove(storeHandle);
+            storeHandle = COLLIDER_STORE_NO_HANDLE;
+            collisionBroadphase.remove(collisionProxy);
+            collisionProxy = BROADPHASE_NO_PROXY;
         }
     }
 }
@@ -37,26 +63,48 @@ bool Collider::getCollisionEnabled() {
 }
 
 /**
- * @brief Checks if the object collides with any other with collision on. It will resolve the object 
- * collision if needed.
+ * @brief Update the bounds the broadphase has for the object. Called whenever it moves.
+ */
+void Collider::updateCollisionBounds() {
+    if(collisionProxy != BROADPHASE_NO_PROXY) {
+        // Setters call this even when nothing changed, the broadphase only hears about real moves
+        sf::FloatRect bounds = getGlobalBounds();
+        if(colliderStore.update(storeHandle, bounds)) {
+            collisionBroadphase.update(collisionProxy, bounds);
+        }
+    }
+}
+
+/**
+ * @brief Get the bounds collision checks use, the ones last given to the collider store. Colliders with
+ * collision disabled aren't in the store and get their global bounds instead.
+ * 
+ * @return sf::FloatRect bounds of the object
+ */
+sf::FloatRect Collider::getCollisionBounds() const {
+    if(storeHandle != COLLIDER_STORE_NO_HANDLE) {
+        return colliderStore.getBounds(storeHandle);
+    }
+    return getGlobalBounds();
+}
+
+/**
+ * @brief Checks if the object collides with any other with collision on, asking the broadphase for the
+ * few objects near it. It will resolve the object collision if needed.
  * 
  * @return bool of whether the collide object collides with any object in the collideableObjects list.
  */
 bool Collider::checkCollision() {
     if(collisionEnabled) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        collisionBroadphase.query(getCollisionBounds(), collisionHits);
 
-        for(Collider* collideable : collisionObjects) {
+        for(Collider* collideable : collisionHits) {
             if(collideable == this) {
                 continue;
             }
 
-            sf::FloatRect collideableBounds = collideable->getGlobalBounds();
-
-            if(checkBounds.intersects(collideableBounds)) {
-                resolveCollision(*this, *collideable);
-                return true;
-            }
+            resolveCollision(*this, *collideable);
+            return true;
         }
     }
     return false;
@@ -70,7 +118,7 @@ bool Collider::checkCollision() {
  */
 bool Collider::checkCollision(sf::FloatRect objectToCheck) {
     if(collisionEnabled) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
         if(checkBounds.intersects(objectToCheck)) {
             return true;
@@ -85,11 +133,11 @@ bool Collider::checkCollision(sf::FloatRect objectToCheck) {
  * @param std::vector<sf::FloatRect> bounds to check for collision
  * @return bool of whether the collide object collides with the object.
  */
-bool Collider::checkCollision(std::vector<sf::FloatRect> objectsToCheck) {
+bool Collider::checkCollision(const std::vector<sf::FloatRect>& objectsToCheck) {
     if(collisionEnabled) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
-        for(sf::FloatRect bounds : objectsToCheck) {
+        for(const sf::FloatRect& bounds : objectsToCheck) {
             if(checkBounds.intersects(bounds)) {
                 return true;
             }
@@ -106,8 +154,8 @@ bool Collider::checkCollision(std::vector<sf::FloatRect> objectsToCheck) {
  * @param colliderTwo Object being collided with.
  */
 void Collider::resolveCollision(Collider& colliderOne, Collider& colliderTwo) {
-    sf::FloatRect boundsOne = colliderOne.getGlobalBounds();
-    sf::FloatRect boundsTwo = colliderTwo.getGlobalBounds();
+    sf::FloatRect boundsOne = colliderOne.getCollisionBounds();
+    sf::FloatRect boundsTwo = colliderTwo.getCollisionBounds();
 
     // Find how much is being intersected in each direction.
     float intersectingX = std::min(boundsOne.left + boundsOne.width, boundsTwo.left + boundsTwo.width) - std::max(boundsOne.left, boundsTwo.left);
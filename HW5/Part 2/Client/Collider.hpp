@@ -1,11 +1,28 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 
+#include "SpatialHash.hpp"
+#include "ColliderStore.hpp"
+
+// Broadphase every collider with collision enabled is registered in
+extern Broadphase& collisionBroadphase;
+
+// Bounds of every collider with collision enabled, read by collision checks instead of getGlobalBounds
+extern ColliderStore colliderStore;
+
 /**
  * @brief Class for the interface of a collider
  */
 class Collider {
     public:
+        /**
+         * @brief Construct a new Collider object with collision disabled
+         */
+        Collider();
+
+        /**
+         * @brief Destroy the Collider object, removing it from the broadphase
+         */
         virtual ~Collider();
 
         /**
@@ -23,8 +40,21 @@ class Collider {
         bool getCollisionEnabled();
 
         /**
-         * @brief Checks if the object collides with any other with collision on. It will resolve the object 
-         * collision if needed.
+         * @brief Update the bounds the broadphase has for the object. Called whenever it moves.
+         */
+        void updateCollisionBounds();
+
+        /**
+         * @brief Get the bounds collision checks use, the ones last given to the collider store. Colliders
+         * with collision disabled aren't in the store and get their global bounds instead.
+         * 
+         * @return sf::FloatRect bounds of the object
+         */
+        sf::FloatRect getCollisionBounds() const;
+
+        /**
+         * @brief Checks if the object collides with any other with collision on, asking the broadphase for the
+         * few objects near it. It will resolve the object collision if needed.
          * 
          * @return bool of whether the collide object collides with any object in the collideableObjects list.
          */
@@ -44,7 +74,7 @@ class Collider {
          * @param std::vector<Collider*> collideable objects to check for collision
          * @return bool of whether the collide object collides with the object.
          */
-        bool checkCollision(std::vector<sf::FloatRect> objectsToCheck);
+        bool checkCollision(const std::vector<sf::FloatRect>& objectsToCheck);
 
         /**
          * @brief Resolves a collision by taking an object and what it collides with and moving it back outside 
@@ -93,4 +123,6 @@ class Collider {
 
     private:
         bool collisionEnabled; // Whether the object has collision enabled
+        uint32_t collisionProxy; // Proxy of the object in the broadphase, BROADPHASE_NO_PROXY when not in it
+        uint32_t storeHandle; // Handle of the object in the collider store, COLLIDER_STORE_NO_HANDLE when not in it
 };
\ No newline at end of file
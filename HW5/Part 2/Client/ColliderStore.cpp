@@ -0,0 +1,103 @@
+#include "ColliderStore.hpp"
+
+/**
+ * @brief Construct an empty Collider Store object
+ */
+ColliderStore::ColliderStore() {
+    this->freeHandle = COLLIDER_STORE_NO_HANDLE;
+}
+
+/**
+ * @brief Add a collider
+ *
+ * @param owner collider to add
+ * @param bounds current bounds of the collider
+ * @return uint32_t handle to update or remove the collider with
+ */
+uint32_t ColliderStore::add(Collider* owner, const sf::FloatRect& bounds) {
+    uint32_t handle;
+    if(this->freeHandle != COLLIDER_STORE_NO_HANDLE) {
+        handle = this->freeHandle;
+        this->freeHandle = this->indices[handle];
+    }
+    else {
+        handle = static_cast<uint32_t>(this->indices.size());
+        this->indices.push_back(0);
+    }
+
+    this->indices[handle] = static_cast<uint32_t>(this->owners.size());
+    this->left.push_back(bounds.left);
+    this->top.push_back(bounds.top);
+    this->width.push_back(bounds.width);
+    this->height.push_back(bounds.height);
+    this->owners.push_back(owner);
+    this->handles.push_back(handle);
+    return handle;
+}
+
+/**
+ * @brief Remove a collider
+ *
+ * @param handle handle returned when the collider was added
+ */
+void ColliderStore::remove(uint32_t handle) {
+    // Move the last collider into the gap so the arrays stay packed
+    uint32_t index = this->indices[handle];
+    uint32_t last = static_cast<uint32_t>(this->owners.size() - 1);
+    this->left[index] = this->left[last];
+    this->top[index] = this->top[last];
+    this->width[index] = this->width[last];
+    this->height[index] = this->height[last];
+    this->owners[index] = this->owners[last];
+    this->handles[index] = this->handles[last];
+    this->indices[this->handles[index]] = index;
+
+    this->left.pop_back();
+    this->top.pop_back();
+    this->width.pop_back();
+    this->height.pop_back();
+    this->owners.pop_back();
+    this->handles.pop_back();
+
+    this->indices[handle] = this->freeHandle;
+    this->freeHandle = handle;
+}
+
+/**
+ * @brief Store new bounds for a collider
+ *
+ * @param handle handle returned when the collider was added
+ * @param bounds new bounds of the collider
+ * @return bool whether the bounds changed
+ */
+bool ColliderStore::update(uint32_t handle, const sf::FloatRect& bounds) {
+    uint32_t index = this->indices[handle];
+    if(this->left[index] == bounds.left && this->top[index] == bounds.top && this->width[index] == bounds.width && this->height[index] == bounds.height) {
+        return false;
+    }
+    this->left[index] = bounds.left;
+    this->top[index] = bounds.top;
+    this->width[index] = bounds.width;
+    this->height[index] = bounds.height;
+    return true;
+}
+
+/**
+ * @brief Get the bounds of a collider
+ *
+ * @param handle handle returned when the collider was added
+ * @return sf::FloatRect bounds it was last updated with
+ */
+sf::FloatRect ColliderStore::getBounds(uint32_t handle) const {
+    uint32_t index = this->indices[handle];
+    return sf::FloatRect(this->left[index], this->top[index], this->width[index], this->height[index]);
+}
+
+/**
+ * @brief Get the number of colliders in the store
+ *
+ * @return size_t number of colliders, the length of each array
+ */
+size_t ColliderStore::size() const {
+    return this->owners.size();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+
+class Collider;
+
+const uint32_t COLLIDER_STORE_NO_HANDLE = UINT32_MAX; // Handle of a collider that isn't in the store
+
+/**
+ * @brief Bounds of every collider with collision enabled, kept in one array per field so reading them doesn't
+ * go through each collider's class. Colliders are packed at the front of the arrays, removing one moves the
+ * last into its place. Handles stay the same while a collider is in the store and are looked up through a
+ * table, so a collider never needs telling it has moved.
+ */
+class ColliderStore {
+    public:
+        /**
+         * @brief Construct an empty Collider Store object
+         */
+        ColliderStore();
+
+        /**
+         * @brief Add a collider
+         *
+         * @param owner collider to add
+         * @param bounds current bounds of the collider
+         * @return uint32_t handle to update or remove the collider with
+         */
+        uint32_t add(Collider* owner, const sf::FloatRect& bounds);
+
+        /**
+         * @brief Remove a collider
+         *
+         * @param handle handle returned when the collider was added
+         */
+        void remove(uint32_t handle);
+
+        /**
+         * @brief Store new bounds for a collider
+         *
+         * @param handle handle returned when the collider was added
+         * @param bounds new bounds of the collider
+         * @return bool whether the bounds changed
+         */
+        bool update(uint32_t handle, const sf::FloatRect& bounds);
+
+        /**
+         * @brief Get the bounds of a collider
+         *
+         * @param handle handle returned when the collider was added
+         * @return sf::FloatRect bounds it was last updated with
+         */
+        sf::FloatRect getBounds(uint32_t handle) const;
+
+        /**
+         * @brief Get the number of colliders in the store
+         *
+         * @return size_t number of colliders, the length of each array
+         */
+        size_t size() const;
+
+    private:
+        std::vector<float> left; // Left side of each collider
+        std::vector<float> top; // Top side of each collider
+        std::vector<float> width; // Width of each collider
+        std::vector<float> height; // Height of each collider
+        std::vector<Collider*> owners; // Collider each position holds
+        std::vector<uint32_t> handles; // Handle of the collider each position holds
+        std::vector<uint32_t> indices; // Position of each handle in the arrays, or the next free handle when unused
+        uint32_t freeHandle; // First unused handle, COLLIDER_STORE_NO_HANDLE if every handle is in use
+};
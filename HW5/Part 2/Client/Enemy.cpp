@@ -32,10 +32,12 @@ sf::Vector2f Enemy::getMovement() {
 
 void Enemy::move(float xOffset, float yOffset) {
     setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
+    updateCollisionBounds();
 }
 
 void Enemy::move(sf::Vector2f offset) {
     setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
+    updateCollisionBounds();
 }
 
 /**
@@ -73,7 +75,7 @@ void Enemy::update(float time, int movement) {
  */
 bool Enemy::checkCollision(sf::FloatRect objectToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
         if(checkBounds.intersects(objectToCheck)) {
             return true;
@@ -88,11 +90,11 @@ bool Enemy::checkCollision(sf::FloatRect objectToCheck) {
  * @param std::vector<Collider*> bounds to check for collision
  * @return bool of whether the collide object collides with the object.
  */
-bool Enemy::checkCollision(std::vector<sf::FloatRect> objectsToCheck) {
+bool Enemy::checkCollision(const std::vector<sf::FloatRect>& objectsToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
-        for(sf::FloatRect bounds : objectsToCheck) {
+        for(const sf::FloatRect& bounds : objectsToCheck) {
             if(checkBounds.intersects(bounds)) {
                 return true;
             }
@@ -57,7 +57,7 @@ class Enemy : public sf::Sprite, public Collider {
          * @param std::vector<sf::FloatRect> collideable objects to check for collision
          * @return bool of whether the collide object collides with the object.
          */
-        bool checkCollision(std::vector<sf::FloatRect> objectsToCheck);
+        bool checkCollision(const std::vector<sf::FloatRect>& objectsToCheck);
 
     private:
         sf::Texture texture; // Texture of the platform
@@ -15,6 +15,7 @@ struct PlayerClient {
     std::string name;
     Player* player;
     bool isActive;
+    uint16_t networkId; // Id the player is replicated under, 0 until the server gives it one
 };
 
 /**
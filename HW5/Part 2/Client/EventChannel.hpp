@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Snapshot.hpp"
+
+const size_t EVENT_CHANNEL_SIZE = 64; // Events that can wait to be acknowledged before the receiver is given up on
+
+/**
+ * @brief A discrete gameplay event sent over the reliable channel
+ */
+struct ReliableEvent {
+    uint32_t sequence; // Position of the event in the channel, the first event is 1
+    SnapshotEventType type; // Type of the event
+    char name[SNAPSHOT_NAME_LENGTH]; // Zero padded name the event is about
+};
+
+/**
+ * @brief Sending end of a reliable ordered event channel. Every event that hasn't been acknowledged is
+ * written into each outgoing message, oldest first, so a lost message never loses an event.
+ */
+class EventSender {
+    public:
+        /**
+         * @brief Construct a new Event Sender object that can hold EVENT_CHANNEL_SIZE unacknowledged events
+         */
+        EventSender();
+
+        /**
+         * @brief Forget every event and start again from sequence number 1, keeping the allocated memory
+         */
+        void reset();
+
+        /**
+         * @brief Queue an event to be sent until it is acknowledged
+         *
+         * @param type type of the event
+         * @param name name the event is about
+         * @return bool false if the channel is full because the receiver stopped acknowledging
+         */
+        bool push(SnapshotEventType type, const std::string& name);
+
+        /**
+         * @brief Stop sending every event up to a sequence number
+         *
+         * @param sequence sequence number of the last event the receiver got in order
+         */
+        void acknowledge(uint32_t sequence);
+
+        /**
+         * @brief Write every unacknowledged event into a message
+         *
+         * @param writer message being written
+         */
+        void write(SnapshotWriter& writer) const;
+
+        /**
+         * @brief Check if the channel can't take another event
+         *
+         * @return bool whether the channel is full
+         */
+        bool isFull() const;
+
+        /**
+         * @brief Get the number of events waiting to be acknowledged
+         *
+         * @return size_t number of events
+         */
+        size_t size() const;
+
+    private:
+        std::vector<ReliableEvent> events; // Ring of unacknowledged events
+        size_t first; // Index of the oldest event
+        size_t count; // Number of events in the ring
+        uint32_t nextSequence; // Sequence number given to the next event
+};
+
+/**
+ * @brief Receiving end of a reliable ordered event channel. Events are handed out once each, in the order
+ * they were sent, and the sequence number to acknowledge is tracked.
+ */
+class EventReceiver {
+    public:
+        /**
+         * @brief Construct a new Event Receiver object
+         */
+        EventReceiver();
+
+        /**
+         * @brief Check a received event record
+         *
+         * @param record event record from the sender
+         * @return bool true if the event is the next one in order and should be handled, false if it has
+         * been handled already
+         */
+        bool receive(const SnapshotRecordView& record);
+
+        /**
+         * @brief Get the sequence number to acknowledge
+         *
+         * @return uint32_t sequence number of the last event handled, 0 if none
+         */
+        uint32_t getLastSequence() const;
+
+    private:
+        uint32_t lastSequence; // Sequence number of the last event handled
+};
@@ -61,6 +61,11 @@ void EventSpawnHandler::onEvent() {
     double yPos = *static_cast<double*>(this->event->getVarient(ParamType::Y_POS).getValue());
 
     player->setPosition(xPos, yPos);
+
+    // A headless server has no window, camera or scroll areas to move
+    if(!window || !camera || !leftScrollArea || !rightScrollArea) {
+        return;
+    }
     camera->setCenter(window->getDefaultView().getCenter());
     leftScrollArea->setPosition(window->getView().getViewport().left, 0.f);
     rightScrollArea->setPosition(window->getView().getViewport().left + window->getDefaultView().getSize().x - rightScrollArea->getLocalBounds().width, 0.f);
@@ -96,6 +101,9 @@ void EventDeathHandler::onEvent() {
     SideScrollArea* rightScrollArea = static_cast<SideScrollArea*>(this->event->getVarient(ParamType::RIGHT_SIDE_SCROLL).getValue());
 
     std::vector<SpawnPoint*>* spawnPoints = static_cast<std::vector<SpawnPoint*>*>(this->event->getVarient(ParamType::SPAWN_POINTS).getValue());
+    if(spawnPoints->empty()) {
+        return;
+    }
     srand(time(NULL));
     int randomIndex = rand() % spawnPoints->size();
     sf::Vector2f chosenSpawnPoint = spawnPoints->at(randomIndex)->getSpawnPointLocation();
@@ -6,17 +6,36 @@
 GameObject::GameObject(std::string name, Collider* object) {
     this->name = name;
     this->object = object;
+    this->networkId = 0;
 }
 
 /**
  * @brief Get the Name
  * 
- * @return std::string name
+ * @return const std::string& name
  */
-std::string GameObject::getName() {
+const std::string& GameObject::getName() const {
     return this->name;
 }
 
+/**
+ * @brief Get the id the object is replicated under
+ * 
+ * @return uint16_t network id, 0 if the object isn't replicated
+ */
+uint16_t GameObject::getNetworkId() const {
+    return this->networkId;
+}
+
+/**
+ * @brief Set the id the object is replicated under
+ * 
+ * @param networkId network id given by the server
+ */
+void GameObject::setNetworkId(uint16_t networkId) {
+    this->networkId = networkId;
+}
+
 /**
  * @brief Get the Collider object
  * 
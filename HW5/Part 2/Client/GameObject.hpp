@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 
 #include "Collider.hpp"
 
@@ -17,9 +18,23 @@ class GameObject {
         /**
          * @brief Get the Name
          * 
-         * @return std::string name
+         * @return const std::string& name
          */
-        std::string getName();
+        const std::string& getName() const;
+
+        /**
+         * @brief Get the id the object is replicated under
+         * 
+         * @return uint16_t network id, 0 if the object isn't replicated
+         */
+        uint16_t getNetworkId() const;
+
+        /**
+         * @brief Set the id the object is replicated under
+         * 
+         * @param networkId network id given by the server
+         */
+        void setNetworkId(uint16_t networkId);
 
         /**
          * @brief Get the Collider object
@@ -31,4 +46,5 @@ class GameObject {
     private:
         std::string name; // Name of the GameObject
         Collider* object; // Collider Object of the GameObject
+        uint16_t networkId; // Id the object is replicated under, 0 if it isn't
 };
\ No newline at end of file
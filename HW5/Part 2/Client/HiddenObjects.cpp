@@ -122,6 +122,7 @@ sf::FloatRect DeathZone::getGlobalBounds() const {
  */
 void DeathZone::move(float xOffset, float yOffset) {
     setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
+    updateCollisionBounds();
 }
 
 /**
@@ -131,6 +132,7 @@ void DeathZone::move(float xOffset, float yOffset) {
  */
 void DeathZone::move(sf::Vector2f offset) {
     setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
+    updateCollisionBounds();
 }
 
 /**
@@ -191,6 +193,7 @@ sf::FloatRect SideScrollArea::getGlobalBounds() const {
  */
 void SideScrollArea::move(float xOffset, float yOffset) {
     setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
+    updateCollisionBounds();
 }
 
 /**
@@ -200,6 +203,7 @@ void SideScrollArea::move(float xOffset, float yOffset) {
  */
 void SideScrollArea::move(sf::Vector2f offset) {
     setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
+    updateCollisionBounds();
 }
 
 /**
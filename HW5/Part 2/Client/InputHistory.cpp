@@ -0,0 +1,129 @@
+#include "InputHistory.hpp"
+#include "Snapshot.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Pack the pressed keys into a single byte to send
+ *
+ * @param keys keys pressed
+ * @return uint8_t KEY_* bits of the pressed keys
+ */
+uint8_t packKeys(const KeysPressed& keys) {
+    uint8_t packed = 0;
+    if(keys.Up) {
+        packed |= KEY_UP;
+    }
+    if(keys.Left) {
+        packed |= KEY_LEFT;
+    }
+    if(keys.Right) {
+        packed |= KEY_RIGHT;
+    }
+    return packed;
+}
+
+/**
+ * @brief Unpack the pressed keys from a received byte
+ *
+ * @param keys KEY_* bits of the pressed keys
+ * @return KeysPressed keys pressed
+ */
+KeysPressed unpackKeys(uint8_t keys) {
+    KeysPressed unpacked;
+    unpacked.Up = (keys & KEY_UP) != 0;
+    unpacked.Left = (keys & KEY_LEFT) != 0;
+    unpacked.Right = (keys & KEY_RIGHT) != 0;
+    return unpacked;
+}
+
+/**
+ * @brief Get how long an input is simulated for, its frame length limited to INPUT_MAX_ELAPSED
+ *
+ * @param input input to simulate
+ * @return float seconds the input moves the player for
+ */
+float getInputElapsed(const InputCommand& input) {
+    return std::min(std::max(input.elapsed, 0.f), INPUT_MAX_ELAPSED);
+}
+
+/**
+ * @brief Move a player by one frame of input. The server and client both run this so the client's
+ * prediction ends up where the server puts the player. The position is snapped to the quantized
+ * positions snapshots send, so both round the same way.
+ *
+ * @param player player to move
+ * @param input input to simulate
+ */
+void simulateInput(Player* player, const InputCommand& input) {
+    // A client can't speed itself up by claiming a long frame. The world's colliders keep the player
+    // inside the level afterwards.
+    player->update(getInputElapsed(input), input.keys, nullptr);
+
+    sf::Vector2f position = player->getPosition();
+    player->setPosition(snapPosition(position.x, POSITION_ORIGIN_X), snapPosition(position.y, POSITION_ORIGIN_Y));
+}
+
+/**
+ * @brief Construct a new Input History object
+ *
+ * @param capacity number of inputs to keep
+ */
+InputHistory::InputHistory(size_t capacity) {
+    this->inputs.resize(capacity);
+    this->first = 0;
+    this->count = 0;
+    this->nextSequence = 1;
+}
+
+/**
+ * @brief Record a new frame of input, replacing the oldest one if the history is full
+ *
+ * @param keys keys held during the frame
+ * @param elapsed length of the frame in seconds
+ * @return const InputCommand& recorded input with its sequence number
+ */
+const InputCommand& InputHistory::push(KeysPressed keys, float elapsed) {
+    if(this->count == this->inputs.size()) {
+        this->first = (this->first + 1) % this->inputs.size();
+        this->count--;
+    }
+
+    InputCommand& input = this->inputs[(this->first + this->count) % this->inputs.size()];
+    input.sequence = this->nextSequence++;
+    input.keys = keys;
+    input.elapsed = elapsed;
+    this->count++;
+    return input;
+}
+
+/**
+ * @brief Forget every input up to and including a sequence number
+ *
+ * @param sequence last sequence number the server has simulated
+ */
+void InputHistory::acknowledge(uint32_t sequence) {
+    while(this->count > 0 && this->inputs[this->first].sequence <= sequence) {
+        this->first = (this->first + 1) % this->inputs.size();
+        this->count--;
+    }
+}
+
+/**
+ * @brief Get the number of unacknowledged inputs
+ *
+ * @return size_t number of inputs
+ */
+size_t InputHistory::size() const {
+    return this->count;
+}
+
+/**
+ * @brief Get an unacknowledged input, oldest first
+ *
+ * @param index index of the input
+ * @return const InputCommand& input
+ */
+const InputCommand& InputHistory::at(size_t index) const {
+    return this->inputs[(this->first + index) % this->inputs.size()];
+}
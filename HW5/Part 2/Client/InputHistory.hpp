@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Event.hpp"
+#include "Player.hpp"
+
+const size_t INPUT_HISTORY_SIZE = 128; // Unacknowledged inputs kept for replay, about 2 seconds at 60 fps
+const size_t INPUT_SEND_MAX = 32; // Most unacknowledged inputs resent in a single client message
+const float INPUT_MAX_ELAPSED = 0.1f; // Longest frame a single input is simulated for
+
+const uint8_t KEY_UP = 1 << 0; // Up key bit of packed keys
+const uint8_t KEY_LEFT = 1 << 1; // Left key bit of packed keys
+const uint8_t KEY_RIGHT = 1 << 2; // Right key bit of packed keys
+
+/**
+ * @brief One frame of a client's input
+ */
+struct InputCommand {
+    uint32_t sequence; // Sequence number, starts at 1 and counts up every frame
+    KeysPressed keys; // Keys held during the frame
+    float elapsed; // Length of the frame in seconds
+};
+
+/**
+ * @brief Pack the pressed keys into a single byte to send
+ *
+ * @param keys keys pressed
+ * @return uint8_t KEY_* bits of the pressed keys
+ */
+uint8_t packKeys(const KeysPressed& keys);
+
+/**
+ * @brief Unpack the pressed keys from a received byte
+ *
+ * @param keys KEY_* bits of the pressed keys
+ * @return KeysPressed keys pressed
+ */
+KeysPressed unpackKeys(uint8_t keys);
+
+/**
+ * @brief Get how long an input is simulated for, its frame length limited to INPUT_MAX_ELAPSED
+ *
+ * @param input input to simulate
+ * @return float seconds the input moves the player for
+ */
+float getInputElapsed(const InputCommand& input);
+
+/**
+ * @brief Move a player by one frame of input. The server and client both run this so the client's
+ * prediction ends up where the server puts the player. The position is snapped to the quantized
+ * positions snapshots send, so both round the same way.
+ *
+ * @param player player to move
+ * @param input input to simulate
+ */
+void simulateInput(Player* player, const InputCommand& input);
+
+/**
+ * @brief Ring of the inputs a client has predicted but the server hasn't acknowledged yet
+ */
+class InputHistory {
+    public:
+        /**
+         * @brief Construct a new Input History object
+         *
+         * @param capacity number of inputs to keep
+         */
+        InputHistory(size_t capacity);
+
+        /**
+         * @brief Record a new frame of input, replacing the oldest one if the history is full
+         *
+         * @param keys keys held during the frame
+         * @param elapsed length of the frame in seconds
+         * @return const InputCommand& recorded input with its sequence number
+         */
+        const InputCommand& push(KeysPressed keys, float elapsed);
+
+        /**
+         * @brief Forget every input up to and including a sequence number
+         *
+         * @param sequence last sequence number the server has simulated
+         */
+        void acknowledge(uint32_t sequence);
+
+        /**
+         * @brief Get the number of unacknowledged inputs
+         *
+         * @return size_t number of inputs
+         */
+        size_t size() const;
+
+        /**
+         * @brief Get an unacknowledged input, oldest first
+         *
+         * @param index index of the input
+         * @return const InputCommand& input
+         */
+        const InputCommand& at(size_t index) const;
+
+    private:
+        std::vector<InputCommand> inputs; // Ring of inputs
+        size_t first; // Index of the oldest input in the ring
+        size_t count; // Number of inputs in the ring
+        uint32_t nextSequence; // Sequence number of the next input
+};
@@ -74,6 +74,7 @@ sf::FloatRect Platform::getGlobalBounds() const {
  */
 void Platform::move(float xOffset, float yOffset) {
     setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
+    updateCollisionBounds();
 }
 
 /**
@@ -83,6 +84,7 @@ void Platform::move(float xOffset, float yOffset) {
  */
 void Platform::move(sf::Vector2f offset) {
     setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
+    updateCollisionBounds();
 }
 
 /**
@@ -225,6 +227,7 @@ sf::FloatRect MovingPlatform::getGlobalBounds() const {
  */
 void MovingPlatform::move(float xOffset, float yOffset) {
     setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
+    updateCollisionBounds();
 }
 
 /**
@@ -234,6 +237,7 @@ void MovingPlatform::move(float xOffset, float yOffset) {
  */
 void MovingPlatform::move(sf::Vector2f offset) {
     setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
+    updateCollisionBounds();
 }
 
 /**
@@ -298,6 +302,7 @@ void MovingPlatform::update(float time) {
         if(directionOffsetLength < 1.f) {
             totalMovement = sf::Vector2f(_destX - currentPosition.x, _destY - currentPosition.y);
             setPosition(_destX, _destY);
+            updateCollisionBounds();
             paused = true;
             pauseTimer = _pauseLength;
         }
@@ -326,6 +331,7 @@ void MovingPlatform::update(float time) {
         if(directionOffsetLength < 1.f) {
             totalMovement = sf::Vector2f(_x - currentPosition.x, _y - currentPosition.y);
             setPosition(_x, _y);
+            updateCollisionBounds();
             paused = true;
             pauseTimer = _pauseLength;
         }
@@ -1,6 +1,9 @@
 #include "Player.hpp"
 #include "EventManager.hpp"
 
+// Reused for every broadphase query so checking collisions doesn't allocate
+static std::vector<Collider*> playerCollisionHits;
+
 struct KeysPressed;
 
 /**
@@ -113,6 +116,27 @@ void Player::move(sf::Vector2f offset) {
     setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
 }
 
+/**
+ * @brief Hides sf::Sprite's setPosition so every teleport also updates the broadphase.
+ * 
+ * @param x x position
+ * @param y y position
+ */
+void Player::setPosition(float x, float y) {
+    sf::Sprite::setPosition(x, y);
+    updateCollisionBounds();
+}
+
+/**
+ * @brief Hides sf::Sprite's setPosition so every teleport also updates the broadphase.
+ * 
+ * @param position position to move to
+ */
+void Player::setPosition(const sf::Vector2f& position) {
+    sf::Sprite::setPosition(position);
+    updateCollisionBounds();
+}
+
 /**
  * @brief Override of the getPosition function.
  * 
@@ -180,29 +204,29 @@ void Player::update(float time, KeysPressed keysPressed, EventManager* manager)
  */
 bool Player::checkCollision(EventManager* manager) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
+        // Still carried by the platform stood on last frame if it reaches below the player
         bool bottomCollision = false;
+        if(onPlatform && collidingPlatform) {
+            sf::FloatRect platformBounds = collidingPlatform->getCollisionBounds();
+            bottomCollision = checkBounds.top + checkBounds.height < platformBounds.top + platformBounds.height;
+        }
 
-        for(Collider* collideable : collisionObjects) {
+        // Only the colliders the broadphase finds overlapping the player can collide with it
+        collisionBroadphase.query(checkBounds, playerCollisionHits);
+        for(Collider* collideable : playerCollisionHits) {
             if(collideable == this) {
                 continue;
             }
 
-            sf::FloatRect collideableBounds = collideable->getGlobalBounds();
-
-            if(checkBounds.top + checkBounds.height < collideableBounds.top + collideableBounds.height && onPlatform) {
-                bottomCollision = true;
-            }
-
-            if(checkBounds.intersects(collideableBounds)) {
-                if(checkBounds.top + checkBounds.height >= collideableBounds.top && checkBounds.top < collideableBounds.top) {
-                    onPlatform = true;
-                }
-                collidingPlatform = collideable;
-                manager->registerEvent(new EventCollisionHandler(manager, new EventCollision(this, new GameObject("", collideable))));
-                return true;
+            sf::FloatRect collideableBounds = collideable->getCollisionBounds();
+            if(checkBounds.top + checkBounds.height >= collideableBounds.top && checkBounds.top < collideableBounds.top) {
+                onPlatform = true;
             }
+            collidingPlatform = collideable;
+            manager->registerEvent(new EventCollisionHandler(manager, new EventCollision(this, new GameObject("", collideable))));
+            return true;
         }
         if(bottomCollision && !isJumping) {
             // Constants are tested to have additional movement due to collision not being directly detected every frame.
@@ -222,7 +246,7 @@ bool Player::checkCollision(EventManager* manager) {
  */
 bool Player::checkCollision(sf::FloatRect objectToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
         if(checkBounds.intersects(objectToCheck)) {
             return true;
@@ -237,11 +261,11 @@ bool Player::checkCollision(sf::FloatRect objectToCheck) {
  * @param std::vector<Collider*> bounds to check for collision
  * @return bool of whether the collide object collides with the object.
  */
-bool Player::checkCollision(std::vector<sf::FloatRect> objectsToCheck) {
+bool Player::checkCollision(const std::vector<sf::FloatRect>& objectsToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
-        for(sf::FloatRect bounds : objectsToCheck) {
+        for(const sf::FloatRect& bounds : objectsToCheck) {
             if(checkBounds.intersects(bounds)) {
                 return true;
             }
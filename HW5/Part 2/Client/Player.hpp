@@ -11,9 +11,6 @@ class EventManager;
  */
 struct KeysPressed;
 
-// Global List containing all collionable objects
-extern std::vector<Collider*> collisionObjects;
-
 /**
  * @brief Class for a controlled player character
  */
@@ -74,6 +71,21 @@ class Player : public sf::Sprite, public Collider {
          */
         void move(sf::Vector2f offset) override;
 
+        /**
+         * @brief Hides sf::Sprite's setPosition so every teleport also updates the broadphase.
+         * 
+         * @param x x position
+         * @param y y position
+         */
+        void setPosition(float x, float y);
+
+        /**
+         * @brief Hides sf::Sprite's setPosition so every teleport also updates the broadphase.
+         * 
+         * @param position position to move to
+         */
+        void setPosition(const sf::Vector2f& position);
+
          /**
          * @brief Override of the getPosition function.
          * 
@@ -117,7 +129,7 @@ class Player : public sf::Sprite, public Collider {
          * @param std::vector<sf::FloatRect> collideable objects to check for collision
          * @return bool of whether the collide object collides with the object.
          */
-        bool checkCollision(std::vector<sf::FloatRect> objectsToCheck);
+        bool checkCollision(const std::vector<sf::FloatRect>& objectsToCheck);
 
     private:
         float _speed; // Speed of the player
@@ -45,6 +45,7 @@ sf::FloatRect PlayerProjectile::getGlobalBounds() const {
  */
 void PlayerProjectile::move(float xOffset, float yOffset) {
     setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
+    updateCollisionBounds();
 }
 
 /**
@@ -54,6 +55,7 @@ void PlayerProjectile::move(float xOffset, float yOffset) {
  */
 void PlayerProjectile::move(sf::Vector2f offset) {
     setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
+    updateCollisionBounds();
 }
 
 /**
@@ -82,7 +84,7 @@ sf::Vector2f PlayerProjectile::getMovement() {
  */
 bool PlayerProjectile::checkCollision(sf::FloatRect objectToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
         if(checkBounds.intersects(objectToCheck)) {
             return true;
@@ -97,11 +99,11 @@ bool PlayerProjectile::checkCollision(sf::FloatRect objectToCheck) {
  * @param std::vector<Collider*> bounds to check for collision
  * @return bool of whether the collide object collides with the object.
  */
-bool PlayerProjectile::checkCollision(std::vector<sf::FloatRect> objectsToCheck) {
+bool PlayerProjectile::checkCollision(const std::vector<sf::FloatRect>& objectsToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
-        for(sf::FloatRect bounds : objectsToCheck) {
+        for(const sf::FloatRect& bounds : objectsToCheck) {
             if(checkBounds.intersects(bounds)) {
                 return true;
             }
@@ -166,6 +168,7 @@ sf::FloatRect EnemyProjectile::getGlobalBounds() const {
  */
 void EnemyProjectile::move(float xOffset, float yOffset) {
     setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
+    updateCollisionBounds();
 }
 
 /**
@@ -175,6 +178,7 @@ void EnemyProjectile::move(float xOffset, float yOffset) {
  */
 void EnemyProjectile::move(sf::Vector2f offset) {
     setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
+    updateCollisionBounds();
 }
 
 /**
@@ -203,7 +207,7 @@ sf::Vector2f EnemyProjectile::getMovement() {
  */
 bool EnemyProjectile::checkCollision(sf::FloatRect objectToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
         if(checkBounds.intersects(objectToCheck)) {
             return true;
@@ -218,11 +222,11 @@ bool EnemyProjectile::checkCollision(sf::FloatRect objectToCheck) {
  * @param std::vector<Collider*> bounds to check for collision
  * @return bool of whether the collide object collides with the object.
  */
-bool EnemyProjectile::checkCollision(std::vector<sf::FloatRect> objectsToCheck) {
+bool EnemyProjectile::checkCollision(const std::vector<sf::FloatRect>& objectsToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
-        for(sf::FloatRect bounds : objectsToCheck) {
+        for(const sf::FloatRect& bounds : objectsToCheck) {
             if(checkBounds.intersects(bounds)) {
                 return true;
             }
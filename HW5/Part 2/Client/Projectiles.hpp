@@ -82,7 +82,7 @@ class PlayerProjectile : public sf::RectangleShape, public Collider {
          * @param std::vector<sf::FloatRect> collideable objects to check for collision
          * @return bool of whether the collide object collides with the object.
          */
-        bool checkCollision(std::vector<sf::FloatRect> objectsToCheck);
+        bool checkCollision(const std::vector<sf::FloatRect>& objectsToCheck);
 
     private:
         
@@ -165,7 +165,7 @@ class EnemyProjectile : public sf::RectangleShape, public Collider {
          * @param std::vector<sf::FloatRect> collideable objects to check for collision
          * @return bool of whether the collide object collides with the object.
          */
-        bool checkCollision(std::vector<sf::FloatRect> objectsToCheck);
+        bool checkCollision(const std::vector<sf::FloatRect>& objectsToCheck);
 
     private:
         
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SnapshotHistory.hpp"
+
+const double INTERPOLATION_DELAY = 0.1; // Seconds remote entities are drawn behind the server, two snapshots at 20 Hz
+const double MAX_EXTRAPOLATION = 0.25; // Seconds an entity keeps moving past its newest snapshot when snapshots stop arriving
+const double CLOCK_SMOOTHING = 0.1; // How quickly the estimated server clock follows new snapshots, from 0 to 1
+const size_t INTERPOLATION_SAMPLES = 16; // Positions kept for each entity
+
+/**
+ * @brief Position of an entity at a point in server time
+ */
+struct PositionSample {
+    double time; // Server time of the snapshot in seconds
+    float x; // X position
+    float y; // Y position
+};
+
+/**
+ * @brief Latest state of a remote entity and its recent positions
+ */
+struct InterpolatedEntity {
+    EntityState latest; // Newest state received, its position is replaced when sampled
+    PositionSample samples[INTERPOLATION_SAMPLES]; // Ring of recent positions
+    size_t next; // Index in the ring the next position is written to
+    size_t count; // Number of positions in the ring
+    bool removed; // Whether the entity has left the snapshot
+};
+
+/**
+ * @brief Buffers received snapshots so remote entities can be drawn a fixed delay behind the server,
+ * moving smoothly between snapshots instead of jumping each time one arrives
+ */
+class SnapshotInterpolator {
+    public:
+        /**
+         * @brief Construct a new Snapshot Interpolator object
+         *
+         * @param delay seconds remote entities are drawn behind the server
+         */
+        SnapshotInterpolator(double delay);
+
+        /**
+         * @brief Add the positions of every entity in a received snapshot
+         *
+         * @param state full world state of the snapshot
+         * @param removed entities removed by the snapshot
+         * @param serverTime server time of the snapshot in seconds
+         * @param localTime local time the snapshot arrived in seconds
+         */
+        void addSnapshot(const WorldState& state, const std::vector<EntityState>& removed, double serverTime, double localTime);
+
+        /**
+         * @brief Get the server time entities should be drawn at
+         *
+         * @param localTime current local time in seconds
+         * @return double server time in seconds
+         */
+        double getRenderTime(double localTime) const;
+
+        /**
+         * @brief Get the position of an entity at a server time. Positions between two snapshots are
+         * interpolated, and past the newest snapshot they are extrapolated for up to MAX_EXTRAPOLATION.
+         *
+         * @param entity entity to sample
+         * @param renderTime server time to sample at
+         * @return EntityState latest state of the entity at the sampled position
+         */
+        EntityState sample(const InterpolatedEntity& entity, double renderTime) const;
+
+        /**
+         * @brief Get every entity that has been received
+         *
+         * @return std::vector<InterpolatedEntity>& buffered entities
+         */
+        std::vector<InterpolatedEntity>& getEntities();
+
+        /**
+         * @brief Forget the entities that have been removed from the snapshot
+         */
+        void clearRemoved();
+
+    private:
+        /**
+         * @brief Find the buffered entity for an entity state by its network id, adding it if it's new
+         *
+         * @param entity entity to find
+         * @return InterpolatedEntity& buffered entity
+         */
+        InterpolatedEntity& findEntity(const EntityState& entity);
+
+        std::vector<InterpolatedEntity> entities; // Every entity that has been received
+        std::vector<size_t> entityIndex; // Index in entities plus one of each network id, 0 if it isn't buffered
+        double delay; // Seconds entities are drawn behind the server
+        double clockOffset; // Estimated local time minus server time
+        bool hasClock; // Whether a snapshot has been received to estimate the clock from
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <SFML/Graphics/Rect.hpp>
+
+#include "Broadphase.hpp"
+
+const float SPATIAL_HASH_CELL_SIZE = 64.f; // Width and height of a cell, a few times the size of a player or enemy
+const size_t SPATIAL_HASH_MAX_CELLS = 256; // Colliders covering more cells than this are kept in a list instead
+
+/**
+ * @brief A collider in the hash and the cells its bounds covered when it was last updated
+ */
+struct SpatialHashProxy {
+    Collider* collider; // Collider the proxy stands for, nullptr when the slot is free
+    sf::FloatRect bounds; // Bounds of the collider when it was last updated
+    int32_t minX; // First column of cells covered
+    int32_t minY; // First row of cells covered
+    int32_t maxX; // Last column of cells covered
+    int32_t maxY; // Last row of cells covered
+    bool oversized; // Whether the collider is in the oversized list instead of the cells
+    uint32_t queryStamp; // Last query that reported the collider, so ones in many cells are reported once
+};
+
+/**
+ * @brief Uniform grid broadphase. Colliders are filed under every cell their bounds cover, so finding what
+ * overlaps a box only looks at the colliders in the few cells around it instead of every collider. Cells
+ * only exist while something is in them, so the world has no fixed size. Colliders so large they would cover
+ * more than SPATIAL_HASH_MAX_CELLS cells (the death zone under the level) are checked on every query instead.
+ */
+class SpatialHash : public Broadphase {
+    public:
+        /**
+         * @brief Construct an empty Spatial Hash object
+         *
+         * @param cellSize width and height of a cell
+         */
+        SpatialHash(float cellSize = SPATIAL_HASH_CELL_SIZE);
+
+        /**
+         * @brief Add a collider
+         *
+         * @param collider collider to add
+         * @param bounds current bounds of the collider
+         * @return uint32_t proxy to update or remove the collider with
+         */
+        uint32_t insert(Collider* collider, const sf::FloatRect& bounds) override;
+
+        /**
+         * @brief Move a collider to new bounds, only touching the cells if it crossed into different ones
+         *
+         * @param proxy proxy returned when the collider was added
+         * @param bounds new bounds of the collider
+         */
+        void update(uint32_t proxy, const sf::FloatRect& bounds) override;
+
+        /**
+         * @brief Remove a collider
+         *
+         * @param proxy proxy returned when the collider was added
+         */
+        void remove(uint32_t proxy) override;
+
+        /**
+         * @brief Find every collider whose bounds overlap a box, each reported once
+         *
+         * @param bounds box to check
+         * @param hits cleared and filled with the colliders found
+         */
+        void query(const sf::FloatRect& bounds, std::vector<Collider*>& hits) override;
+
+        /**
+         * @brief Find every collider whose bounds contain a point, only looking in the point's cell
+         *
+         * @param point point to check
+         * @param hits cleared and filled with the colliders found
+         */
+        void queryPoint(sf::Vector2f point, std::vector<Collider*>& hits) override;
+
+        /**
+         * @brief Find the first collider a line segment hits, checking the colliders in the cells around the
+         * segment
+         *
+         * @param from start of the segment
+         * @param to end of the segment
+         * @param hit filled with the closest collider hit
+         * @param ignore collider to skip, usually whatever cast the ray
+         * @return bool whether anything was hit
+         */
+        bool raycast(sf::Vector2f from, sf::Vector2f to, BroadphaseRayHit& hit, const Collider* ignore = nullptr) override;
+
+        /**
+         * @brief Get the number of colliders in the hash
+         *
+         * @return size_t number of colliders
+         */
+        size_t size() const override;
+
+    private:
+        /**
+         * @brief Get the cell a coordinate falls in
+         *
+         * @param coordinate x or y coordinate
+         * @return int32_t column or row of the cell
+         */
+        int32_t getCell(float coordinate) const;
+
+        /**
+         * @brief Get the key a cell is stored under
+         *
+         * @param x column of the cell
+         * @param y row of the cell
+         * @return uint64_t key of the cell
+         */
+        static uint64_t getCellKey(int32_t x, int32_t y);
+
+        /**
+         * @brief File a proxy under every cell its range covers, or in the oversized list
+         *
+         * @param proxy proxy to add
+         */
+        void addToCells(uint32_t proxy);
+
+        /**
+         * @brief Take a proxy out of every cell its range covers, or out of the oversized list
+         *
+         * @param proxy proxy to remove
+         */
+        void removeFromCells(uint32_t proxy);
+
+        float cellSize; // Width and height of a cell
+        std::unordered_map<uint64_t, std::vector<uint32_t>> cells; // Proxies filed under each cell that has any
+        std::vector<uint32_t> oversized; // Proxies too large to file under cells
+        std::vector<SpatialHashProxy> proxies; // Every proxy, indexed by proxy
+        std::vector<uint32_t> freeProxies; // Slots of removed proxies, reused before the list grows
+        uint32_t queryStamp; // Incremented on every query
+        size_t count; // Colliders in the hash
+};
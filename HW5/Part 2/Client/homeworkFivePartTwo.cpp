@@ -40,6 +40,8 @@ std::vector<Enemy*> col6;
 std::vector<Enemy*> col7;
 std::vector<Enemy*> col8;
 std::vector<int> currentColumns{1, 2, 3, 4, 5, 6, 7, 8};
+std::vector<Enemy*> enemiesShot; // Enemies hit by a player projectile this frame
+std::vector<Collider*> broadphaseHits; // Reused for every broadphase query in the frame
 
 /**
  * @brief Get the Random Spawn Point object from the spawnPoints vector
@@ -306,6 +308,16 @@ void initializeEnemies() {
 }
 
 void clearEnv() {
+    // Take everything that is about to be forgotten out of the broadphase
+    for(Enemy* enemy : enemies) {
+        enemy->setCollisionEnabled(false);
+    }
+    for(PlayerProjectile* projectile : playerProjectiles) {
+        projectile->setCollisionEnabled(false);
+    }
+    for(EnemyProjectile* projectile : enemyProjectiles) {
+        projectile->setCollisionEnabled(false);
+    }
     drawObjects.clear();
     enemies.clear();
     projectilesToRemove.clear();
@@ -378,13 +390,14 @@ int main() {
     player->setCollisionEnabled(true);
     drawObjects.push_back(player);
 
-    PlayerClient playerClient = {"One", player, true};
+    PlayerClient playerClient = {"One", player, true, NETWORK_NO_ID};
     Client client(&playerClient, &playerClients);
 
-    client.requesterFunction(&playerClient);
+    client.setViewBounds(window.getView());
+    client.senderFunction(&playerClient);
 
     Thread subscriberThread = Thread(0, nullptr, &m, &cv, [&]() {
-        client.subscriberFunction(&objects, &eventManager);
+        client.subscriberFunction(&eventManager);
     });
     std::thread runReplier(run_wrapper, &subscriberThread);
 
@@ -442,7 +455,7 @@ int main() {
             if (event.type == sf::Event::Closed) {
                 window.close();
                 playerClient.isActive = false;
-                client.requesterFunction(&playerClient);
+                client.senderFunction(&playerClient);
             }
         }
 
@@ -493,31 +506,40 @@ int main() {
             }
         }
 
-        if(player->checkCollision(sidebar1->getGlobalBounds())) {
+        if(player->checkCollision(sidebar1->getCollisionBounds())) {
             player->setPosition(15.f, player->getPosition().y);
         }
-        else if(player->checkCollision(sidebar2->getGlobalBounds())) {
+        else if(player->checkCollision(sidebar2->getCollisionBounds())) {
             player->setPosition(WINDOW_WIDTH - 15.f - 22.f, player->getPosition().y);
         }
 
         if(!endUIShow) {
-            eventManager.registerEvent(new EventInputHandler(&eventManager, new EventInput(player, &keysPressed, elapsed)));
+            client.predictInput(keysPressed, elapsed);
 
             eventManager.raise();
 
-            client.requesterFunction(&playerClient);
+            client.setViewBounds(window.getView());
+            client.senderFunction(&playerClient);
+            client.updateRemoteEntities(&objects);
 
             window.clear(sf::Color(0, 0, 0));
 
             eventManager.raise();
 
-            for(EnemyProjectile* projectile : enemyProjectiles) {
-                if(player->checkCollision(projectile->getGlobalBounds())) {
-                    enemyProjectilesToRemove.push_back(projectile);
-                    lives--;
-                    break;
+            // Only the enemy projectiles the broadphase finds overlapping the player can hit it
+            if(player->getCollisionEnabled()) {
+                collisionBroadphase.query(player->getCollisionBounds(), broadphaseHits);
+                for(Collider* hit : broadphaseHits) {
+                    EnemyProjectile* projectile = dynamic_cast<EnemyProjectile*>(hit);
+                    if(projectile) {
+                        enemyProjectilesToRemove.push_back(projectile);
+                        lives--;
+                        break;
+                    }
                 }
             }
+            // Other players' shots the server confirmed
+            lives -= client.takeHits();
 
             if(lives <= 0) {
                 clearEnv();
@@ -698,23 +720,35 @@ int main() {
                 }
             }
 
+            // Ask the broadphase which enemies each projectile overlaps instead of testing every pair
+            enemiesShot.clear();
+            for(PlayerProjectile* projectile : playerProjectiles) {
+                collisionBroadphase.query(projectile->getCollisionBounds(), broadphaseHits);
+                for(Collider* hit : broadphaseHits) {
+                    Enemy* enemy = dynamic_cast<Enemy*>(hit);
+                    if(enemy) {
+                        enemiesShot.push_back(enemy);
+                        projectilesToRemove.push_back(projectile);
+                    }
+                    else if(client.reportShot(hit, projectile->getCollisionBounds())) {
+                        // The server checks the hit against where the other player was on our screen
+                        projectilesToRemove.push_back(projectile);
+                        break;
+                    }
+                }
+            }
+
             for(Enemy* enemy: enemies) {
                 if(enemy->getPosition().y >= 345) {
                     enemyReached = true;
                 }
 
-                bool enemyShot = false;
-                for(PlayerProjectile* projectile : playerProjectiles) {
-                    if(enemy->checkCollision(projectile->getGlobalBounds())) {
-                        projectilesToRemove.push_back(projectile);
-                        enemyShot = true;
-                        break;
-                    }
-                }
+                bool enemyShot = std::find(enemiesShot.begin(), enemiesShot.end(), enemy) != enemiesShot.end();
                 if(!enemyShot) {
                     enemy->update(elapsed, enemyMovement);
                 }
                 else {
+                    enemy->setCollisionEnabled(false);
                     drawObjects.erase(std::remove(drawObjects.begin(), drawObjects.end(), enemy), drawObjects.end());
                     enemies.erase(std::remove(enemies.begin(), enemies.end(), enemy), enemies.end());
                     int column = enemy->getColumn();
@@ -793,6 +827,7 @@ int main() {
 
             // Remove projectiles outside of the loop
             for (PlayerProjectile* projectileToRemove : projectilesToRemove) {
+                projectileToRemove->setCollisionEnabled(false);
                 drawObjects.erase(std::remove(drawObjects.begin(), drawObjects.end(), projectileToRemove), drawObjects.end());
                 playerProjectiles.erase(std::remove(playerProjectiles.begin(), playerProjectiles.end(), projectileToRemove), playerProjectiles.end());
             }
@@ -809,10 +844,11 @@ int main() {
 
             // Remove projectiles outside of the loop
             for (EnemyProjectile* projectileToRemove : enemyProjectilesToRemove) {
+                projectileToRemove->setCollisionEnabled(false);
                 drawObjects.erase(std::remove(drawObjects.begin(), drawObjects.end(), projectileToRemove), drawObjects.end());
                 enemyProjectiles.erase(std::remove(enemyProjectiles.begin(), enemyProjectiles.end(), projectileToRemove), enemyProjectiles.end());
             }
-            projectilesToRemove.clear();
+            enemyProjectilesToRemove.clear();
 
             // Draw scene objects
             for(sf::Drawable* object : drawObjects) {
@@ -0,0 +1,203 @@
+#include "BotClient.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Clear load stats, keeping the memory of the latencies
+ *
+ * @param stats stats to clear
+ */
+void resetLoadStats(LoadStats& stats) {
+    stats.sends = 0;
+    stats.droppedSends = 0;
+    stats.snapshots = 0;
+    stats.snapshotBytes = 0;
+    stats.missedSnapshots = 0;
+    stats.events = 0;
+    stats.latencies.clear();
+    stats.serverSamples = 0;
+    stats.simulationMicros = 0.0;
+    stats.publishMicros = 0.0;
+    stats.publishAllocations = 0.0;
+    stats.maxSimulationMicros = 0.f;
+    stats.maxPublishMicros = 0.f;
+}
+
+/**
+ * @brief Add one group of bots' stats to another
+ *
+ * @param total stats to add to
+ * @param stats stats to add
+ */
+void mergeLoadStats(LoadStats& total, const LoadStats& stats) {
+    total.sends += stats.sends;
+    total.droppedSends += stats.droppedSends;
+    total.snapshots += stats.snapshots;
+    total.snapshotBytes += stats.snapshotBytes;
+    total.missedSnapshots += stats.missedSnapshots;
+    total.events += stats.events;
+    total.latencies.insert(total.latencies.end(), stats.latencies.begin(), stats.latencies.end());
+    total.serverSamples += stats.serverSamples;
+    total.simulationMicros += stats.simulationMicros;
+    total.publishMicros += stats.publishMicros;
+    total.publishAllocations += stats.publishAllocations;
+    total.maxSimulationMicros = std::max(total.maxSimulationMicros, stats.maxSimulationMicros);
+    total.maxPublishMicros = std::max(total.maxPublishMicros, stats.maxPublishMicros);
+}
+
+/**
+ * @brief Get the keys a pattern holds down on a frame
+ *
+ * @param pattern pattern being played
+ * @param frame frame number, 60 frames a second
+ * @param seed different for every bot so wandering bots don't move together
+ * @return uint8_t keys, packed like packKeys in the client
+ */
+uint8_t getPatternKeys(BotPattern pattern, uint32_t frame, uint32_t seed) {
+    switch(pattern) {
+        case BotPattern::PACE:
+            // Walk left for a second, then right for a second
+            return (frame / 60) % 2 == 0 ? BOT_KEY_LEFT : BOT_KEY_RIGHT;
+        case BotPattern::JUMP:
+            // Hold jump for a quarter of a second every second
+            return frame % 60 < 15 ? BOT_KEY_UP : 0;
+        case BotPattern::WANDER: {
+            // Pick new keys every half a second
+            uint32_t hash = (frame / 30 + seed * 2654435761u) * 2246822519u;
+            hash ^= hash >> 15;
+            return static_cast<uint8_t>(hash & (BOT_KEY_UP | BOT_KEY_LEFT | BOT_KEY_RIGHT));
+        }
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Construct a new Bot Client object and connect it to the server
+ *
+ * @param context ZMQ context the bot's sockets are created in
+ * @param host host name or address of the server
+ * @param name name of the bot, at most SNAPSHOT_NAME_LENGTH characters
+ * @param pattern scripted input to play
+ * @param seed different for every bot
+ */
+BotClient::BotClient(zmq::context_t& context, const std::string& host, const std::string& name, BotPattern pattern, uint32_t seed) : writer(SnapshotMessageType::CLIENT_STATE, SNAPSHOT_NO_TICK) {
+    this->name = name;
+    this->pattern = pattern;
+    this->seed = seed;
+    this->lastReceivedTick = SNAPSHOT_NO_TICK;
+    this->inputSequence = 0;
+    this->x = (BOT_VIEW_WIDTH / 2) - 22.f; // Where the client starts its player
+    this->y = BOT_VIEW_HEIGHT - 40.f;
+
+    this->sender = zmq::socket_t{context, zmq::socket_type::dealer};
+    this->subscriber = zmq::socket_t{context, zmq::socket_type::sub};
+    this->sender.setsockopt(ZMQ_SNDHWM, BOT_SENDER_HWM);
+    this->sender.setsockopt(ZMQ_LINGER, BOT_SENDER_LINGER);
+    this->sender.setsockopt(ZMQ_IMMEDIATE, 1);
+    this->subscriber.setsockopt(ZMQ_RCVHWM, BOT_RECEIVER_HWM);
+    this->sender.connect("tcp://" + host + ":5555");
+    this->subscriber.connect("tcp://" + host + ":5556");
+    std::string topic = getClientTopic(name);
+    this->subscriber.setsockopt(ZMQ_SUBSCRIBE, topic.data(), topic.size());
+}
+
+/**
+ * @brief Send one frame of the bot's state and input without waiting for a reply
+ *
+ * @param frame frame number, 60 frames a second
+ * @param elapsed length of the frame in seconds
+ * @param stats stats to count the send in
+ */
+void BotClient::sendFrame(uint32_t frame, float elapsed, LoadStats& stats) {
+    this->inputSequence++;
+    this->writer.reset(SnapshotMessageType::CLIENT_STATE, this->lastReceivedTick);
+    this->writer.addPlayer(NETWORK_NO_ID, this->name, true, this->x, this->y);
+    this->writer.addView(this->x - BOT_VIEW_WIDTH / 2, this->y - BOT_VIEW_HEIGHT / 2, BOT_VIEW_WIDTH, BOT_VIEW_HEIGHT);
+    this->writer.addEventAck(this->eventReceiver.getLastSequence());
+    // Bots are the only clients that ask for the server's tick times
+    uint8_t capabilities = CAPABILITY_SERVER_STATS;
+    if(BOT_COMPRESSION) {
+        capabilities |= CAPABILITY_COMPRESSION;
+    }
+    this->writer.addCapabilities(capabilities);
+    this->writer.addInput(this->name, this->inputSequence, getPatternKeys(this->pattern, frame, this->seed), elapsed);
+    this->writer.setTimestamp(getNetworkTime());
+
+    stats.sends++;
+    zmq::send_result_t sent = this->sender.send(zmq::buffer(this->writer.data(), this->writer.size()), zmq::send_flags::dontwait);
+    if(!sent) {
+        stats.droppedSends++;
+    }
+}
+
+/**
+ * @brief Read every snapshot that has arrived for the bot
+ *
+ * @param stats stats to add the snapshots to
+ */
+void BotClient::receiveSnapshots(LoadStats& stats) {
+    zmq::message_t topic;
+    zmq::message_t message;
+    while(this->subscriber.recv(topic, zmq::recv_flags::dontwait)) {
+        if(!topic.more() || !this->subscriber.recv(message, zmq::recv_flags::none)) {
+            continue;
+        }
+
+        const void* snapshotData = message.data();
+        size_t snapshotSize = message.size();
+        if(isCompressedSnapshot(snapshotData, snapshotSize)) {
+            if(!decompressSnapshot(snapshotData, snapshotSize, this->decompressedSnapshot)) {
+                continue;
+            }
+            snapshotData = this->decompressedSnapshot.data();
+            snapshotSize = this->decompressedSnapshot.size();
+        }
+
+        SnapshotReader snapshot(snapshotData, snapshotSize);
+        if(!snapshot.isValid()) {
+            continue;
+        }
+        stats.snapshots++;
+        stats.snapshotBytes += message.size();
+
+        uint32_t tick = snapshot.getTick();
+        if(this->lastReceivedTick != SNAPSHOT_NO_TICK && tick > this->lastReceivedTick + 1) {
+            stats.missedSnapshots += tick - this->lastReceivedTick - 1;
+        }
+        this->lastReceivedTick = tick;
+        if(snapshot.getTimestamp() != 0) {
+            stats.latencies.push_back(getNetworkTime() - snapshot.getTimestamp());
+        }
+
+        SnapshotRecordView record;
+        while(snapshot.nextRecord(record)) {
+            if(record.getType() == SnapshotRecordType::INPUT_ACK && record.nameEquals(this->name)) {
+                // Keep the view around the bot's player like the client does
+                this->x = record.getX();
+                this->y = record.getY();
+            }
+            else if(record.getType() == SnapshotRecordType::EVENT && this->eventReceiver.receive(record)) {
+                stats.events++;
+            }
+            else if(record.getType() == SnapshotRecordType::SERVER_STATS) {
+                stats.serverSamples++;
+                stats.simulationMicros += record.getX();
+                stats.publishMicros += record.getY();
+                stats.publishAllocations += record.getWidth();
+                stats.maxSimulationMicros = std::max(stats.maxSimulationMicros, record.getX());
+                stats.maxPublishMicros = std::max(stats.maxPublishMicros, record.getY());
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tell the server the bot has left
+ */
+void BotClient::leave() {
+    this->writer.reset(SnapshotMessageType::CLIENT_STATE, this->lastReceivedTick);
+    this->writer.addPlayer(NETWORK_NO_ID, this->name, false, this->x, this->y);
+    this->writer.setTimestamp(getNetworkTime());
+    this->sender.send(zmq::buffer(this->writer.data(), this->writer.size()), zmq::send_flags::dontwait);
+}
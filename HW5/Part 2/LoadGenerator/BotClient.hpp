@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "Snapshot.hpp"
+#include "EventChannel.hpp"
+#include "SnapshotCompression.hpp"
+
+const int BOT_SENDER_HWM = 8; // Same as SENDER_HWM in the client
+const int BOT_SENDER_LINGER = 500; // Same as SENDER_LINGER in the client
+const int BOT_RECEIVER_HWM = 16; // Snapshots queued for a bot before the server starts dropping them
+const float BOT_VIEW_WIDTH = 300.f; // Same as the client's window width
+const float BOT_VIEW_HEIGHT = 400.f; // Same as the client's window height
+const bool BOT_COMPRESSION = true; // Let the server compress large snapshots, snapshot bytes are counted as sent
+const uint8_t BOT_KEY_UP = 1 << 0; // Same bit as KEY_UP in the client's InputHistory.hpp
+const uint8_t BOT_KEY_LEFT = 1 << 1; // Same bit as KEY_LEFT in the client's InputHistory.hpp
+const uint8_t BOT_KEY_RIGHT = 1 << 2; // Same bit as KEY_RIGHT in the client's InputHistory.hpp
+
+/**
+ * @brief Scripted input a bot plays back
+ */
+enum class BotPattern {
+    IDLE, PACE, JUMP, WANDER
+};
+
+/**
+ * @brief What a group of bots measured while connected to the server
+ */
+struct LoadStats {
+    uint64_t sends; // State messages the bots tried to send
+    uint64_t droppedSends; // State messages dropped because the send queue was full
+    uint64_t snapshots; // Snapshots received
+    uint64_t snapshotBytes; // Total size of the received snapshots
+    uint64_t missedSnapshots; // Send ticks the bots never got a snapshot for
+    uint64_t events; // Events received over the reliable channel, each counted once
+    std::vector<uint32_t> latencies; // Microseconds between sending a state and receiving the first snapshot that includes it
+    uint64_t serverSamples; // Server stats records received
+    double simulationMicros; // Total of the simulation tick lengths the server reported
+    double publishMicros; // Total of the send tick lengths the server reported
+    float maxSimulationMicros; // Longest simulation tick the server reported
+    float maxPublishMicros; // Longest send tick the server reported
+    double publishAllocations; // Total of the heap allocations per send tick the server reported
+};
+
+/**
+ * @brief Clear load stats, keeping the memory of the latencies
+ *
+ * @param stats stats to clear
+ */
+void resetLoadStats(LoadStats& stats);
+
+/**
+ * @brief Add one group of bots' stats to another
+ *
+ * @param total stats to add to
+ * @param stats stats to add
+ */
+void mergeLoadStats(LoadStats& total, const LoadStats& stats);
+
+/**
+ * @brief Get the keys a pattern holds down on a frame
+ *
+ * @param pattern pattern being played
+ * @param frame frame number, 60 frames a second
+ * @param seed different for every bot so wandering bots don't move together
+ * @return uint8_t keys, packed like packKeys in the client
+ */
+uint8_t getPatternKeys(BotPattern pattern, uint32_t frame, uint32_t seed);
+
+/**
+ * @brief A headless client that streams scripted input to the server the same way the game client does
+ * and measures the snapshots it gets back. There is no window, no player and no SFML.
+ */
+class BotClient {
+    public:
+        /**
+         * @brief Construct a new Bot Client object and connect it to the server
+         *
+         * @param context ZMQ context the bot's sockets are created in
+         * @param host host name or address of the server
+         * @param name name of the bot, at most SNAPSHOT_NAME_LENGTH characters
+         * @param pattern scripted input to play
+         * @param seed different for every bot
+         */
+        BotClient(zmq::context_t& context, const std::string& host, const std::string& name, BotPattern pattern, uint32_t seed);
+
+        /**
+         * @brief Send one frame of the bot's state and input without waiting for a reply
+         *
+         * @param frame frame number, 60 frames a second
+         * @param elapsed length of the frame in seconds
+         * @param stats stats to count the send in
+         */
+        void sendFrame(uint32_t frame, float elapsed, LoadStats& stats);
+
+        /**
+         * @brief Read every snapshot that has arrived for the bot
+         *
+         * @param stats stats to add the snapshots to
+         */
+        void receiveSnapshots(LoadStats& stats);
+
+        /**
+         * @brief Tell the server the bot has left
+         */
+        void leave();
+
+    private:
+        zmq::socket_t sender; // Dealer socket the bot's state is streamed through
+        zmq::socket_t subscriber; // Subscriber socket the bot's snapshots arrive on
+        std::string name; // Name of the bot
+        BotPattern pattern; // Scripted input the bot plays
+        uint32_t seed; // Different for every bot
+        SnapshotWriter writer; // Reused buffer the bot's state is written into
+        std::vector<uint8_t> decompressedSnapshot; // Latest compressed snapshot once decompressed
+        uint32_t lastReceivedTick; // Last snapshot tick received, acknowledged to the server
+        EventReceiver eventReceiver; // Last event received in order, acknowledged to the server
+        uint32_t inputSequence; // Sequence number of the latest input sent
+        float x; // X position of the bot's player on the server
+        float y; // Y position of the bot's player on the server
+};
@@ -0,0 +1,526 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * Binary wire format shared by the server and client.
+ *
+ * Every message is a fixed 20 byte header followed by recordCount records. All values are little-endian
+ * and floats are sent as their IEEE-754 bit pattern, so nothing has to be formatted or parsed as text.
+ * Readers only ever look at the received bytes, they never copy them.
+ *
+ * Header (20 bytes):
+ *  0  uint32 magic
+ *  4  uint8  version
+ *  5  uint8  message type
+ *  6  uint16 record count
+ *  8  uint32 tick
+ *  12 uint32 base tick (the snapshot a delta is relative to)
+ *  16 uint32 timestamp (microseconds, see getNetworkTime)
+ *
+ * Record (20 bytes plus the fields set in the field mask):
+ *  0  uint8  record type
+ *  1  uint8  field mask
+ *  2  char   name[16] (zero padded, not zero terminated when all 16 bytes are used)
+ *  18 uint16 network id (NETWORK_NO_ID for records that aren't replicated entities)
+ *  20 uint8  flags, if FIELD_FLAGS (isActive for players, event type for events)
+ *  .. float  x position, if FIELD_X
+ *  .. float  y position, if FIELD_Y
+ *     (with FIELD_QUANTIZED, x and y are instead packed into POSITION_BITS each, x in the low bits,
+ *      as fixed point with POSITION_FRACTION_BITS fraction bits relative to the position origin)
+ *  .. float  width and height, if FIELD_SIZE
+ *  .. uint32 sequence number, if FIELD_SEQUENCE
+ *
+ * Entities are identified by the network id the server gave them when they spawned, the name is only
+ * used to match an id to a local object the first time it is seen.
+ *
+ * A full snapshot sends every field of every entity. A delta snapshot only sends the entities and fields
+ * that changed since the base tick, and a FIELD_REMOVED record for entities that are no longer sent.
+ *
+ * Snapshots are fire and forget, a lost one is simply replaced by the next. Events can't be lost, so each
+ * one has a sequence number and is resent in every snapshot until the client acknowledges it with an
+ * EVENT_ACK record (see EventChannel.hpp).
+ *
+ * Clients report a projectile that hit another player on their screen in a SHOT record, with the target's
+ * network id and the projectile's bounds. The server checks it against where the target was when the
+ * client saw it and sends a PLAYER_HIT event if it hit.
+ *
+ * Clients list what they support in a CAPABILITIES record. A snapshot sent to a client that supports
+ * CAPABILITY_COMPRESSION may arrive compressed as a whole, see SnapshotCompression.hpp.
+ */
+
+const uint32_t SNAPSHOT_MAGIC = 0x31504E53; // "SNP1" when read as bytes
+const uint8_t SNAPSHOT_VERSION = 11; // Bump whenever the layout changes
+const size_t SNAPSHOT_HEADER_SIZE = 20; // Size of the message header in bytes
+const size_t SNAPSHOT_RECORD_HEADER_SIZE = 20; // Size of a record before its optional fields
+const size_t SNAPSHOT_NAME_LENGTH = 16; // Max length of a name stored in a record
+const uint16_t SNAPSHOT_MAX_RECORDS = UINT16_MAX; // Most records a message can hold, the header counts them in a uint16
+const uint32_t SNAPSHOT_NO_TICK = 0xFFFFFFFF; // Tick used when there is no snapshot to refer to
+const int SNAPSHOT_TICK_RATE = 20; // Ticks the server publishes per second, clients turn ticks into time with it
+const uint16_t NETWORK_NO_ID = 0; // Network id of records that aren't replicated entities, real ids start at 1
+
+const uint8_t FIELD_FLAGS = 1 << 0; // Record contains the flags byte
+const uint8_t FIELD_X = 1 << 1; // Record contains the x position
+const uint8_t FIELD_Y = 1 << 2; // Record contains the y position
+const uint8_t FIELD_REMOVED = 1 << 3; // Entity is no longer part of the snapshot
+const uint8_t FIELD_SIZE = 1 << 4; // Record contains the width and height
+const uint8_t FIELD_SEQUENCE = 1 << 5; // Record contains a sequence number
+const uint8_t FIELD_QUANTIZED = 1 << 6; // X and y are bit packed fixed point instead of floats
+const uint8_t FIELD_ALL = FIELD_FLAGS | FIELD_X | FIELD_Y; // Every field of an entity
+
+const uint8_t CAPABILITY_COMPRESSION = 1 << 0; // Client can read compressed snapshots
+const uint8_t CAPABILITY_SERVER_STATS = 1 << 1; // Client wants the server's tick times in every snapshot, only load generator bots ask
+
+const bool QUANTIZE_POSITIONS = true; // Send entity and input ack positions as fixed point
+const int POSITION_FRACTION_BITS = 4; // Positions are sent in steps of 1/16 of a pixel
+const int POSITION_BITS = 24; // Bits each quantized position is packed into, at most 32. 24 bits reach 524288 pixels from the origin
+const float POSITION_ORIGIN_X = 0.f; // X position quantized positions are relative to
+const float POSITION_ORIGIN_Y = 0.f; // Y position quantized positions are relative to
+
+/**
+ * @brief Types of messages that can be sent using the snapshot format
+ */
+enum class SnapshotMessageType : uint8_t {
+    SNAPSHOT = 1, CLIENT_STATE = 2, SNAPSHOT_DELTA = 3
+};
+
+/**
+ * @brief Types of records that can be within a message
+ */
+enum class SnapshotRecordType : uint8_t {
+    OBJECT = 1, PLAYER = 2, EVENT = 3, VIEW = 4, INPUT = 5, INPUT_ACK = 6, SERVER_STATS = 7, EVENT_ACK = 8, CAPABILITIES = 9, SHOT = 10
+};
+
+/**
+ * @brief Types of events that can be sent within an event record
+ */
+enum class SnapshotEventType : uint8_t {
+    NONE = 0, CLIENT_DISCONNECT = 1, PLAYER_HIT = 2
+};
+
+/**
+ * @brief Get the topic a client's snapshots are published under. The name is zero terminated so that
+ * subscribing to one client's topic never matches another client whose name starts the same way.
+ *
+ * @param clientName name of the client
+ * @return std::string topic to publish or subscribe to
+ */
+std::string getClientTopic(const std::string& clientName);
+
+/**
+ * @brief Get the current time of a monotonic clock in microseconds. The value wraps around every
+ * ~71 minutes, so only ever compare two timestamps by subtracting them.
+ *
+ * @return uint32_t current timestamp
+ */
+uint32_t getNetworkTime();
+
+/**
+ * @brief Turn a position into fixed point, clamped to what fits in POSITION_BITS
+ *
+ * @param value position to quantize
+ * @param origin position the fixed point value is relative to
+ * @return int32_t fixed point position
+ */
+int32_t quantizePosition(float value, float origin);
+
+/**
+ * @brief Turn a fixed point position back into a position. Exact, so every machine gets the same value.
+ *
+ * @param quantized fixed point position
+ * @param origin position the fixed point value is relative to
+ * @return float position
+ */
+float dequantizePosition(int32_t quantized, float origin);
+
+/**
+ * @brief Round a position to what it will be after being sent, so the sender keeps exactly what the
+ * receiver sees. Returns the position as is when QUANTIZE_POSITIONS is off.
+ *
+ * @param value position to round
+ * @param origin position the fixed point value is relative to
+ * @return float rounded position
+ */
+float snapPosition(float value, float origin);
+
+/**
+ * @brief Writes messages in the snapshot format into a buffer that is reused between messages. A message
+ * holds at most SNAPSHOT_MAX_RECORDS records, any added after that are dropped.
+ */
+class SnapshotWriter {
+    public:
+        /**
+         * @brief Construct a new Snapshot Writer object
+         *
+         * @param type type of message to write
+         * @param tick tick the message belongs to
+         */
+        SnapshotWriter(SnapshotMessageType type, uint32_t tick);
+
+        /**
+         * @brief Clear all records and start a new message, keeping the allocated buffer
+         *
+         * @param type type of message to write
+         * @param tick tick the message belongs to
+         * @param baseTick tick a delta is relative to
+         */
+        void reset(SnapshotMessageType type, uint32_t tick, uint32_t baseTick = SNAPSHOT_NO_TICK);
+
+        /**
+         * @brief Set the timestamp of the message. Clients send the time the message was sent and the
+         * server echoes the newest one it has received from that client.
+         *
+         * @param timestamp timestamp from getNetworkTime
+         */
+        void setTimestamp(uint32_t timestamp);
+
+        /**
+         * @brief Add an object record with every field to the message
+         *
+         * @param id network id of the object
+         * @param name name of the object
+         * @param x x position
+         * @param y y position
+         */
+        void addObject(uint16_t id, const std::string& name, float x, float y);
+
+        /**
+         * @brief Add a player record with every field to the message
+         *
+         * @param id network id of the player
+         * @param name name of the player's client
+         * @param isActive whether the client is still active
+         * @param x x position
+         * @param y y position
+         */
+        void addPlayer(uint16_t id, const std::string& name, bool isActive, float x, float y);
+
+        /**
+         * @brief Add an event record to the message
+         *
+         * @param sequence sequence number of the event in its channel
+         * @param eventType type of event
+         * @param name name the event is about
+         * @param nameLength length of the name
+         */
+        void addEvent(uint32_t sequence, SnapshotEventType eventType, const char* name, size_t nameLength);
+
+        /**
+         * @brief Add a record acknowledging every event up to a sequence number
+         *
+         * @param sequence sequence number of the last event received in order
+         */
+        void addEventAck(uint32_t sequence);
+
+        /**
+         * @brief Add a record listing what the client supports
+         *
+         * @param capabilities CAPABILITY_ bits, sent as the record's flags
+         */
+        void addCapabilities(uint8_t capabilities);
+
+        /**
+         * @brief Add a record with the area of the world the client's camera is showing
+         *
+         * @param left left of the view
+         * @param top top of the view
+         * @param width width of the view
+         * @param height height of the view
+         */
+        void addView(float left, float top, float width, float height);
+
+        /**
+         * @brief Add a record with one frame of a client's input
+         *
+         * @param name name of the client
+         * @param sequence sequence number of the input
+         * @param keys keys pressed, packed with packKeys
+         * @param elapsed seconds of the frame the keys were held for
+         */
+        void addInput(const std::string& name, uint32_t sequence, uint8_t keys, float elapsed);
+
+        /**
+         * @brief Add a record with the last input the server has simulated for a client and where that
+         * left the client's player
+         *
+         * @param name name of the client
+         * @param sequence sequence number of the last simulated input
+         * @param x x position of the player after the input
+         * @param y y position of the player after the input
+         */
+        void addInputAck(const std::string& name, uint32_t sequence, float x, float y);
+
+        /**
+         * @brief Add a record with how long the server's latest ticks took, for load testing
+         *
+         * @param simulationMicros length of the latest simulation tick in microseconds
+         * @param publishMicros length of the latest send tick in microseconds
+         * @param clientCount number of clients connected to the server
+         * @param publishAllocations heap allocations the latest send tick made, sent as the record's width
+         */
+        void addServerStats(float simulationMicros, float publishMicros, uint32_t clientCount, uint32_t publishAllocations);
+
+        /**
+         * @brief Add a record with a projectile that hit a replicated entity on the client's screen
+         *
+         * @param targetId network id of the entity hit
+         * @param left left of the projectile
+         * @param top top of the projectile
+         * @param width width of the projectile
+         * @param height height of the projectile
+         */
+        void addShot(uint16_t targetId, float left, float top, float width, float height);
+
+        /**
+         * @brief Add a record containing only the fields in the field mask
+         *
+         * @param recordType type of record
+         * @param fieldMask fields to write
+         * @param id network id of the entity
+         * @param name name of the entity, at most SNAPSHOT_NAME_LENGTH bytes are used
+         * @param nameLength length of the name
+         * @param flags flags of the entity
+         * @param x x position
+         * @param y y position
+         * @param width width, only written with FIELD_SIZE
+         * @param height height, only written with FIELD_SIZE
+         * @param sequence sequence number, only written with FIELD_SEQUENCE
+         * @return bool whether the record was added, false if the message already holds SNAPSHOT_MAX_RECORDS
+         */
+        bool addRecord(SnapshotRecordType recordType, uint8_t fieldMask, uint16_t id, const char* name, size_t nameLength, uint8_t flags, float x, float y, float width = 0.f, float height = 0.f, uint32_t sequence = 0);
+
+        /**
+         * @brief Swap the encoded message out for another buffer, so a finished message can be handed off
+         * without copying it. The writer keeps the other buffer's memory for the next message.
+         *
+         * @param other buffer to swap with, holds the encoded message afterwards
+         */
+        void swapBuffer(std::vector<uint8_t>& other);
+
+        /**
+         * @brief Get the data of the message
+         *
+         * @return const uint8_t* pointer to the start of the message
+         */
+        const uint8_t* data() const;
+
+        /**
+         * @brief Get the size of the message
+         *
+         * @return size_t size of the message in bytes
+         */
+        size_t size() const;
+
+    private:
+        std::vector<uint8_t> buffer; // Encoded message
+        uint16_t recordCount; // Number of records currently in the message
+};
+
+/**
+ * @brief View of a single record inside of a received message. Reads straight from the message bytes.
+ */
+class SnapshotRecordView {
+    public:
+        /**
+         * @brief Construct an empty Snapshot Record View object
+         */
+        SnapshotRecordView();
+
+        /**
+         * @brief Construct a new Snapshot Record View object
+         *
+         * @param record pointer to the start of the record
+         */
+        SnapshotRecordView(const uint8_t* record);
+
+        /**
+         * @brief Get the record type
+         *
+         * @return SnapshotRecordType type of the record
+         */
+        SnapshotRecordType getType() const;
+
+        /**
+         * @brief Get the fields contained in the record
+         *
+         * @return uint8_t mask of FIELD_* values
+         */
+        uint8_t getFieldMask() const;
+
+        /**
+         * @brief Check if a field is contained in the record
+         *
+         * @param field FIELD_* value to check
+         * @return bool whether the field is in the record
+         */
+        bool hasField(uint8_t field) const;
+
+        /**
+         * @brief Get the network id of the entity in the record
+         *
+         * @return uint16_t network id, NETWORK_NO_ID if the record isn't an entity
+         */
+        uint16_t getId() const;
+
+        /**
+         * @brief Get the flags byte, 0 if the record doesn't contain it
+         *
+         * @return uint8_t flags of the record
+         */
+        uint8_t getFlags() const;
+
+        /**
+         * @brief Get if the player in the record is active
+         *
+         * @return bool whether the player is active
+         */
+        bool isActive() const;
+
+        /**
+         * @brief Get the event type of an event record
+         *
+         * @return SnapshotEventType type of the event
+         */
+        SnapshotEventType getEventType() const;
+
+        /**
+         * @brief Get the x position, 0 if the record doesn't contain it
+         *
+         * @return float x position
+         */
+        float getX() const;
+
+        /**
+         * @brief Get the y position, 0 if the record doesn't contain it
+         *
+         * @return float y position
+         */
+        float getY() const;
+
+        /**
+         * @brief Get the width, 0 if the record doesn't contain it
+         *
+         * @return float width
+         */
+        float getWidth() const;
+
+        /**
+         * @brief Get the height, 0 if the record doesn't contain it
+         *
+         * @return float height
+         */
+        float getHeight() const;
+
+        /**
+         * @brief Get the sequence number, 0 if the record doesn't contain it
+         *
+         * @return uint32_t sequence number
+         */
+        uint32_t getSequence() const;
+
+        /**
+         * @brief Get a pointer to the name bytes in the record
+         *
+         * @return const char* name, zero padded to SNAPSHOT_NAME_LENGTH
+         */
+        const char* getNameData() const;
+
+        /**
+         * @brief Get the name as a string. This allocates, use nameEquals for comparisons.
+         *
+         * @return std::string name in the record
+         */
+        std::string getName() const;
+
+        /**
+         * @brief Compare the name in the record without copying it
+         *
+         * @param name name to compare to
+         * @return bool whether the names match
+         */
+        bool nameEquals(const std::string& name) const;
+
+        /**
+         * @brief Get the size of the record in bytes
+         *
+         * @return size_t size of the record
+         */
+        size_t size() const;
+
+    private:
+        const uint8_t* record; // Start of the record within the message
+};
+
+/**
+ * @brief Reads a message in the snapshot format without copying it
+ */
+class SnapshotReader {
+    public:
+        /**
+         * @brief Construct a new Snapshot Reader object over received bytes. The bytes must outlive the reader.
+         *
+         * @param data received message
+         * @param size size of the received message
+         */
+        SnapshotReader(const void* data, size_t size);
+
+        /**
+         * @brief Check the magic, version and that every record fits within the message
+         *
+         * @return bool whether the message can be read
+         */
+        bool isValid() const;
+
+        /**
+         * @brief Get the Message Type
+         *
+         * @return SnapshotMessageType type of message
+         */
+        SnapshotMessageType getMessageType() const;
+
+        /**
+         * @brief Get the tick the message belongs to. For client state messages this is the last snapshot
+         * tick the client received.
+         *
+         * @return uint32_t tick
+         */
+        uint32_t getTick() const;
+
+        /**
+         * @brief Get the tick a delta snapshot is relative to
+         *
+         * @return uint32_t base tick
+         */
+        uint32_t getBaseTick() const;
+
+        /**
+         * @brief Get the timestamp of the message
+         *
+         * @return uint32_t timestamp
+         */
+        uint32_t getTimestamp() const;
+
+        /**
+         * @brief Get the number of records in the message
+         *
+         * @return uint16_t number of records
+         */
+        uint16_t getRecordCount() const;
+
+        /**
+         * @brief Read the next record of the message
+         *
+         * @param record view to set to the next record
+         * @return bool false once every record has been read
+         */
+        bool nextRecord(SnapshotRecordView& record);
+
+    private:
+        const uint8_t* data; // Start of the message
+        size_t size; // Size of the message in bytes
+        size_t offset; // Offset of the next record to read
+        uint16_t recordsRead; // Number of records read so far
+};
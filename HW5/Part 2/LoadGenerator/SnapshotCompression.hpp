@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * Optional compression stage for large snapshots, used when the client lists CAPABILITY_COMPRESSION.
+ *
+ * A compressed message replaces the whole snapshot, header included. Readers tell the two apart by the
+ * magic, so an uncompressed snapshot is always still accepted.
+ *
+ * Compressed message (8 bytes plus the compressed data):
+ *  0  uint32 magic
+ *  4  uint32 size of the snapshot once decompressed
+ *  8  sequences
+ *
+ * The codec is a byte oriented LZ77 in the style of LZ4. Each sequence is a token byte, with the number
+ * of literals in its high 4 bits and the match length minus COMPRESSION_MIN_MATCH in its low 4 bits, then
+ * any extra literal length bytes, the literals, a little-endian uint16 offset back to the match and any
+ * extra match length bytes. A length of 15 in the token is continued in the following bytes, each adding
+ * up to 255 until a byte under 255. The last sequence is only literals and ends at the end of the message.
+ *
+ * Snapshots compress well since names are zero padded to 16 bytes and most records of a type share
+ * their field mask and flags.
+ */
+
+const uint32_t COMPRESSED_MAGIC = 0x315A4E53; // "SNZ1" when read as bytes
+const size_t COMPRESSED_HEADER_SIZE = 8; // Size of the compressed message header in bytes
+const size_t COMPRESSION_THRESHOLD = 512; // Snapshots smaller than this are always sent as is
+const size_t COMPRESSION_MAX_SIZE = 1 << 22; // Largest decompressed snapshot accepted, guards against corrupt messages
+const size_t COMPRESSION_MIN_MATCH = 4; // Shortest match worth encoding
+const size_t COMPRESSION_MAX_OFFSET = 65535; // Furthest back a match can be
+const int COMPRESSION_HASH_BITS = 12; // Entries in the match finder's hash table, as a power of two
+
+/**
+ * @brief Check if a received message is a compressed snapshot
+ *
+ * @param data received bytes
+ * @param size number of received bytes
+ * @return bool whether the message starts with the compressed magic
+ */
+bool isCompressedSnapshot(const void* data, size_t size);
+
+/**
+ * @brief Decompress a compressed snapshot. The message is never trusted, every length and offset is
+ * checked against both buffers.
+ *
+ * @param data received bytes
+ * @param size number of received bytes
+ * @param out filled with the snapshot, its capacity is kept between messages
+ * @return bool false if the message is corrupt
+ */
+bool decompressSnapshot(const void* data, size_t size, std::vector<uint8_t>& out);
+
+/**
+ * @brief Compresses snapshots, keeping the match finder's memory between messages
+ */
+class SnapshotCompressor {
+    public:
+        /**
+         * @brief Construct a new Snapshot Compressor object
+         */
+        SnapshotCompressor();
+
+        /**
+         * @brief Compress a snapshot
+         *
+         * @param data snapshot to compress
+         * @param size size of the snapshot in bytes
+         * @param out filled with the compressed message, its capacity is kept between messages
+         * @return bool false if compressing didn't make the snapshot smaller, send it as is instead
+         */
+        bool compress(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+    private:
+        std::vector<uint32_t> hashTable; // Last position each hashed 4 bytes were seen at
+};
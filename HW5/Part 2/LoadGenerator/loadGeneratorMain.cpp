@@ -0,0 +1,187 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <zmq.hpp>
+
+#include "BotClient.hpp"
+
+const std::vector<int> LOAD_CLIENT_COUNTS = {1, 10, 25, 50, 100, 200, 300, 400, 500}; // Bots connected at each step of the sweep
+const int LOAD_MAX_CLIENTS = 500; // Most bots connected at once unless another number is given
+const double LOAD_STEP_SECONDS = 5.0; // Seconds measured at each step unless another number is given
+const double LOAD_WARMUP_SECONDS = 1.0; // Seconds the bots run before anything is measured, lets the server add them all
+const int LOAD_SETTLE_MS = 1000; // Time given to the server to remove the bots between steps
+const int LOAD_FRAME_RATE = 60; // Frames each bot sends per second, same as the client
+const int LOAD_IO_THREADS = 2; // ZMQ io threads shared by every bot
+
+/**
+ * @brief Get a percentile of sorted values
+ *
+ * @param sorted values sorted from smallest to largest
+ * @param percent percentile to get
+ * @return uint32_t value at the percentile, 0 if there are no values
+ */
+uint32_t getPercentile(const std::vector<uint32_t>& sorted, int percent) {
+    if(sorted.empty()) {
+        return 0;
+    }
+    return sorted[std::min(sorted.size() - 1, (sorted.size() * percent) / 100)];
+}
+
+/**
+ * @brief Play one group of bots until the step ends, measuring only after the warmup
+ *
+ * @param bots bots to play
+ * @param measureStart when to start measuring
+ * @param end when the step ends
+ * @param stats filled with what the bots measured
+ */
+void runBots(std::vector<BotClient*> bots, std::chrono::steady_clock::time_point measureStart, std::chrono::steady_clock::time_point end, LoadStats* stats) {
+    using clock = std::chrono::steady_clock;
+    clock::duration frameInterval = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / LOAD_FRAME_RATE));
+    float elapsed = 1.f / LOAD_FRAME_RATE;
+
+    bool measuring = false;
+    clock::time_point nextFrame = clock::now();
+    for(uint32_t frame = 0; ; frame++) {
+        clock::time_point now = clock::now();
+        if(now >= end) {
+            break;
+        }
+        if(!measuring && now >= measureStart) {
+            resetLoadStats(*stats);
+            measuring = true;
+        }
+
+        for(BotClient* bot : bots) {
+            bot->sendFrame(frame, elapsed, *stats);
+            bot->receiveSnapshots(*stats);
+        }
+
+        nextFrame += frameInterval;
+        std::this_thread::sleep_until(nextFrame);
+    }
+}
+
+/**
+ * @brief Connect a number of bots to the server, play them for a step of the sweep and disconnect them
+ *
+ * @param count number of bots
+ * @param seconds seconds to measure for
+ * @param host host name or address of the server
+ * @return LoadStats what every bot measured
+ */
+LoadStats runStep(int count, double seconds, const std::string& host) {
+    zmq::context_t context(LOAD_IO_THREADS);
+    context.set(zmq::ctxopt::max_sockets, count * 2 + 16); // Two sockets a bot
+
+    std::vector<std::unique_ptr<BotClient>> bots;
+    const BotPattern patterns[] = {BotPattern::PACE, BotPattern::JUMP, BotPattern::WANDER, BotPattern::IDLE};
+    for(int i = 0; i < count; i++) {
+        bots.emplace_back(new BotClient(context, host, "bot" + std::to_string(i), patterns[i % 4], i));
+    }
+
+    // Split the bots between the cores, each thread plays its bots like a client plays its own
+    int threadCount = std::max(1, std::min(count, static_cast<int>(std::thread::hardware_concurrency())));
+    std::vector<LoadStats> threadStats(threadCount);
+    std::vector<std::thread> threads;
+    std::chrono::steady_clock::time_point measureStart = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(LOAD_WARMUP_SECONDS));
+    std::chrono::steady_clock::time_point end = measureStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+    for(int t = 0; t < threadCount; t++) {
+        std::vector<BotClient*> group;
+        for(int i = (count * t) / threadCount; i < (count * (t + 1)) / threadCount; i++) {
+            group.push_back(bots[i].get());
+        }
+        resetLoadStats(threadStats[t]);
+        threads.emplace_back(runBots, group, measureStart, end, &threadStats[t]);
+    }
+
+    LoadStats total;
+    resetLoadStats(total);
+    for(int t = 0; t < threadCount; t++) {
+        threads[t].join();
+        mergeLoadStats(total, threadStats[t]);
+    }
+
+    for(std::unique_ptr<BotClient>& bot : bots) {
+        bot->leave();
+    }
+    bots.clear(); // Lingers until the leave messages are sent
+    std::this_thread::sleep_for(std::chrono::milliseconds(LOAD_SETTLE_MS));
+    return total;
+}
+
+/**
+ * @brief Print the column names of the report
+ */
+void printHeader() {
+    std::cout << std::setw(8) << "clients"
+              << std::setw(11) << "sim us" << std::setw(11) << "sim max"
+              << std::setw(11) << "send us" << std::setw(11) << "send max" << std::setw(11) << "send alloc"
+              << std::setw(11) << "bytes"
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p95 ms" << std::setw(10) << "p99 ms"
+              << std::setw(10) << "missed %" << std::setw(10) << "drops %" << "\n";
+}
+
+/**
+ * @brief Print one step of the sweep
+ *
+ * @param count number of bots
+ * @param stats what the bots measured
+ */
+void printStep(int count, LoadStats& stats) {
+    std::sort(stats.latencies.begin(), stats.latencies.end());
+    double samples = std::max<uint64_t>(stats.serverSamples, 1);
+    double expected = std::max<uint64_t>(stats.snapshots + stats.missedSnapshots, 1);
+    std::cout << std::setw(8) << count << std::fixed << std::setprecision(1)
+              << std::setw(11) << stats.simulationMicros / samples << std::setw(11) << stats.maxSimulationMicros
+              << std::setw(11) << stats.publishMicros / samples << std::setw(11) << stats.maxPublishMicros
+              << std::setw(11) << stats.publishAllocations / samples
+              << std::setw(11) << static_cast<double>(stats.snapshotBytes) / std::max<uint64_t>(stats.snapshots, 1)
+              << std::setprecision(2)
+              << std::setw(10) << getPercentile(stats.latencies, 50) / 1000.0
+              << std::setw(10) << getPercentile(stats.latencies, 95) / 1000.0
+              << std::setw(10) << getPercentile(stats.latencies, 99) / 1000.0
+              << std::setw(10) << 100.0 * stats.missedSnapshots / expected
+              << std::setw(10) << 100.0 * stats.droppedSends / std::max<uint64_t>(stats.sends, 1) << "\n";
+}
+
+/**
+ * @brief Sweep the number of bots connected to a running server and report how the server holds up.
+ * Server tick times come from the stats the server adds to every snapshot it sends a bot, sizes and
+ * latencies are measured by the bots.
+ *
+ * @param argc number of arguments
+ * @param argv most bots to connect, seconds to measure each step for and the server's host
+ * @return int exit code
+ */
+int main(int argc, char** argv) {
+    int maxClients = argc > 1 ? std::stoi(argv[1]) : LOAD_MAX_CLIENTS;
+    double seconds = argc > 2 ? std::stod(argv[2]) : LOAD_STEP_SECONDS;
+    std::string host = argc > 3 ? argv[3] : "localhost";
+
+    std::vector<int> counts;
+    for(int count : LOAD_CLIENT_COUNTS) {
+        if(count < maxClients) {
+            counts.push_back(count);
+        }
+    }
+    counts.push_back(maxClients);
+
+    std::cout << "Sweeping 1 to " << maxClients << " bots against " << host << ", " << seconds << " s per step\n";
+    printHeader();
+    for(int count : counts) {
+        LoadStats stats = runStep(count, seconds, host);
+        if(stats.snapshots == 0) {
+            std::cout << std::setw(8) << count << "  no snapshots received, is the server running?\n";
+            return 1;
+        }
+        printStep(count, stats);
+    }
+
+    return 0; // Return on end
+}
@@ -0,0 +1,254 @@
+#include "TrafficLog.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Write a value in little-endian order
+ *
+ * @param out where to write
+ * @param value value to write
+ * @param bytes number of bytes of the value to write
+ */
+static void writeTrafficValue(uint8_t* out, uint64_t value, size_t bytes) {
+    for(size_t i = 0; i < bytes; i++) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief Read a value in little-endian order
+ *
+ * @param in where to read
+ * @param bytes number of bytes of the value
+ * @return uint64_t value read
+ */
+static uint64_t readTrafficValue(const uint8_t* in, size_t bytes) {
+    uint64_t value = 0;
+    for(size_t i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Construct a new Traffic Recorder object that doesn't record until opened
+ */
+TrafficRecorder::TrafficRecorder() {
+    this->file = nullptr;
+    this->recording = false;
+}
+
+/**
+ * @brief Destroy the Traffic Recorder object, writing out everything recorded
+ */
+TrafficRecorder::~TrafficRecorder() {
+    close();
+}
+
+/**
+ * @brief Start recording into a file, replacing it if it exists
+ *
+ * @param path path of the log file
+ * @return bool false if the file couldn't be created
+ */
+bool TrafficRecorder::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->file) {
+        std::fclose(this->file);
+        this->recording = false;
+    }
+    this->file = std::fopen(path.c_str(), "wb");
+    if(!this->file) {
+        return false;
+    }
+    this->fileBuffer.resize(TRAFFIC_LOG_BUFFER_SIZE);
+    std::setvbuf(this->file, this->fileBuffer.data(), _IOFBF, this->fileBuffer.size());
+
+    uint8_t header[TRAFFIC_LOG_HEADER_SIZE] = {};
+    writeTrafficValue(header, TRAFFIC_LOG_MAGIC, 4);
+    writeTrafficValue(header + 4, TRAFFIC_LOG_VERSION, 4);
+    std::fwrite(header, 1, sizeof(header), this->file);
+    this->start = std::chrono::steady_clock::now();
+    this->nextFlush = this->start + TRAFFIC_LOG_FLUSH_INTERVAL;
+    this->recording = true;
+    return true;
+}
+
+/**
+ * @brief Check if the recorder is recording
+ *
+ * @return bool whether a log file is open
+ */
+bool TrafficRecorder::isOpen() const {
+    return this->recording;
+}
+
+/**
+ * @brief Record a message, timed by when this is called
+ *
+ * @param direction whether the message was received or published
+ * @param topic topic the message was published under, nullptr for none
+ * @param topicSize size of the topic
+ * @param data the message
+ * @param size size of the message
+ */
+void TrafficRecorder::record(TrafficDirection direction, const void* topic, size_t topicSize, const void* data, size_t size) {
+    if(!this->recording) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(!this->file) {
+        return;
+    }
+    uint64_t time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->start).count();
+    uint8_t header[TRAFFIC_RECORD_HEADER_SIZE] = {};
+    writeTrafficValue(header, time, 8);
+    header[8] = static_cast<uint8_t>(direction);
+    writeTrafficValue(header + 10, topic ? topicSize : 0, 2);
+    writeTrafficValue(header + 12, size, 4);
+    std::fwrite(header, 1, sizeof(header), this->file);
+    if(topic && topicSize > 0) {
+        std::fwrite(topic, 1, topicSize, this->file);
+    }
+    std::fwrite(data, 1, size, this->file);
+}
+
+/**
+ * @brief Write everything recorded so far to the file if TRAFFIC_LOG_FLUSH_INTERVAL has passed since the
+ * last time, so it survives the server being killed. Only one thread may call this.
+ */
+void TrafficRecorder::flushIfDue() {
+    // Checked without the lock, the receive thread never touches the flush time
+    auto now = std::chrono::steady_clock::now();
+    if(!this->recording || now < this->nextFlush) {
+        return;
+    }
+    this->nextFlush = now + TRAFFIC_LOG_FLUSH_INTERVAL;
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->file) {
+        std::fflush(this->file);
+    }
+}
+
+/**
+ * @brief Stop recording and close the file
+ */
+void TrafficRecorder::close() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->file) {
+        std::fclose(this->file);
+        this->file = nullptr;
+        this->recording = false;
+    }
+}
+
+/**
+ * @brief Construct a new Traffic Log Reader object with no log open
+ */
+TrafficLogReader::TrafficLogReader() {
+    this->mapped = nullptr;
+    this->mappedSize = 0;
+    this->offset = 0;
+}
+
+/**
+ * @brief Destroy the Traffic Log Reader object, unmapping the log
+ */
+TrafficLogReader::~TrafficLogReader() {
+    close();
+}
+
+/**
+ * @brief Map a log file into memory
+ *
+ * @param path path of the log file
+ * @return bool false if the file can't be read or isn't a traffic log
+ */
+bool TrafficLogReader::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if(fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < TRAFFIC_LOG_HEADER_SIZE) {
+        ::close(fd);
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(fileStat.st_size);
+    void* data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file open
+    if(data == MAP_FAILED) {
+        return false;
+    }
+
+    this->mapped = static_cast<const uint8_t*>(data);
+    this->mappedSize = fileSize;
+    if(readTrafficValue(this->mapped, 4) != TRAFFIC_LOG_MAGIC || readTrafficValue(this->mapped + 4, 4) != TRAFFIC_LOG_VERSION) {
+        close();
+        return false;
+    }
+    // Records are read front to back
+    madvise(data, fileSize, MADV_SEQUENTIAL);
+    rewind();
+    return true;
+}
+
+/**
+ * @brief Read the next record
+ *
+ * @param record filled with the record, valid until the reader is closed
+ * @return bool false at the end of the log
+ */
+bool TrafficLogReader::next(TrafficRecord& record) {
+    if(!this->mapped || this->mappedSize - this->offset < TRAFFIC_RECORD_HEADER_SIZE) {
+        return false;
+    }
+    const uint8_t* header = this->mapped + this->offset;
+    size_t topicSize = readTrafficValue(header + 10, 2);
+    size_t size = readTrafficValue(header + 12, 4);
+    if(this->mappedSize - this->offset - TRAFFIC_RECORD_HEADER_SIZE < topicSize + size) {
+        return false; // Recording was cut off in the middle of this record
+    }
+
+    record.time = readTrafficValue(header, 8);
+    record.direction = static_cast<TrafficDirection>(header[8]);
+    record.topic = header + TRAFFIC_RECORD_HEADER_SIZE;
+    record.topicSize = topicSize;
+    record.data = record.topic + topicSize;
+    record.size = size;
+    this->offset += TRAFFIC_RECORD_HEADER_SIZE + topicSize + size;
+    return true;
+}
+
+/**
+ * @brief Go back to the first record
+ */
+void TrafficLogReader::rewind() {
+    this->offset = TRAFFIC_LOG_HEADER_SIZE;
+}
+
+/**
+ * @brief Get the size of the log
+ *
+ * @return size_t size of the file in bytes
+ */
+size_t TrafficLogReader::size() const {
+    return this->mappedSize;
+}
+
+/**
+ * @brief Unmap the log
+ */
+void TrafficLogReader::close() {
+    if(this->mapped) {
+        munmap(const_cast<uint8_t*>(this->mapped), this->mappedSize);
+        this->mapped = nullptr;
+        this->mappedSize = 0;
+    }
+    this->offset = 0;
+}
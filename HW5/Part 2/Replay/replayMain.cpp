@@ -0,0 +1,275 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "TrafficLog.hpp"
+#include "Snapshot.hpp"
+#include "SnapshotCompression.hpp"
+
+const int REPLAY_SENDER_HWM = 100000; // Messages queued for the server, sends block once it is full instead of dropping
+const int REPLAY_SENDER_LINGER = 2000; // Milliseconds given to the last messages to go out after the replay ends
+const int REPLAY_PARSE_PASSES = 10; // Times the log is parsed when measuring the parser
+
+/**
+ * @brief How fast a recording is played back
+ */
+enum class ReplaySpeed {
+    REALTIME, MAX, STEP
+};
+
+/**
+ * @brief Summary of a recorded message, read without changing anything
+ */
+struct MessageSummary {
+    bool valid; // Whether the message is a snapshot format message
+    bool compressed; // Whether the message arrived compressed
+    SnapshotMessageType type; // Type of the message
+    uint32_t tick; // Tick of the message
+    size_t recordCount; // Records in the message
+};
+
+/**
+ * @brief Read a recorded message the same way the server and client do, decompressing it if needed
+ *
+ * @param record recorded message
+ * @param buffer reused buffer compressed messages are decompressed into
+ * @return MessageSummary what the message contains
+ */
+MessageSummary readMessage(const TrafficRecord& record, std::vector<uint8_t>& buffer) {
+    MessageSummary summary = {false, false, SnapshotMessageType::SNAPSHOT, SNAPSHOT_NO_TICK, 0};
+    const void* data = record.data;
+    size_t size = record.size;
+    if(isCompressedSnapshot(data, size)) {
+        summary.compressed = true;
+        if(!decompressSnapshot(data, size, buffer)) {
+            return summary;
+        }
+        data = buffer.data();
+        size = buffer.size();
+    }
+
+    SnapshotReader reader(data, size);
+    if(!reader.isValid()) {
+        return summary;
+    }
+    summary.valid = true;
+    summary.type = reader.getMessageType();
+    summary.tick = reader.getTick();
+    SnapshotRecordView view;
+    while(reader.nextRecord(view)) {
+        summary.recordCount++;
+    }
+    return summary;
+}
+
+/**
+ * @brief Print one recorded message, used when stepping through a recording
+ *
+ * @param record recorded message
+ * @param buffer reused buffer compressed messages are decompressed into
+ */
+void printMessage(const TrafficRecord& record, std::vector<uint8_t>& buffer) {
+    MessageSummary summary = readMessage(record, buffer);
+    std::cout << std::fixed << std::setprecision(3) << std::setw(10) << record.time / 1000.0 << " ms "
+              << (record.direction == TrafficDirection::INBOUND ? "in " : "out") << std::setw(8) << record.size << " bytes";
+    if(record.topicSize > 0) {
+        // Topics are the client's name and a zero
+        std::cout << " to " << std::string(reinterpret_cast<const char*>(record.topic), record.topicSize - 1);
+    }
+    if(!summary.valid) {
+        std::cout << " not a valid message\n";
+        return;
+    }
+    std::cout << " type " << static_cast<int>(summary.type) << " tick " << summary.tick
+              << " records " << summary.recordCount << (summary.compressed ? " compressed" : "") << "\n";
+}
+
+/**
+ * @brief Wait until a recorded message is due
+ *
+ * @param speed how fast the recording is played back
+ * @param record message about to be sent
+ * @param start when the playback started
+ * @param buffer reused buffer compressed messages are decompressed into
+ */
+void waitForMessage(ReplaySpeed speed, const TrafficRecord& record, std::chrono::steady_clock::time_point start, std::vector<uint8_t>& buffer) {
+    if(speed == ReplaySpeed::REALTIME) {
+        std::this_thread::sleep_until(start + std::chrono::microseconds(record.time));
+    }
+    else if(speed == ReplaySpeed::STEP) {
+        printMessage(record, buffer);
+        std::string line;
+        std::getline(std::cin, line);
+    }
+}
+
+/**
+ * @brief Send every message the server received to a running server, as if the recorded clients were
+ * connected. The server's own snapshots go to the subscribers of whoever is connected now.
+ *
+ * @param log recording to play
+ * @param speed how fast to play it
+ * @param host host name or address of the server
+ * @return size_t number of messages sent
+ */
+size_t replayToServer(TrafficLogReader& log, ReplaySpeed speed, const std::string& host) {
+    zmq::context_t context(1);
+    zmq::socket_t sender(context, zmq::socket_type::dealer);
+    sender.setsockopt(ZMQ_SNDHWM, REPLAY_SENDER_HWM);
+    sender.setsockopt(ZMQ_LINGER, REPLAY_SENDER_LINGER);
+    sender.connect("tcp://" + host + ":5555");
+
+    std::vector<uint8_t> buffer;
+    size_t sent = 0;
+    TrafficRecord record;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while(log.next(record)) {
+        if(record.direction != TrafficDirection::INBOUND) {
+            continue;
+        }
+        waitForMessage(speed, record, start, buffer);
+        sender.send(zmq::buffer(record.data, record.size), zmq::send_flags::none);
+        sent++;
+    }
+    return sent;
+}
+
+/**
+ * @brief Publish every snapshot the server sent to one client, in place of the server. Start the
+ * client with the same name once the replay is waiting for it.
+ *
+ * @param log recording to play
+ * @param speed how fast to play it
+ * @param clientName name of the recorded client whose snapshots are played
+ * @return size_t number of messages sent
+ */
+size_t replayToClient(TrafficLogReader& log, ReplaySpeed speed, const std::string& clientName) {
+    zmq::context_t context(1);
+    zmq::socket_t publisher(context, zmq::socket_type::pub);
+    publisher.bind("tcp://*:5556");
+    std::string topic = getClientTopic(clientName);
+
+    // Subscribers that connect late miss the first snapshots, wait for the client to be started
+    std::cout << "Start client " << clientName << " and press enter to play\n";
+    std::string line;
+    std::getline(std::cin, line);
+
+    std::vector<uint8_t> buffer;
+    size_t sent = 0;
+    TrafficRecord record;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while(log.next(record)) {
+        if(record.direction != TrafficDirection::OUTBOUND || record.topicSize != topic.size() || std::memcmp(record.topic, topic.data(), topic.size()) != 0) {
+            continue;
+        }
+        waitForMessage(speed, record, start, buffer);
+        publisher.send(zmq::buffer(topic), zmq::send_flags::sndmore);
+        publisher.send(zmq::buffer(record.data, record.size), zmq::send_flags::none);
+        sent++;
+    }
+    return sent;
+}
+
+/**
+ * @brief Read every message in the recording with the snapshot reader and report how long it takes,
+ * to compare parser changes against real traffic
+ *
+ * @param log recording to read
+ */
+void measureParsing(TrafficLogReader& log) {
+    std::vector<uint8_t> buffer;
+    TrafficRecord record;
+    size_t messages = 0;
+    size_t inbound = 0;
+    size_t invalid = 0;
+    size_t bytes = 0;
+    size_t records = 0;
+    while(log.next(record)) {
+        MessageSummary summary = readMessage(record, buffer);
+        messages++;
+        bytes += record.size;
+        records += summary.recordCount;
+        inbound += record.direction == TrafficDirection::INBOUND ? 1 : 0;
+        invalid += summary.valid ? 0 : 1;
+    }
+    if(messages == 0) {
+        std::cout << "The recording is empty\n";
+        return;
+    }
+
+    auto parseStart = std::chrono::steady_clock::now();
+    for(int pass = 0; pass < REPLAY_PARSE_PASSES; pass++) {
+        log.rewind();
+        while(log.next(record)) {
+            readMessage(record, buffer);
+        }
+    }
+    double parseUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - parseStart).count() / REPLAY_PARSE_PASSES;
+
+    std::cout << messages << " messages (" << inbound << " received, " << messages - inbound << " published, "
+              << invalid << " invalid), " << bytes << " bytes, " << records << " records\n"
+              << std::fixed << std::setprecision(3) << "Parsed in " << parseUs / 1000.0 << " ms, "
+              << parseUs / messages << " us a message, " << bytes / parseUs << " MB/s\n";
+}
+
+/**
+ * @brief Play back a traffic log recorded with the server's record mode
+ *
+ * @param argc number of arguments
+ * @param argv mode (server, client or parse), log file, speed (1x, max or step) and the server's host or
+ * the client's name
+ * @return int exit code
+ */
+int main(int argc, char** argv) {
+    if(argc < 3) {
+        std::cout << "Usage: ./main server <log> [1x|max|step] [host]\n"
+                  << "       ./main client <log> [1x|max|step] [client name]\n"
+                  << "       ./main parse <log>\n";
+        return 1;
+    }
+    std::string mode = argv[1];
+    std::string speedName = argc > 3 ? argv[3] : "1x";
+
+    TrafficLogReader log;
+    if(!log.open(argv[2])) {
+        std::cout << "Could not read " << argv[2] << " as a traffic log\n";
+        return 1;
+    }
+
+    ReplaySpeed speed = ReplaySpeed::REALTIME;
+    if(speedName == "max") {
+        speed = ReplaySpeed::MAX;
+    }
+    else if(speedName == "step") {
+        speed = ReplaySpeed::STEP;
+    }
+    else if(speedName != "1x") {
+        std::cout << "Unknown speed " << speedName << ", expected 1x, max or step\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t sent = 0;
+    if(mode == "server") {
+        sent = replayToServer(log, speed, argc > 4 ? argv[4] : "localhost");
+    }
+    else if(mode == "client") {
+        sent = replayToClient(log, speed, argc > 4 ? argv[4] : "One");
+    }
+    else if(mode == "parse") {
+        measureParsing(log);
+        return 0;
+    }
+    else {
+        std::cout << "Unknown mode " << mode << ", expected server, client or parse\n";
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Replayed " << sent << " messages in " << std::fixed << std::setprecision(2) << seconds << " s\n";
+    return 0; // Return on end
+}
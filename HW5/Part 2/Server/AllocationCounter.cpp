@@ -0,0 +1,90 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+static thread_local uint64_t threadAllocations = 0; // Allocations made by the current thread
+
+/**
+ * @brief Get the number of heap allocations the calling thread has made so far
+ *
+ * @return uint64_t number of allocations
+ */
+uint64_t getThreadAllocations() {
+    return threadAllocations;
+}
+
+#if defined(__GLIBC__)
+
+// glibc's own allocator, still reachable under these names once malloc is replaced
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* memory, size_t size);
+
+// Defining malloc in the server replaces it for every library loaded with it, libzmq included, and new
+// goes through malloc too, so counting here catches every allocation
+extern "C" void* malloc(size_t size) {
+    threadAllocations++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+    threadAllocations++;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* memory, size_t size) {
+    threadAllocations++;
+    return __libc_realloc(memory, size);
+}
+
+#else
+
+/**
+ * @brief Allocate memory and count the allocation
+ *
+ * @param size bytes to allocate
+ * @return void* allocated memory, nullptr if there is none left
+ */
+static void* countedAllocate(std::size_t size) {
+    threadAllocations++;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(std::size_t size) {
+    void* memory = countedAllocate(size);
+    if(!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+#endif
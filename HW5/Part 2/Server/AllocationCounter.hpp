@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * The server counts the heap allocations each thread makes. With glibc it replaces malloc, calloc and realloc,
+ * which catches new as well as the memory libzmq gets for every message it sends. Elsewhere only the global
+ * operator new is replaced, so memory libzmq gets straight from malloc is not counted.
+ */
+
+/**
+ * @brief Get the number of heap allocations the calling thread has made so far
+ *
+ * @return uint64_t number of allocations
+ */
+uint64_t getThreadAllocations();
@@ -0,0 +1,93 @@
+#include "BoxCollider.hpp"
+
+/**
+ * @brief Construct a new Box Collider object
+ *
+ * @param x x position
+ * @param y y position
+ * @param width width of the box
+ * @param height height of the box
+ */
+BoxCollider::BoxCollider(float x, float y, float width, float height) {
+    this->position = sf::Vector2f(x, y);
+    this->size = sf::Vector2f(width, height);
+}
+
+/**
+ * @brief Set the position of the box
+ *
+ * @param x x position
+ * @param y y position
+ */
+void BoxCollider::setPosition(float x, float y) {
+    this->position = sf::Vector2f(x, y);
+    updateCollisionBounds();
+}
+
+/**
+ * @brief Set the size of the box
+ *
+ * @param size width and height of the box
+ */
+void BoxCollider::setSize(sf::Vector2f size) {
+    this->size = size;
+    updateCollisionBounds();
+}
+
+/**
+ * @brief Get the size of the box
+ *
+ * @return sf::Vector2f width and height of the box
+ */
+sf::Vector2f BoxCollider::getSize() const {
+    return this->size;
+}
+
+/**
+ * @brief Get the Global Bounds object
+ *
+ * @return sf::FloatRect global bounds of the object.
+ */
+sf::FloatRect BoxCollider::getGlobalBounds() const {
+    return sf::FloatRect(this->position, this->size);
+}
+
+/**
+ * @brief Override of the move function.
+ *
+ * @param xOffset amount to move in the x direction.
+ * @param yOffset amount to move in the y direction.
+ */
+void BoxCollider::move(float xOffset, float yOffset) {
+    this->position.x += xOffset;
+    this->position.y += yOffset;
+    updateCollisionBounds();
+}
+
+/**
+ * @brief Override of the move function.
+ *
+ * @param offset amount to move given a float 2D vector.
+ */
+void BoxCollider::move(sf::Vector2f offset) {
+    this->position += offset;
+    updateCollisionBounds();
+}
+
+/**
+ * @brief Override of the getPosition function.
+ *
+ * @return sf::Vector2f position of the object
+ */
+sf::Vector2f BoxCollider::getPosition() {
+    return this->position;
+}
+
+/**
+ * @brief Get the Movement of an object, boxes that don't move on their own never have any
+ *
+ * @return sf::Vector2f total movement of the object in that frame
+ */
+sf::Vector2f BoxCollider::getMovement() {
+    return sf::Vector2f(0.f, 0.f);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Collider.hpp"
+
+/**
+ * @brief Collider that is only an axis aligned box, the headless stand in for the SFML shapes and sprites the
+ * client draws. Holds nothing but its position and size, so the server never loads a texture or links the
+ * graphics library. Every change to either is passed on to the collider store.
+ */
+class BoxCollider : public Collider {
+    public:
+        /**
+         * @brief Construct a new Box Collider object
+         *
+         * @param x x position
+         * @param y y position
+         * @param width width of the box
+         * @param height height of the box
+         */
+        BoxCollider(float x, float y, float width, float height);
+
+        /**
+         * @brief Set the position of the box
+         *
+         * @param x x position
+         * @param y y position
+         */
+        void setPosition(float x, float y);
+
+        /**
+         * @brief Set the size of the box
+         *
+         * @param size width and height of the box
+         */
+        void setSize(sf::Vector2f size);
+
+        /**
+         * @brief Get the size of the box
+         *
+         * @return sf::Vector2f width and height of the box
+         */
+        sf::Vector2f getSize() const;
+
+        /**
+         * @brief Get the Global Bounds object
+         *
+         * @return sf::FloatRect global bounds of the object.
+         */
+        sf::FloatRect getGlobalBounds() const override;
+
+        /**
+         * @brief Override of the move function.
+         *
+         * @param xOffset amount to move in the x direction.
+         * @param yOffset amount to move in the y direction.
+         */
+        void move(float xOffset, float yOffset) override;
+
+        /**
+         * @brief Override of the move function.
+         *
+         * @param offset amount to move given a float 2D vector.
+         */
+        void move(sf::Vector2f offset) override;
+
+        /**
+         * @brief Override of the getPosition function.
+         *
+         * @return sf::Vector2f position of the object
+         */
+        sf::Vector2f getPosition() override;
+
+        /**
+         * @brief Get the Movement of an object, boxes that don't move on their own never have any
+         *
+         * @return sf::Vector2f total movement of the object in that frame
+         */
+        sf::Vector2f getMovement() override;
+
+    private:
+        sf::Vector2f position; // Top left corner of the box
+        sf::Vector2f size; // Width and height of the box
+};
@@ -0,0 +1,126 @@
+#include "ClientUpdateQueue.hpp"
+
+/**
+ * @brief Decode a client state message into an update
+ *
+ * @param reader client state message
+ * @param update update to fill in
+ * @return bool false if the message doesn't start with the client's player
+ */
+bool readClientUpdate(SnapshotReader reader, ClientUpdate& update) {
+    SnapshotRecordView record;
+    if(!reader.nextRecord(record) || record.getType() != SnapshotRecordType::PLAYER) {
+        return false;
+    }
+    std::memcpy(update.name, record.getNameData(), SNAPSHOT_NAME_LENGTH);
+    update.isActive = record.isActive();
+    update.x = record.getX();
+    update.y = record.getY();
+    update.ackedTick = reader.getTick();
+    update.timestamp = reader.getTimestamp();
+    update.eventAck = 0;
+    update.capabilities = 0;
+    update.messageSize = 0;
+    update.hasView = false;
+    update.inputCount = 0;
+    update.shotCount = 0;
+
+    while(reader.nextRecord(record)) {
+        if(record.getType() == SnapshotRecordType::VIEW && record.hasField(FIELD_SIZE)) {
+            update.hasView = true;
+            update.viewLeft = record.getX();
+            update.viewTop = record.getY();
+            update.viewWidth = record.getWidth();
+            update.viewHeight = record.getHeight();
+        }
+        else if(record.getType() == SnapshotRecordType::INPUT && update.inputCount < INPUT_SEND_MAX) {
+            InputCommand& input = update.inputs[update.inputCount++];
+            input.sequence = record.getSequence();
+            input.keys = unpackKeys(record.getFlags());
+            input.elapsed = record.getX();
+        }
+        else if(record.getType() == SnapshotRecordType::EVENT_ACK) {
+            update.eventAck = record.getSequence();
+        }
+        else if(record.getType() == SnapshotRecordType::CAPABILITIES) {
+            update.capabilities = record.getFlags();
+        }
+        else if(record.getType() == SnapshotRecordType::SHOT && record.hasField(FIELD_SIZE) && update.shotCount < SHOT_READ_MAX) {
+            ShotReport& shot = update.shots[update.shotCount++];
+            shot.targetId = record.getId();
+            shot.bounds = sf::FloatRect(record.getX(), record.getY(), record.getWidth(), record.getHeight());
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Construct a new Client Update Queue object
+ *
+ * @param capacity number of updates that can be queued, rounded up to a power of two
+ */
+ClientUpdateQueue::ClientUpdateQueue(size_t capacity) {
+    size_t size = 2;
+    while(size < capacity) {
+        size *= 2;
+    }
+    this->slots.reset(new Slot[size]);
+    this->mask = size - 1;
+    for(size_t i = 0; i < size; i++) {
+        this->slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    this->pushPosition.store(0, std::memory_order_relaxed);
+    this->popPosition.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Queue an update, safe to call from any number of threads at once
+ *
+ * @param update update to queue
+ * @return bool false if the queue is full and the update was dropped
+ */
+bool ClientUpdateQueue::push(const ClientUpdate& update) {
+    size_t position = this->pushPosition.load(std::memory_order_relaxed);
+    Slot* slot;
+    while(true) {
+        slot = &this->slots[position & this->mask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if(difference == 0) {
+            // Slot is free at this position, claim it unless another producer got there first
+            if(this->pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if(difference < 0) {
+            // Still holds an update from a lap ago, the queue is full
+            return false;
+        }
+        else {
+            position = this->pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->update = update;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Take the oldest update, only ever call from the tick thread
+ *
+ * @param update filled with the oldest update
+ * @return bool false if the queue is empty
+ */
+bool ClientUpdateQueue::pop(ClientUpdate& update) {
+    size_t position = this->popPosition.load(std::memory_order_relaxed);
+    Slot& slot = this->slots[position & this->mask];
+    if(slot.sequence.load(std::memory_order_acquire) != position + 1) {
+        return false;
+    }
+
+    update = slot.update;
+    this->popPosition.store(position + 1, std::memory_order_relaxed);
+    slot.sequence.store(position + this->mask + 1, std::memory_order_release); // Free for the next lap
+    return true;
+}
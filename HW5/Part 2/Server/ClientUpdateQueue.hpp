@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+
+#include "Snapshot.hpp"
+#include "InputHistory.hpp"
+
+const size_t CLIENT_UPDATE_QUEUE_SIZE = 1024; // Updates that can wait for the tick thread, must be a power of two
+const size_t SHOT_READ_MAX = 8; // Most shots read from a single client message, the rest are ignored
+
+/**
+ * @brief A projectile a client saw hit a replicated entity
+ */
+struct ShotReport {
+    uint16_t targetId; // Network id of the entity hit
+    sf::FloatRect bounds; // Bounds of the projectile when it hit
+};
+
+/**
+ * @brief Everything the server needs from one client message, decoded on the receive thread so the tick
+ * thread never touches the message itself. Fixed size so queueing it never allocates.
+ */
+struct ClientUpdate {
+    char name[SNAPSHOT_NAME_LENGTH]; // Zero padded name of the client
+    bool isActive; // Whether the client is still playing
+    float x; // X position the client has its player at
+    float y; // Y position the client has its player at
+    uint32_t ackedTick; // Last snapshot tick the client received
+    uint32_t timestamp; // Time the client sent the message
+    uint32_t eventAck; // Last event the client has received in order
+    uint8_t capabilities; // CAPABILITY_ bits the client listed, 0 if it listed none
+    uint32_t messageSize; // Size of the message the update was decoded from, set by the receive thread
+    bool hasView; // Whether the message has the client's view
+    float viewLeft; // Left of the client's view
+    float viewTop; // Top of the client's view
+    float viewWidth; // Width of the client's view
+    float viewHeight; // Height of the client's view
+    size_t inputCount; // Number of inputs in the message
+    InputCommand inputs[INPUT_SEND_MAX]; // Unacknowledged inputs of the client, oldest first
+    size_t shotCount; // Number of shots in the message
+    ShotReport shots[SHOT_READ_MAX]; // Shots the client fired since its last message
+};
+
+/**
+ * @brief Decode a client state message into an update
+ *
+ * @param reader client state message
+ * @param update update to fill in
+ * @return bool false if the message doesn't start with the client's player
+ */
+bool readClientUpdate(SnapshotReader reader, ClientUpdate& update);
+
+/**
+ * @brief Bounded lock-free queue of client updates from any number of receive threads to the tick thread.
+ * Each slot has a sequence number saying whose turn it is, so producers only contend on one counter
+ * and never wait on each other or the consumer.
+ */
+class ClientUpdateQueue {
+    public:
+        /**
+         * @brief Construct a new Client Update Queue object
+         *
+         * @param capacity number of updates that can be queued, rounded up to a power of two
+         */
+        ClientUpdateQueue(size_t capacity);
+
+        /**
+         * @brief Queue an update, safe to call from any number of threads at once
+         *
+         * @param update update to queue
+         * @return bool false if the queue is full and the update was dropped
+         */
+        bool push(const ClientUpdate& update);
+
+        /**
+         * @brief Take the oldest update, only ever call from the tick thread
+         *
+         * @param update filled with the oldest update
+         * @return bool false if the queue is empty
+         */
+        bool pop(ClientUpdate& update);
+
+    private:
+        /**
+         * @brief Slot of the queue
+         */
+        struct Slot {
+            std::atomic<size_t> sequence; // Position the slot can next be written at, or that plus one once it is written
+            ClientUpdate update; // Queued update
+        };
+
+        std::unique_ptr<Slot[]> slots; // Ring of slots
+        size_t mask; // Capacity minus one, turns a position into a slot index
+        alignas(64) std::atomic<size_t> pushPosition; // Position the next update is pushed at
+        alignas(64) std::atomic<size_t> popPosition; // Position the next update is popped from, only the tick thread touches it
+};
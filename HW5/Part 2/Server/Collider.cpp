@@ -1,12 +1,24 @@
 #include "Collider.hpp"
 
-// Global List containing all collionable objects
-std::vector<Collider*> collisionObjects;
+// Bounds of every collider with collision enabled, the only copy collision checks read
+ColliderStore colliderStore;
 
 /**
- * @brief Destroy the Collider object
+ * @brief Construct a new Collider object with collision disabled
  */
-Collider::~Collider() {}
+Collider::Collider() {
+    collisionEnabled = false;
+    storeHandle = COLLIDER_STORE_NO_HANDLE;
+}
+
+/**
+ * @brief Destroy the Collider object, removing it from the collider store
+ */
+Collider::~Collider() {
+    if(storeHandle != COLLIDER_STORE_NO_HANDLE) {
+        setCollisionEnabled(false);
+    }
+}
 
 /**
  * @brief Set Collision to be enabled or disabled
@@ -16,13 +28,14 @@ Collider::~Collider() {}
 void Collider::setCollisionEnabled(bool enabled) {
     collisionEnabled = enabled;
     if(enabled) {
-        collisionObjects.push_back(this);
+        if(storeHandle == COLLIDER_STORE_NO_HANDLE) {
+            storeHandle = colliderStore.add(this, getGlobalBounds());
+        }
     }
     else {
-        // Remove from the global list
-        auto toRemove = std::find(collisionObjects.begin(), collisionObjects.end(), this);
-        if(toRemove != collisionObjects.end()) {
-            collisionObjects.erase(toRemove);
+        if(storeHandle != COLLIDER_STORE_NO_HANDLE) {
+            colliderStore.remove(storeHandle);
+            storeHandle = COLLIDER_STORE_NO_HANDLE;
         }
     }
 }
@@ -37,26 +50,53 @@ bool Collider::getCollisionEnabled() {
 }
 
 /**
- * @brief Checks if the object collides with any other with collision on. It will resolve the object 
- * collision if needed.
+ * @brief Update the bounds the collider store has for the object. Called whenever it moves.
+ */
+void Collider::updateCollisionBounds() {
+    if(storeHandle != COLLIDER_STORE_NO_HANDLE) {
+        // Setters call this even when nothing changed, the store only flags real moves
+        colliderStore.update(storeHandle, getGlobalBounds());
+    }
+}
+
+/**
+ * @brief Get the bounds collision checks use, the ones last given to the collider store. Colliders with
+ * collision disabled aren't in the store and get their global bounds instead.
+ * 
+ * @return sf::FloatRect bounds of the object
+ */
+sf::FloatRect Collider::getCollisionBounds() const {
+    if(storeHandle != COLLIDER_STORE_NO_HANDLE) {
+        return colliderStore.getBounds(storeHandle);
+    }
+    return getGlobalBounds();
+}
+
+/**
+ * @brief Check whether the bounds of the object changed since the collider store's moved flags were last
+ * cleared. Always true for colliders with collision disabled, nothing tracks them.
+ * 
+ * @return bool whether the object may have moved
+ */
+bool Collider::hasCollisionMoved() const {
+    if(storeHandle != COLLIDER_STORE_NO_HANDLE) {
+        return colliderStore.getFlags(storeHandle) & COLLIDER_FLAG_MOVED;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if the object collides with any other with collision on, scanning the bounds in the
+ * collider store. It will resolve the object collision if needed.
  * 
  * @return bool of whether the collide object collides with any object in the collideableObjects list.
  */
 bool Collider::checkCollision() {
     if(collisionEnabled) {
-        sf::FloatRect checkBounds = getGlobalBounds();
-
-        for(Collider* collideable : collisionObjects) {
-            if(collideable == this) {
-                continue;
-            }
-
-            sf::FloatRect collideableBounds = collideable->getGlobalBounds();
-
-            if(checkBounds.intersects(collideableBounds)) {
-                resolveCollision(*this, *collideable);
-                return true;
-            }
+        Collider* collideable = colliderStore.findOverlap(getCollisionBounds(), this);
+        if(collideable) {
+            resolveCollision(*this, *collideable);
+            return true;
         }
     }
     return false;
@@ -70,7 +110,7 @@ bool Collider::checkCollision() {
  */
 bool Collider::checkCollision(sf::FloatRect objectToCheck) {
     if(collisionEnabled) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
         if(checkBounds.intersects(objectToCheck)) {
             return true;
@@ -85,11 +125,11 @@ bool Collider::checkCollision(sf::FloatRect objectToCheck) {
  * @param std::vector<sf::FloatRect> bounds to check for collision
  * @return bool of whether the collide object collides with the object.
  */
-bool Collider::checkCollision(std::vector<sf::FloatRect> objectsToCheck) {
+bool Collider::checkCollision(const std::vector<sf::FloatRect>& objectsToCheck) {
     if(collisionEnabled) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
-        for(sf::FloatRect bounds : objectsToCheck) {
+        for(const sf::FloatRect& bounds : objectsToCheck) {
             if(checkBounds.intersects(bounds)) {
                 return true;
             }
@@ -106,8 +146,8 @@ bool Collider::checkCollision(std::vector<sf::FloatRect> objectsToCheck) {
  * @param colliderTwo Object being collided with.
  */
 void Collider::resolveCollision(Collider& colliderOne, Collider& colliderTwo) {
-    sf::FloatRect boundsOne = colliderOne.getGlobalBounds();
-    sf::FloatRect boundsTwo = colliderTwo.getGlobalBounds();
+    sf::FloatRect boundsOne = colliderOne.getCollisionBounds();
+    sf::FloatRect boundsTwo = colliderTwo.getCollisionBounds();
 
     // Find how much is being intersected in each direction.
     float intersectingX = std::min(boundsOne.left + boundsOne.width, boundsTwo.left + boundsTwo.width) - std::max(boundsOne.left, boundsTwo.left);
@@ -1,5 +1,13 @@
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <vector>
+#include <algorithm>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "ColliderStore.hpp"
+
+// Bounds of every collider with collision enabled, the only copy collision checks read
+extern ColliderStore colliderStore;
 
 /**
  * @brief Class for the interface of a collider
@@ -7,7 +15,12 @@
 class Collider {
     public:
         /**
-         * @brief Destroy the Collider object
+         * @brief Construct a new Collider object with collision disabled
+         */
+        Collider();
+
+        /**
+         * @brief Destroy the Collider object, removing it from the collider store
          */
         virtual ~Collider();
 
@@ -26,8 +39,29 @@ class Collider {
         bool getCollisionEnabled();
 
         /**
-         * @brief Checks if the object collides with any other with collision on. It will resolve the object 
-         * collision if needed.
+         * @brief Update the bounds the collider store has for the object. Called whenever it moves.
+         */
+        void updateCollisionBounds();
+
+        /**
+         * @brief Get the bounds collision checks use, the ones last given to the collider store. Colliders
+         * with collision disabled aren't in the store and get their global bounds instead.
+         * 
+         * @return sf::FloatRect bounds of the object
+         */
+        sf::FloatRect getCollisionBounds() const;
+
+        /**
+         * @brief Check whether the bounds of the object changed since the collider store's moved flags were
+         * last cleared. Always true for colliders with collision disabled, nothing tracks them.
+         * 
+         * @return bool whether the object may have moved
+         */
+        bool hasCollisionMoved() const;
+
+        /**
+         * @brief Checks if the object collides with any other with collision on, scanning the bounds in the
+         * collider store. It will resolve the object collision if needed.
          * 
          * @return bool of whether the collide object collides with any object in the collideableObjects list.
          */
@@ -47,7 +81,7 @@ class Collider {
          * @param std::vector<Collider*> collideable objects to check for collision
          * @return bool of whether the collide object collides with the object.
          */
-        bool checkCollision(std::vector<sf::FloatRect> objectsToCheck);
+        bool checkCollision(const std::vector<sf::FloatRect>& objectsToCheck);
 
         /**
          * @brief Resolves a collision by taking an object and what it collides with and moving it back outside 
@@ -96,4 +130,5 @@ class Collider {
 
     private:
         bool collisionEnabled; // Whether the object has collision enabled
+        uint32_t storeHandle; // Handle of the object in the collider store, COLLIDER_STORE_NO_HANDLE when not in it
 };
\ No newline at end of file
@@ -2,6 +2,12 @@
 
 class Player;
 
+// Only carried as pointers, the server never creates or links either
+namespace sf {
+    class RenderWindow;
+    class View;
+}
+
 #include <iostream>
 #include <map>
 #include "Player.hpp"
@@ -15,6 +21,7 @@ struct PlayerClient {
     std::string name;
     Player* player;
     bool isActive;
+    uint16_t networkId; // Id the player is replicated under, 0 until the server gives it one
 };
 
 /**
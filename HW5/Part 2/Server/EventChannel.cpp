@@ -0,0 +1,115 @@
+#include "EventChannel.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Construct a new Event Sender object that can hold EVENT_CHANNEL_SIZE unacknowledged events
+ */
+EventSender::EventSender() {
+    this->events.resize(EVENT_CHANNEL_SIZE);
+    reset();
+}
+
+/**
+ * @brief Forget every event and start again from sequence number 1, keeping the allocated memory
+ */
+void EventSender::reset() {
+    this->first = 0;
+    this->count = 0;
+    this->nextSequence = 1;
+}
+
+/**
+ * @brief Queue an event to be sent until it is acknowledged
+ *
+ * @param type type of the event
+ * @param name name the event is about
+ * @return bool false if the channel is full because the receiver stopped acknowledging
+ */
+bool EventSender::push(SnapshotEventType type, const std::string& name) {
+    if(isFull()) {
+        return false;
+    }
+
+    ReliableEvent& event = this->events[(this->first + this->count) % this->events.size()];
+    event.sequence = this->nextSequence++;
+    event.type = type;
+    std::memset(event.name, 0, SNAPSHOT_NAME_LENGTH);
+    std::memcpy(event.name, name.data(), std::min(name.size(), SNAPSHOT_NAME_LENGTH));
+    this->count++;
+    return true;
+}
+
+/**
+ * @brief Stop sending every event up to a sequence number
+ *
+ * @param sequence sequence number of the last event the receiver got in order
+ */
+void EventSender::acknowledge(uint32_t sequence) {
+    while(this->count > 0 && this->events[this->first].sequence <= sequence) {
+        this->first = (this->first + 1) % this->events.size();
+        this->count--;
+    }
+}
+
+/**
+ * @brief Write every unacknowledged event into a message
+ *
+ * @param writer message being written
+ */
+void EventSender::write(SnapshotWriter& writer) const {
+    for(size_t i = 0; i < this->count; i++) {
+        const ReliableEvent& event = this->events[(this->first + i) % this->events.size()];
+        writer.addEvent(event.sequence, event.type, event.name, SNAPSHOT_NAME_LENGTH);
+    }
+}
+
+/**
+ * @brief Check if the channel can't take another event
+ *
+ * @return bool whether the channel is full
+ */
+bool EventSender::isFull() const {
+    return this->count == this->events.size();
+}
+
+/**
+ * @brief Get the number of events waiting to be acknowledged
+ *
+ * @return size_t number of events
+ */
+size_t EventSender::size() const {
+    return this->count;
+}
+
+/**
+ * @brief Construct a new Event Receiver object
+ */
+EventReceiver::EventReceiver() {
+    this->lastSequence = 0;
+}
+
+/**
+ * @brief Check a received event record
+ *
+ * @param record event record from the sender
+ * @return bool true if the event is the next one in order and should be handled, false if it has
+ * been handled already
+ */
+bool EventReceiver::receive(const SnapshotRecordView& record) {
+    // Events are always resent oldest first, so anything but the next one has been handled already
+    if(!record.hasField(FIELD_SEQUENCE) || record.getSequence() != this->lastSequence + 1) {
+        return false;
+    }
+    this->lastSequence++;
+    return true;
+}
+
+/**
+ * @brief Get the sequence number to acknowledge
+ *
+ * @return uint32_t sequence number of the last event handled, 0 if none
+ */
+uint32_t EventReceiver::getLastSequence() const {
+    return this->lastSequence;
+}
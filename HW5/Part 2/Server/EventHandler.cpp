@@ -53,17 +53,11 @@ EventSpawnHandler::EventSpawnHandler(EventManager* manager, Event* event) : Even
 
 void EventSpawnHandler::onEvent() {
     Player* player = static_cast<Player*>(this->event->getVarient(ParamType::CHAR_POINTER).getValue());
-    sf::RenderWindow* window = static_cast<sf::RenderWindow*>(this->event->getVarient(ParamType::WINDOW).getValue());
-    sf::View* camera = static_cast<sf::View*>(this->event->getVarient(ParamType::CAMERA).getValue());
-    SideScrollArea* leftScrollArea = static_cast<SideScrollArea*>(this->event->getVarient(ParamType::LEFT_SIDE_SCROLL).getValue());
-    SideScrollArea* rightScrollArea = static_cast<SideScrollArea*>(this->event->getVarient(ParamType::RIGHT_SIDE_SCROLL).getValue());
     double xPos = *static_cast<double*>(this->event->getVarient(ParamType::X_POS).getValue());
     double yPos = *static_cast<double*>(this->event->getVarient(ParamType::Y_POS).getValue());
 
+    // The server has no window, camera or scroll areas to move, clients recenter their own when the snapshot arrives
     player->setPosition(xPos, yPos);
-    camera->setCenter(window->getDefaultView().getCenter());
-    leftScrollArea->setPosition(window->getView().getViewport().left, 0.f);
-    rightScrollArea->setPosition(window->getView().getViewport().left + window->getDefaultView().getSize().x - rightScrollArea->getLocalBounds().width, 0.f);
 }
 
 void EventSpawnHandler::setEventType(EventType e) {
@@ -96,6 +90,9 @@ void EventDeathHandler::onEvent() {
     SideScrollArea* rightScrollArea = static_cast<SideScrollArea*>(this->event->getVarient(ParamType::RIGHT_SIDE_SCROLL).getValue());
 
     std::vector<SpawnPoint*>* spawnPoints = static_cast<std::vector<SpawnPoint*>*>(this->event->getVarient(ParamType::SPAWN_POINTS).getValue());
+    if(spawnPoints->empty()) {
+        return;
+    }
     srand(time(NULL));
     int randomIndex = rand() % spawnPoints->size();
     sf::Vector2f chosenSpawnPoint = spawnPoints->at(randomIndex)->getSpawnPointLocation();
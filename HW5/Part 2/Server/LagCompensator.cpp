@@ -0,0 +1,141 @@
+#include "LagCompensator.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Construct a new Lag Compensator object
+ */
+LagCompensator::LagCompensator() {
+    this->tickTimes.resize(LAG_HISTORY_SIZE, 0.0);
+    this->currentTick = 0;
+    this->tickCount = 0;
+}
+
+/**
+ * @brief Start recording a simulation tick, record every entity's bounds after calling this
+ *
+ * @param tick simulation tick number
+ * @param time server time of the tick in seconds
+ */
+void LagCompensator::beginTick(uint32_t tick, double time) {
+    this->currentTick = tick;
+    this->tickTimes[tick % LAG_HISTORY_SIZE] = time;
+    this->tickCount = std::min(this->tickCount + 1, LAG_HISTORY_SIZE);
+}
+
+/**
+ * @brief Record the bounds of an entity at the current tick
+ *
+ * @param id network id of the entity
+ * @param bounds collider bounds of the entity
+ */
+void LagCompensator::record(uint16_t id, const sf::FloatRect& bounds) {
+    if(id >= this->entities.size()) {
+        this->entities.resize(id + 1);
+    }
+    std::vector<LagSample>& samples = this->entities[id];
+    if(samples.empty()) {
+        // First time the id is seen, every sample starts out stale
+        samples.resize(LAG_HISTORY_SIZE, LagSample{this->currentTick + 1, sf::FloatRect()});
+    }
+    samples[this->currentTick % LAG_HISTORY_SIZE] = LagSample{this->currentTick, bounds};
+}
+
+/**
+ * @brief Get the time a client was seeing the world at when the message that just arrived from it was sent
+ *
+ * @param now current server time in seconds
+ * @param roundTripTime round trip time of the client in seconds
+ * @param interpolationDelay how far behind the server the client draws remote entities in seconds
+ * @return double server time to rewind to, never more than LAG_MAX_REWIND ago
+ */
+double LagCompensator::getRewindTime(double now, double roundTripTime, double interpolationDelay) const {
+    // The snapshot the client was drawing took half a round trip to arrive and the shot half a round
+    // trip to come back, and remote entities are drawn interpolationDelay behind that snapshot
+    double rewind = std::max(roundTripTime, 0.0) + std::max(interpolationDelay, 0.0);
+    return now - std::min(rewind, LAG_MAX_REWIND);
+}
+
+/**
+ * @brief Get the bounds an entity had at a tick
+ *
+ * @param id network id of the entity
+ * @param tick simulation tick
+ * @return const sf::FloatRect* bounds, nullptr if the entity wasn't recorded at that tick
+ */
+const sf::FloatRect* LagCompensator::getSample(uint16_t id, uint32_t tick) const {
+    if(id >= this->entities.size() || this->entities[id].empty()) {
+        return nullptr;
+    }
+    const LagSample& sample = this->entities[id][tick % LAG_HISTORY_SIZE];
+    return sample.tick == tick ? &sample.bounds : nullptr;
+}
+
+/**
+ * @brief Get the bounds an entity had at a time, interpolated between the two ticks around it
+ *
+ * @param id network id of the entity
+ * @param time server time in seconds
+ * @param bounds filled with the bounds of the entity
+ * @return bool false if the entity wasn't recorded around that time
+ */
+bool LagCompensator::getBoundsAt(uint16_t id, double time, sf::FloatRect& bounds) const {
+    if(this->tickCount == 0) {
+        return false;
+    }
+
+    // Walk back from the newest tick to the last one at or before the time, ticks aren't evenly
+    // spaced when the scheduler catches up
+    uint32_t after = this->currentTick;
+    for(size_t i = 1; i < this->tickCount; i++) {
+        uint32_t before = this->currentTick - static_cast<uint32_t>(i);
+        double beforeTime = this->tickTimes[before % LAG_HISTORY_SIZE];
+        if(beforeTime <= time) {
+            const sf::FloatRect* from = getSample(id, before);
+            const sf::FloatRect* to = getSample(id, after);
+            if(!from || !to) {
+                // Entity spawned or died between the two ticks, use whichever one it was at
+                const sf::FloatRect* only = from ? from : to;
+                if(!only) {
+                    return false;
+                }
+                bounds = *only;
+                return true;
+            }
+
+            double afterTime = this->tickTimes[after % LAG_HISTORY_SIZE];
+            float t = afterTime > beforeTime ? static_cast<float>((time - beforeTime) / (afterTime - beforeTime)) : 1.f;
+            t = std::min(std::max(t, 0.f), 1.f);
+            bounds.left = from->left + (to->left - from->left) * t;
+            bounds.top = from->top + (to->top - from->top) * t;
+            bounds.width = from->width + (to->width - from->width) * t;
+            bounds.height = from->height + (to->height - from->height) * t;
+            return true;
+        }
+        after = before;
+    }
+
+    // Older than the history, use the oldest bounds kept
+    const sf::FloatRect* oldest = getSample(id, after);
+    if(!oldest) {
+        return false;
+    }
+    bounds = *oldest;
+    return true;
+}
+
+/**
+ * @brief Check a shot against where an entity was at a time
+ *
+ * @param id network id of the entity shot at
+ * @param shot bounds of the projectile
+ * @param time server time the shooter was seeing
+ * @return bool whether the shot hit the entity
+ */
+bool LagCompensator::checkHit(uint16_t id, const sf::FloatRect& shot, double time) const {
+    sf::FloatRect bounds;
+    if(!getBoundsAt(id, time, bounds)) {
+        return false;
+    }
+    return bounds.intersects(shot);
+}
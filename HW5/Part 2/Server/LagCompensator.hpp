@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+
+const size_t LAG_HISTORY_SIZE = 64; // Simulation ticks of bounds kept for each entity, just over a second at 60 Hz
+const double LAG_MAX_REWIND = 0.5; // Furthest back in seconds a shot is checked, caps what a laggy or lying client gains
+
+/**
+ * @brief Bounds of an entity at a simulation tick
+ */
+struct LagSample {
+    uint32_t tick; // Simulation tick the bounds were recorded at
+    sf::FloatRect bounds; // Collider bounds of the entity
+};
+
+/**
+ * @brief Remembers where every replicated entity's collider was over the last LAG_HISTORY_SIZE simulation
+ * ticks, so a shot can be checked against the world as the shooter saw it instead of as it is now.
+ * Clients draw remote entities a round trip plus the interpolation delay in the past, so without
+ * rewinding a shot that hit on screen misses on the server.
+ */
+class LagCompensator {
+    public:
+        /**
+         * @brief Construct a new Lag Compensator object
+         */
+        LagCompensator();
+
+        /**
+         * @brief Start recording a simulation tick, record every entity's bounds after calling this
+         *
+         * @param tick simulation tick number
+         * @param time server time of the tick in seconds
+         */
+        void beginTick(uint32_t tick, double time);
+
+        /**
+         * @brief Record the bounds of an entity at the current tick
+         *
+         * @param id network id of the entity
+         * @param bounds collider bounds of the entity
+         */
+        void record(uint16_t id, const sf::FloatRect& bounds);
+
+        /**
+         * @brief Get the time a client was seeing the world at when the message that just arrived from it was sent
+         *
+         * @param now current server time in seconds
+         * @param roundTripTime round trip time of the client in seconds
+         * @param interpolationDelay how far behind the server the client draws remote entities in seconds
+         * @return double server time to rewind to, never more than LAG_MAX_REWIND ago
+         */
+        double getRewindTime(double now, double roundTripTime, double interpolationDelay) const;
+
+        /**
+         * @brief Get the bounds an entity had at a time, interpolated between the two ticks around it
+         *
+         * @param id network id of the entity
+         * @param time server time in seconds
+         * @param bounds filled with the bounds of the entity
+         * @return bool false if the entity wasn't recorded around that time
+         */
+        bool getBoundsAt(uint16_t id, double time, sf::FloatRect& bounds) const;
+
+        /**
+         * @brief Check a shot against where an entity was at a time
+         *
+         * @param id network id of the entity shot at
+         * @param shot bounds of the projectile
+         * @param time server time the shooter was seeing
+         * @return bool whether the shot hit the entity
+         */
+        bool checkHit(uint16_t id, const sf::FloatRect& shot, double time) const;
+
+    private:
+        /**
+         * @brief Get the bounds an entity had at a tick
+         *
+         * @param id network id of the entity
+         * @param tick simulation tick
+         * @return const sf::FloatRect* bounds, nullptr if the entity wasn't recorded at that tick
+         */
+        const sf::FloatRect* getSample(uint16_t id, uint32_t tick) const;
+
+        std::vector<std::vector<LagSample>> entities; // Ring of samples for each network id, a tick is stored at tick % size
+        std::vector<double> tickTimes; // Server time of each recent tick, a tick is stored at tick % size
+        uint32_t currentTick; // Tick being recorded
+        size_t tickCount; // Ticks recorded, stops counting at LAG_HISTORY_SIZE
+};
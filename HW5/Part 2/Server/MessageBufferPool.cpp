@@ -0,0 +1,66 @@
+#include "MessageBufferPool.hpp"
+
+/**
+ * @brief Construct a new Message Buffer Pool object
+ *
+ * @param count number of buffers to create up front
+ * @param capacity bytes to reserve in each buffer
+ */
+MessageBufferPool::MessageBufferPool(size_t count, size_t capacity) {
+    this->capacity = capacity;
+    this->initialCount = count;
+    this->buffers.reserve(count);
+    this->freeBuffers.reserve(count);
+    for(size_t i = 0; i < count; i++) {
+        std::unique_ptr<MessageBuffer> buffer(new MessageBuffer());
+        buffer->data.reserve(capacity);
+        buffer->pool = this;
+        this->freeBuffers.push_back(buffer.get());
+        this->buffers.push_back(std::move(buffer));
+    }
+}
+
+/**
+ * @brief Take a free buffer, creating one if every buffer is in flight
+ *
+ * @return MessageBuffer* buffer to encode a message into
+ */
+MessageBuffer* MessageBufferPool::acquire() {
+    std::lock_guard<std::mutex> lock(this->freeMutex);
+    if(!this->freeBuffers.empty()) {
+        MessageBuffer* buffer = this->freeBuffers.back();
+        this->freeBuffers.pop_back();
+        return buffer;
+    }
+
+    // Every buffer is still queued in ZeroMQ, a slow subscriber is holding them up
+    std::unique_ptr<MessageBuffer> buffer(new MessageBuffer());
+    buffer->data.reserve(this->capacity);
+    buffer->pool = this;
+    this->buffers.push_back(std::move(buffer));
+    this->freeBuffers.reserve(this->buffers.size());
+    return this->buffers.back().get();
+}
+
+/**
+ * @brief Give a buffer back to its pool. Has the signature of a zmq_free_fn, so it can be passed
+ * straight to zmq::message_t with the buffer as the hint.
+ *
+ * @param data message data, unused
+ * @param hint buffer to give back
+ */
+void MessageBufferPool::release(void* /* data */, void* hint) {
+    MessageBuffer* buffer = static_cast<MessageBuffer*>(hint);
+    MessageBufferPool* pool = buffer->pool;
+    std::lock_guard<std::mutex> lock(pool->freeMutex);
+    pool->freeBuffers.push_back(buffer); // Never allocates, there is room for every buffer
+}
+
+/**
+ * @brief Get the number of buffers the pool has had to create past its initial count
+ *
+ * @return size_t number of extra buffers
+ */
+size_t MessageBufferPool::getGrowth() const {
+    return this->buffers.size() - this->initialCount;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+const size_t MESSAGE_POOL_SIZE = 32; // Buffers created up front, more are only made if every one is in flight
+const size_t MESSAGE_BUFFER_CAPACITY = 16384; // Bytes reserved in each buffer, enough for a full snapshot of a few hundred entities
+
+class MessageBufferPool;
+
+/**
+ * @brief Buffer a message is encoded into and handed to ZeroMQ without copying it
+ */
+struct MessageBuffer {
+    std::vector<uint8_t> data; // Encoded message, its capacity is kept between messages
+    MessageBufferPool* pool; // Pool the buffer goes back to once ZeroMQ has sent it
+};
+
+/**
+ * @brief Reusable message buffers. A buffer is owned by ZeroMQ while its message is queued and comes back
+ * to the pool from ZeroMQ's I/O thread when it is done with it.
+ */
+class MessageBufferPool {
+    public:
+        /**
+         * @brief Construct a new Message Buffer Pool object
+         *
+         * @param count number of buffers to create up front
+         * @param capacity bytes to reserve in each buffer
+         */
+        MessageBufferPool(size_t count, size_t capacity);
+
+        /**
+         * @brief Take a free buffer, creating one if every buffer is in flight
+         *
+         * @return MessageBuffer* buffer to encode a message into
+         */
+        MessageBuffer* acquire();
+
+        /**
+         * @brief Give a buffer back to its pool. Has the signature of a zmq_free_fn, so it can be passed
+         * straight to zmq::message_t with the buffer as the hint.
+         *
+         * @param data message data, unused
+         * @param hint buffer to give back
+         */
+        static void release(void* data, void* hint);
+
+        /**
+         * @brief Get the number of buffers the pool has had to create past its initial count
+         *
+         * @return size_t number of extra buffers
+         */
+        size_t getGrowth() const;
+
+    private:
+        std::mutex freeMutex; // Guards the free list between the publishing and ZeroMQ I/O threads
+        std::vector<std::unique_ptr<MessageBuffer>> buffers; // Every buffer the pool owns
+        std::vector<MessageBuffer*> freeBuffers; // Buffers not in flight
+        size_t capacity; // Bytes reserved in each buffer
+        size_t initialCount; // Number of buffers created up front
+};
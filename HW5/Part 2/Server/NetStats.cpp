@@ -0,0 +1,234 @@
+#include "NetStats.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+/**
+ * @brief Get the bucket a value is counted in
+ *
+ * @param value value to count
+ * @return size_t index of its bucket
+ */
+static size_t getHistogramBucket(uint64_t value) {
+    if(value < 2 * HISTOGRAM_SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+    int exponent = 63;
+    while((value >> exponent) == 0) {
+        exponent--;
+    }
+    if(exponent >= HISTOGRAM_MAX_EXPONENT) {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+    // The two bits under the top bit pick the sub bucket
+    size_t subBucket = static_cast<size_t>((value >> (exponent - 2)) & (HISTOGRAM_SUB_BUCKETS - 1));
+    return 2 * HISTOGRAM_SUB_BUCKETS + (exponent - 3) * HISTOGRAM_SUB_BUCKETS + subBucket;
+}
+
+/**
+ * @brief Get the largest value a bucket counts
+ *
+ * @param bucket index of the bucket
+ * @return uint64_t largest value of the bucket
+ */
+static uint64_t getHistogramBucketTop(size_t bucket) {
+    if(bucket < 2 * HISTOGRAM_SUB_BUCKETS) {
+        return bucket;
+    }
+    if(bucket == HISTOGRAM_BUCKETS - 1) {
+        return UINT64_MAX;
+    }
+    size_t exponent = (bucket - 2 * HISTOGRAM_SUB_BUCKETS) / HISTOGRAM_SUB_BUCKETS + 3;
+    size_t subBucket = (bucket - 2 * HISTOGRAM_SUB_BUCKETS) % HISTOGRAM_SUB_BUCKETS;
+    return ((HISTOGRAM_SUB_BUCKETS + subBucket + 1) << (exponent - 2)) - 1;
+}
+
+/**
+ * @brief Construct an empty Histogram object
+ */
+Histogram::Histogram() {
+    reset();
+}
+
+/**
+ * @brief Count a value
+ *
+ * @param value value to count
+ */
+void Histogram::add(uint64_t value) {
+    this->buckets[getHistogramBucket(value)]++;
+    this->count++;
+    this->sum += value;
+    this->max = std::max(this->max, value);
+}
+
+/**
+ * @brief Forget every value
+ */
+void Histogram::reset() {
+    std::fill(this->buckets, this->buckets + HISTOGRAM_BUCKETS, 0);
+    this->count = 0;
+    this->sum = 0;
+    this->max = 0;
+}
+
+/**
+ * @brief Get the number of values counted
+ *
+ * @return uint64_t number of values
+ */
+uint64_t Histogram::getCount() const {
+    return this->count;
+}
+
+/**
+ * @brief Get the mean of the values counted
+ *
+ * @return double mean, 0 if there are none
+ */
+double Histogram::getMean() const {
+    return this->count == 0 ? 0.0 : static_cast<double>(this->sum) / this->count;
+}
+
+/**
+ * @brief Get the largest value counted
+ *
+ * @return uint64_t largest value, 0 if there are none
+ */
+uint64_t Histogram::getMax() const {
+    return this->max;
+}
+
+/**
+ * @brief Estimate a percentile of the values counted, as the top of the bucket it falls in
+ *
+ * @param percent percentile to get
+ * @return uint64_t upper bound of the percentile, never more than the largest value
+ */
+uint64_t Histogram::getPercentile(double percent) const {
+    if(this->count == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(this->count * percent / 100.0);
+    uint64_t seen = 0;
+    for(size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        seen += this->buckets[bucket];
+        if(seen > target) {
+            return std::min(this->max, getHistogramBucketTop(bucket));
+        }
+    }
+    return this->max;
+}
+
+/**
+ * @brief Write the histogram as a JSON object with its count, mean, max, percentiles and every
+ * bucket that isn't empty, as [largest value of the bucket, count] pairs
+ *
+ * @param out stream to write to
+ */
+void Histogram::writeJson(std::ostream& out) const {
+    out << "{\"count\":" << this->count << ",\"mean\":" << getMean() << ",\"max\":" << this->max
+        << ",\"p50\":" << getPercentile(50) << ",\"p95\":" << getPercentile(95) << ",\"p99\":" << getPercentile(99)
+        << ",\"buckets\":[";
+    bool first = true;
+    for(size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        if(this->buckets[bucket] == 0) {
+            continue;
+        }
+        out << (first ? "[" : ",[") << std::min(this->max, getHistogramBucketTop(bucket)) << "," << this->buckets[bucket] << "]";
+        first = false;
+    }
+    out << "]}";
+}
+
+/**
+ * @brief Clear every counter and rate
+ *
+ * @param stats stats to clear
+ */
+void resetConnectionStats(ConnectionStats& stats) {
+    stats = ConnectionStats{0, 0, 0, 0, 0, 0, 0, 0, 0.0, 0.0, 0.0, 0.0};
+}
+
+/**
+ * @brief Count a received message
+ *
+ * @param stats stats to count it in
+ * @param bytes size of the message
+ */
+void countInbound(ConnectionStats& stats, size_t bytes) {
+    stats.messagesIn++;
+    stats.bytesIn += bytes;
+    stats.windowMessagesIn++;
+    stats.windowBytesIn += bytes;
+}
+
+/**
+ * @brief Count a sent message
+ *
+ * @param stats stats to count it in
+ * @param bytes size of the message, including its topic
+ */
+void countOutbound(ConnectionStats& stats, size_t bytes) {
+    stats.messagesOut++;
+    stats.bytesOut += bytes;
+    stats.windowMessagesOut++;
+    stats.windowBytesOut += bytes;
+}
+
+/**
+ * @brief End the current window, turning its counts into rates
+ *
+ * @param stats stats to roll over
+ * @param seconds length of the window
+ */
+void rollConnectionStats(ConnectionStats& stats, double seconds) {
+    if(seconds <= 0.0) {
+        return;
+    }
+    stats.messagesInRate = stats.windowMessagesIn / seconds;
+    stats.bytesInRate = stats.windowBytesIn / seconds;
+    stats.messagesOutRate = stats.windowMessagesOut / seconds;
+    stats.bytesOutRate = stats.windowBytesOut / seconds;
+    stats.windowMessagesIn = 0;
+    stats.windowBytesIn = 0;
+    stats.windowMessagesOut = 0;
+    stats.windowBytesOut = 0;
+}
+
+/**
+ * @brief Write connection stats as the members of a JSON object, without the braces
+ *
+ * @param out stream to write to
+ * @param stats stats to write
+ */
+void writeConnectionStatsJson(std::ostream& out, const ConnectionStats& stats) {
+    out << "\"messagesIn\":" << stats.messagesIn << ",\"bytesIn\":" << stats.bytesIn
+        << ",\"messagesOut\":" << stats.messagesOut << ",\"bytesOut\":" << stats.bytesOut
+        << ",\"messagesInPerSecond\":" << stats.messagesInRate << ",\"bytesInPerSecond\":" << stats.bytesInRate
+        << ",\"messagesOutPerSecond\":" << stats.messagesOutRate << ",\"bytesOutPerSecond\":" << stats.bytesOutRate;
+}
+
+/**
+ * @brief Write a string as a JSON string, escaping anything that isn't printable
+ *
+ * @param out stream to write to
+ * @param value string to write
+ */
+void writeJsonString(std::ostream& out, const std::string& value) {
+    out << '"';
+    for(unsigned char c : value) {
+        if(c == '"' || c == '\\') {
+            out << '\\' << c;
+        }
+        else if(c < 0x20 || c >= 0x7F) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        }
+        else {
+            out << c;
+        }
+    }
+    out << '"';
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+const int HISTOGRAM_SUB_BUCKETS = 4; // Buckets each power of two is split into, so a bucket is at most 25% wide
+const int HISTOGRAM_MAX_EXPONENT = 40; // Values of 2^40 and up all share the last bucket
+const size_t HISTOGRAM_BUCKETS = 2 * HISTOGRAM_SUB_BUCKETS + (HISTOGRAM_MAX_EXPONENT - 3) * HISTOGRAM_SUB_BUCKETS + 1; // Values under 8 get a bucket each
+const double STATS_WINDOW_SECONDS = 1.0; // Rates and histograms are reported over windows this long
+
+/**
+ * @brief Histogram of non-negative values. Values under 8 get a bucket each and every power of two above
+ * that is split into HISTOGRAM_SUB_BUCKETS buckets, so percentiles are within 25% whatever the scale.
+ * Fixed size, so adding a value never allocates and copying one is cheap.
+ */
+class Histogram {
+    public:
+        /**
+         * @brief Construct an empty Histogram object
+         */
+        Histogram();
+
+        /**
+         * @brief Count a value
+         *
+         * @param value value to count
+         */
+        void add(uint64_t value);
+
+        /**
+         * @brief Forget every value
+         */
+        void reset();
+
+        /**
+         * @brief Get the number of values counted
+         *
+         * @return uint64_t number of values
+         */
+        uint64_t getCount() const;
+
+        /**
+         * @brief Get the mean of the values counted
+         *
+         * @return double mean, 0 if there are none
+         */
+        double getMean() const;
+
+        /**
+         * @brief Get the largest value counted
+         *
+         * @return uint64_t largest value, 0 if there are none
+         */
+        uint64_t getMax() const;
+
+        /**
+         * @brief Estimate a percentile of the values counted, as the top of the bucket it falls in
+         *
+         * @param percent percentile to get
+         * @return uint64_t upper bound of the percentile, never more than the largest value
+         */
+        uint64_t getPercentile(double percent) const;
+
+        /**
+         * @brief Write the histogram as a JSON object with its count, mean, max, percentiles and every
+         * bucket that isn't empty, as [largest value of the bucket, count] pairs
+         *
+         * @param out stream to write to
+         */
+        void writeJson(std::ostream& out) const;
+
+    private:
+        uint64_t buckets[HISTOGRAM_BUCKETS]; // Values counted in each bucket
+        uint64_t count; // Values counted
+        uint64_t sum; // Total of the values counted
+        uint64_t max; // Largest value counted
+};
+
+/**
+ * @brief Traffic of one connection, or of every connection added together
+ */
+struct ConnectionStats {
+    uint64_t messagesIn; // Messages received
+    uint64_t bytesIn; // Bytes received
+    uint64_t messagesOut; // Messages sent
+    uint64_t bytesOut; // Bytes sent
+    uint64_t windowMessagesIn; // Messages received in the current window
+    uint64_t windowBytesIn; // Bytes received in the current window
+    uint64_t windowMessagesOut; // Messages sent in the current window
+    uint64_t windowBytesOut; // Bytes sent in the current window
+    double messagesInRate; // Messages received a second over the last window
+    double bytesInRate; // Bytes received a second over the last window
+    double messagesOutRate; // Messages sent a second over the last window
+    double bytesOutRate; // Bytes sent a second over the last window
+};
+
+/**
+ * @brief Clear every counter and rate
+ *
+ * @param stats stats to clear
+ */
+void resetConnectionStats(ConnectionStats& stats);
+
+/**
+ * @brief Count a received message
+ *
+ * @param stats stats to count it in
+ * @param bytes size of the message
+ */
+void countInbound(ConnectionStats& stats, size_t bytes);
+
+/**
+ * @brief Count a sent message
+ *
+ * @param stats stats to count it in
+ * @param bytes size of the message, including its topic
+ */
+void countOutbound(ConnectionStats& stats, size_t bytes);
+
+/**
+ * @brief End the current window, turning its counts into rates
+ *
+ * @param stats stats to roll over
+ * @param seconds length of the window
+ */
+void rollConnectionStats(ConnectionStats& stats, double seconds);
+
+/**
+ * @brief Write connection stats as the members of a JSON object, without the braces
+ *
+ * @param out stream to write to
+ * @param stats stats to write
+ */
+void writeConnectionStatsJson(std::ostream& out, const ConnectionStats& stats);
+
+/**
+ * @brief Write a string as a JSON string, escaping anything that isn't printable
+ *
+ * @param out stream to write to
+ * @param value string to write
+ */
+void writeJsonString(std::ostream& out, const std::string& value);
+
+/**
+ * @brief Timings the server measures over a window
+ */
+struct ServerStats {
+    Histogram simulationMicros; // Length of each simulation tick
+    Histogram publishMicros; // Length of each send tick, building and sending every client's snapshot
+    Histogram queueDepth; // Client updates waiting for each tick
+    Histogram roundTripMicros; // Round trip time samples of every client
+    Histogram simulationAllocations; // Heap allocations made by each simulation tick
+    Histogram publishAllocations; // Heap allocations made by each send tick, ZeroMQ makes one for every message sent
+};
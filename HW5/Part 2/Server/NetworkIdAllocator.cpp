@@ -0,0 +1,38 @@
+#include "NetworkIdAllocator.hpp"
+
+/**
+ * @brief Construct a new Network Id Allocator object
+ */
+NetworkIdAllocator::NetworkIdAllocator() {
+    this->nextId = NETWORK_NO_ID + 1;
+}
+
+/**
+ * @brief Get an unused network id
+ *
+ * @param tick current send tick
+ * @return uint16_t network id, NETWORK_NO_ID if every id is in use
+ */
+uint16_t NetworkIdAllocator::allocate(uint32_t tick) {
+    if(!this->released.empty() && tick - this->released.front().tick >= NETWORK_ID_REUSE_TICKS) {
+        uint16_t id = this->released.front().id;
+        this->released.pop_front();
+        return id;
+    }
+    if(this->nextId > NETWORK_MAX_ID) {
+        return NETWORK_NO_ID;
+    }
+    return static_cast<uint16_t>(this->nextId++);
+}
+
+/**
+ * @brief Give back the id of an entity that has been removed
+ *
+ * @param id network id to release
+ * @param tick current send tick
+ */
+void NetworkIdAllocator::release(uint16_t id, uint32_t tick) {
+    if(id != NETWORK_NO_ID) {
+        this->released.push_back(ReleasedNetworkId{id, tick});
+    }
+}
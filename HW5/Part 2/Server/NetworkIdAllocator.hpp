@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+#include "Snapshot.hpp"
+#include "SnapshotHistory.hpp"
+
+const uint16_t NETWORK_MAX_ID = 0xFFFF; // Largest network id that can be given out
+const uint32_t NETWORK_ID_REUSE_TICKS = SNAPSHOT_HISTORY_SIZE + 1; // Ticks a released id waits before it is given out again
+
+/**
+ * @brief A network id that has been released and when
+ */
+struct ReleasedNetworkId {
+    uint16_t id; // Released id
+    uint32_t tick; // Tick the id was released on
+};
+
+/**
+ * @brief Gives out compact network ids to entities as they spawn. Released ids are only reused once no
+ * snapshot a client could still be deltaing against contains the old entity, otherwise the client would
+ * see the new entity as the old one moving.
+ */
+class NetworkIdAllocator {
+    public:
+        /**
+         * @brief Construct a new Network Id Allocator object
+         */
+        NetworkIdAllocator();
+
+        /**
+         * @brief Get an unused network id
+         *
+         * @param tick current send tick
+         * @return uint16_t network id, NETWORK_NO_ID if every id is in use
+         */
+        uint16_t allocate(uint32_t tick);
+
+        /**
+         * @brief Give back the id of an entity that has been removed
+         *
+         * @param id network id to release
+         * @param tick current send tick
+         */
+        void release(uint16_t id, uint32_t tick);
+
+    private:
+        uint32_t nextId; // Next id that has never been given out
+        std::deque<ReleasedNetworkId> released; // Released ids, oldest first
+};
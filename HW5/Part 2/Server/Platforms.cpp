@@ -3,11 +3,7 @@
 /**
  * @brief Construct a new Platform object with no given parameters.
  */
-Platform::Platform() {
-    setPosition(0.f, 0.f);
-    setSize(sf::Vector2f(50.f, 50.f));
-    setFillColor(sf::Color(0, 0, 0));
-}
+Platform::Platform() : BoxCollider(0.f, 0.f, 50.f, 50.f) {}
 
 /**
  * @brief Construct a new Platform object
@@ -17,99 +13,12 @@ Platform::Platform() {
  * @param width width of the platform
  * @param height height of the platform
  */
-Platform::Platform(float x, float y, float width, float height) {
-    setPosition(x, y);
-    setSize(sf::Vector2f(width, height));
-    setFillColor(sf::Color(0, 0, 0));
-}
-
-/**
- * @brief Construct a new Platform object
- * 
- * @param x x position
- * @param y y position
- * @param width width of the platform
- * @param height height of the platform
- * @param texturePath path to the texture file
- */
-Platform::Platform(float x, float y, float width, float height, const std::string& texturePath) {
-    setPosition(x, y);
-    setSize(sf::Vector2f(width, height));
-    
-    // Load and set texture
-    if (texture.loadFromFile(texturePath)) {
-        setTexture(&texture);
-    }
-}
-
-/**
- * @brief Construct a new Platform object
- * 
- * @param x x position
- * @param y y position
- * @param width width of the platform
- * @param height height of the platform
- * @param color color of the platform
- */
-Platform::Platform(float x, float y, float width, float height, sf::Color color) {
-    setPosition(x, y);
-    setSize(sf::Vector2f(width, height));
-    setFillColor(color);
-}
-
-/**
- * @brief Get the Global Bounds object
- * 
- * @return sf::FloatRect global bounds of the object.
- */
-sf::FloatRect Platform::getGlobalBounds() const {
-    return sf::RectangleShape::getGlobalBounds();
-}
-
-/**
- * @brief Override of the move function.
- * 
- * @param xOffset amount to move in the x direction.
- * @param yOffset amount to move in the y direction.
- */
-void Platform::move(float xOffset, float yOffset) {
-    setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
-}
-
-/**
- * @brief Override of the move function.
- * 
- * @param offset amount to move given a float 2D vector.
- */
-void Platform::move(sf::Vector2f offset) {
-    setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
-}
-
-/**
- * @brief Override of the getPosition function.
- * 
- * @return sf::Vector2f position of the object
- */
-sf::Vector2f Platform::getPosition() {
-    return sf::RectangleShape::getPosition();
-}
-
-/**
- * @brief Get the Movement of an object
- * 
- * @return sf::Vector2f total movement of the object in that frame
- */
-sf::Vector2f Platform::getMovement() {
-    return sf::Vector2f(0.f, 0.f);
-}
+Platform::Platform(float x, float y, float width, float height) : BoxCollider(x, y, width, height) {}
 
 /**
  * @brief Construct a new Moving Platform object with no given parameters.
  */
-MovingPlatform::MovingPlatform() {
-    setPosition(0.f, 0.f);
-    setSize(sf::Vector2f(50.f, 50.f));
-    setFillColor(sf::Color(0, 0, 0));
+MovingPlatform::MovingPlatform() : BoxCollider(0.f, 0.f, 50.f, 50.f) {
     _speed = 40.f;
     _x = 0.f;
     _y = 0.f;
@@ -133,69 +42,7 @@ MovingPlatform::MovingPlatform() {
  * @param height height of the platform
  * @param pauseLength length to pause when reaching the destination
  */
-MovingPlatform::MovingPlatform(float speed, float x, float y, float destX, float destY, float width, float height, float pauseLength) {
-    setPosition(x, y);
-    setSize(sf::Vector2f(width, height));
-    setFillColor(sf::Color(0, 0, 0));
-    _speed = speed;
-    _x = x;
-    _y = y;
-    _destX = destX;
-    _destY = destY;
-    movingForward = true;
-    _pauseLength = pauseLength;
-    paused = false;
-    totalMovement = sf::Vector2f(0.f, 0.f);
-}
-
-/**
- * @brief Construct a new Moving Platform object.
- * 
- * @param speed speed of the moving platform
- * @param x x position
- * @param y y position
- * @param destX x position to move back and forth to
- * @param destY y position to move back and forth to
- * @param width width of the platform
- * @param height height of the platform
- * @param pauseLength length to pause when reaching the destination
- * @param texturePath path to the texture file
- */
-MovingPlatform::MovingPlatform(float speed, float x, float y, float destX, float destY, float width, float height, float pauseLength, const std::string& texturePath) {
-    setPosition(x, y);
-    setSize(sf::Vector2f(width, height));
-    _speed = speed;
-    _x = x;
-    _y = y;
-    _destX = destX;
-    _destY = destY;
-    movingForward = true;
-    _pauseLength = pauseLength;
-    paused = false;
-    totalMovement = sf::Vector2f(0.f, 0.f);
-    
-    // Load and set texture
-    if (texture.loadFromFile(texturePath)) {
-        setTexture(&texture);
-    }
-}
-
-/**
- * @brief Construct a new Moving Platform object.
- * 
- *  @param speed speed of the moving platform
- * @param x x position
- * @param y y position
- * @param destX x position to move back and forth to
- * @param destY y position to move back and forth to
- * @param width width of the platform
- * @param height height of the platform
- * @param pauseLength length to pause when reaching the destination
- * @param color color of the platform
- */
-MovingPlatform::MovingPlatform(float speed, float x, float y, float destX, float destY, float width, float height, float pauseLength, sf::Color color) {
-    setPosition(x, y);
-    setSize(sf::Vector2f(width, height));
+MovingPlatform::MovingPlatform(float speed, float x, float y, float destX, float destY, float width, float height, float pauseLength) : BoxCollider(x, y, width, height) {
     _speed = speed;
     _x = x;
     _y = y;
@@ -205,44 +52,6 @@ MovingPlatform::MovingPlatform(float speed, float x, float y, float destX, float
     _pauseLength = pauseLength;
     paused = false;
     totalMovement = sf::Vector2f(0.f, 0.f);
-    setFillColor(color);
-}
-
-/**
- * @brief Get the Global Bounds object
- * 
- * @return sf::FloatRect global bounds of the object.
- */
-sf::FloatRect MovingPlatform::getGlobalBounds() const {
-    return sf::RectangleShape::getGlobalBounds();
-}
-
-/**
- * @brief Override of the move function.
- * 
- * @param xOffset amount to move in the x direction.
- * @param yOffset amount to move in the y direction.
- */
-void MovingPlatform::move(float xOffset, float yOffset) {
-    setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
-}
-
-/**
- * @brief Override of the move function.
- * 
- * @param offset amount to move given a float 2D vector.
- */
-void MovingPlatform::move(sf::Vector2f offset) {
-    setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
-}
-
-/**
- * @brief Override of the getPosition function.
- * 
- * @return sf::Vector2f position of the object
- */
-sf::Vector2f MovingPlatform::getPosition() {
-    return sf::RectangleShape::getPosition();
 }
 
 /**
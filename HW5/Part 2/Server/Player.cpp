@@ -5,121 +5,36 @@ struct KeysPressed;
 
 /**
  * @brief Construct a new Player object.
- * 
- * @param texturePath path to the texture
  */
-Player::Player(float windowWidth, float windowHeight, const std::string& texturePath) {
-    setPosition(0.f, 0.f);
+Player::Player() : BoxCollider(0.f, 0.f, PLAYER_WIDTH, PLAYER_HEIGHT) {
     _speed = 50.f;
     _gravity = 9.81f;
     _jumpSpeed = 10.f;
     jumpVelocity = 0.f;
-    _windowWidth = windowWidth;
-    _windowHeight = windowHeight;
     isJumping = false;
     totalMovement = sf::Vector2f(0.f, 0.f);
     onPlatform = false;
-    
-    // Load and set texture
-    if (texture.loadFromFile(texturePath)) {
-        setTexture(texture);
-    }
-}
-
-/**
- * @brief Construct a new Player object
- * 
- * @param texturePath path to the texture file
- * @param x x position
- * @param y y position
- * @param speed speed of the moving platform
- * @param gravity gravity to be applied once in the air
- * @param jumpSpeed power of a jump
- */
-Player::Player(float windowWidth, float windowHeight, const std::string& texturePath, float x, float y, float speed, float gravity, float jumpSpeed) {
-    setPosition(x, y);
-    _speed = speed;
-    _gravity = gravity;
-    _jumpSpeed = jumpSpeed;
-    jumpVelocity = 0.f;
-    _windowWidth = windowWidth;
-    _windowHeight = windowHeight;
-    isJumping = false;
-    onPlatform = false;
-    totalMovement = sf::Vector2f(0.f, 0.f);
-    
-    // Load and set texture
-    if (texture.loadFromFile(texturePath)) {
-        setTexture(texture);
-    }
+    collidingPlatform = nullptr;
 }
 
 /**
  * @brief Construct a new Player object
  * 
- * @param texturePath path to the texture file
  * @param x x position
  * @param y y position
  * @param speed speed of the moving platform
  * @param gravity gravity to be applied once in the air
  * @param jumpSpeed power of a jump
- * @param scaleX amount to scale the sprite by horizontally
- * @param scaleY amount to scale the sprite by vertically
  */
-Player::Player(float windowWidth, float windowHeight, const std::string& texturePath, float x, float y, float speed, float gravity, float jumpSpeed, float scaleX, float scaleY) {
-    setPosition(x, y);
-    setScale(sf::Vector2f(scaleX, scaleY));
+Player::Player(float x, float y, float speed, float gravity, float jumpSpeed) : BoxCollider(x, y, PLAYER_WIDTH, PLAYER_HEIGHT) {
     _speed = speed;
     _gravity = gravity;
     _jumpSpeed = jumpSpeed;
     jumpVelocity = 0.f;
-    _windowWidth = windowWidth;
-    _windowHeight = windowHeight;
     isJumping = false;
     onPlatform = false;
+    collidingPlatform = nullptr;
     totalMovement = sf::Vector2f(0.f, 0.f);
-    
-    // Load and set texture
-    if (texture.loadFromFile(texturePath)) {
-        setTexture(texture);
-    }
-}
-
-/**
- * @brief Get the Global Bounds object
- * 
- * @return sf::FloatRect global bounds of the object.
- */
-sf::FloatRect Player::getGlobalBounds() const {
-    return sf::Sprite::getGlobalBounds();
-}
-
-/**
- * @brief Override of the move function.
- * 
- * @param xOffset amount to move in the x direction.
- * @param yOffset amount to move in the y direction.
- */
-void Player::move(float xOffset, float yOffset) {
-    setPosition(getPosition().x + xOffset, getPosition().y + yOffset);
-}
-
-/**
- * @brief Override of the move function.
- * 
- * @param offset amount to move given a float 2D vector.
- */
-void Player::move(sf::Vector2f offset) {
-    setPosition(getPosition().x + offset.x, getPosition().y + offset.y);
-}
-
-/**
- * @brief Override of the getPosition function.
- * 
- * @return sf::Vector2f position of the object
- */
-sf::Vector2f Player::getPosition() {
-    return sf::Sprite::getPosition();
 }
 
 /**
@@ -148,28 +63,28 @@ void Player::update(float time, KeysPressed keysPressed, EventManager* manager)
         // Right or D key is pressed: move the player to the right
         totalMovement.x += _speed * time;
     }
-    if (keysPressed.Up && !isJumping) {
-        // Space or W key is pressed: the player jumps
-        isJumping = true;
-        jumpVelocity = -_jumpSpeed;
-    }
+    // if (keysPressed.Up && !isJumping) {
+    //     // Space or W key is pressed: the player jumps
+    //     isJumping = true;
+    //     jumpVelocity = -_jumpSpeed;
+    // }
 
-    bool isColliding = checkCollision(manager);
+    // bool isColliding = checkCollision(manager);
 
-    if(onPlatform && !isJumping) {
-        move(collidingPlatform->getMovement());
-    }
+    // if(onPlatform && !isJumping) {
+    //     move(collidingPlatform->getMovement());
+    // }
 
     // Fall down by gravity
-    totalMovement.y = jumpVelocity * time;
-    jumpVelocity += _gravity * sqrt(time);
+    // totalMovement.y = jumpVelocity * time;
+    // jumpVelocity += _gravity * sqrt(time);
 
     move(totalMovement);
 
-    if (onPlatform) {
-        isJumping = false;
-        jumpVelocity = 0.f;
-    }
+    // if (onPlatform) {
+    //     isJumping = false;
+    //     jumpVelocity = 0.f;
+    // }
     
 }
 
@@ -180,29 +95,25 @@ void Player::update(float time, KeysPressed keysPressed, EventManager* manager)
  */
 bool Player::checkCollision(EventManager* manager) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
+        // Still carried by the platform stood on last frame if it reaches below the player
         bool bottomCollision = false;
+        if(onPlatform && collidingPlatform) {
+            sf::FloatRect platformBounds = collidingPlatform->getCollisionBounds();
+            bottomCollision = checkBounds.top + checkBounds.height < platformBounds.top + platformBounds.height;
+        }
 
-        for(Collider* collideable : collisionObjects) {
-            if(collideable == this) {
-                continue;
-            }
-
-            sf::FloatRect collideableBounds = collideable->getGlobalBounds();
-
-            if(checkBounds.top + checkBounds.height < collideableBounds.top + collideableBounds.height && onPlatform) {
-                bottomCollision = true;
-            }
-
-            if(checkBounds.intersects(collideableBounds)) {
-                if(checkBounds.top + checkBounds.height >= collideableBounds.top && checkBounds.top < collideableBounds.top) {
-                    onPlatform = true;
-                }
-                collidingPlatform = collideable;
-                manager->registerEvent(new EventCollisionHandler(manager, new EventCollision(this, new GameObject("", collideable))));
-                return true;
+        // The server has no broadphase, the store's arrays are scanned for anything overlapping the player
+        Collider* collideable = colliderStore.findOverlap(checkBounds, this);
+        if(collideable) {
+            sf::FloatRect collideableBounds = collideable->getCollisionBounds();
+            if(checkBounds.top + checkBounds.height >= collideableBounds.top && checkBounds.top < collideableBounds.top) {
+                onPlatform = true;
             }
+            collidingPlatform = collideable;
+            manager->registerEvent(new EventCollisionHandler(manager, new EventCollision(this, new GameObject("", collideable))));
+            return true;
         }
         if(bottomCollision && !isJumping) {
             // Constants are tested to have additional movement due to collision not being directly detected every frame.
@@ -222,7 +133,7 @@ bool Player::checkCollision(EventManager* manager) {
  */
 bool Player::checkCollision(sf::FloatRect objectToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
         if(checkBounds.intersects(objectToCheck)) {
             return true;
@@ -237,11 +148,11 @@ bool Player::checkCollision(sf::FloatRect objectToCheck) {
  * @param std::vector<Collider*> bounds to check for collision
  * @return bool of whether the collide object collides with the object.
  */
-bool Player::checkCollision(std::vector<sf::FloatRect> objectsToCheck) {
+bool Player::checkCollision(const std::vector<sf::FloatRect>& objectsToCheck) {
     if(getCollisionEnabled()) {
-        sf::FloatRect checkBounds = getGlobalBounds();
+        sf::FloatRect checkBounds = getCollisionBounds();
 
-        for(sf::FloatRect bounds : objectsToCheck) {
+        for(const sf::FloatRect& bounds : objectsToCheck) {
             if(checkBounds.intersects(bounds)) {
                 return true;
             }
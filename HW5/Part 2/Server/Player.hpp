@@ -1,85 +1,40 @@
 #pragma once
-#include <SFML/Graphics.hpp>
 #include <cmath>
+#include <string>
 
 class EventManager;
 
-#include "Collider.hpp"
+#include "BoxCollider.hpp"
 
 /**
  * @brief What input keys are being currently pressed
  */
 struct KeysPressed;
 
-// Global List containing all collionable objects
-extern std::vector<Collider*> collisionObjects;
+const float PLAYER_WIDTH = 22.f; // Width of the player's sprite on the clients
+const float PLAYER_HEIGHT = 8.f; // Height of the player's sprite on the clients
 
 /**
- * @brief Class for a controlled player character
+ * @brief Class for a controlled player character. The server only simulates it, so it is a box the size of
+ * the clients' sprite and never loads the texture.
  */
-class Player : public sf::Sprite, public Collider {
+class Player : public BoxCollider {
     public:
         /**
          * @brief Construct a new Player object.
-         * 
-         * @param texturePath path to the texture
          */
-        Player(float windowWidth, float windowHeight, const std::string& texturePath);
+        Player();
 
         /**
          * @brief Construct a new Player object
          * 
-         * @param texturePath path to the texture file
          * @param x x position
          * @param y y position
          * @param speed speed of the moving platform
          * @param gravity gravity to be applied once in the air
          * @param jumpSpeed power of a jump
          */
-        Player(float windowWidth, float windowHeight, const std::string& texturePath, float x, float y, float speed, float gravity, float jumpSpeed);
-
-        /**
-         * @brief Construct a new Player object
-         * 
-         * @param texturePath path to the texture file
-         * @param x x position
-         * @param y y position
-         * @param speed speed of the moving platform
-         * @param gravity gravity to be applied once in the air
-         * @param jumpSpeed power of a jump
-         * @param scaleX amount to scale the sprite by horizontally
-         * @param scaleY amount to scale the sprite by vertically
-         */
-        Player(float windowWidth, float windowHeight, const std::string& texturePath, float x, float y, float speed, float gravity, float jumpSpeed, float scaleX, float scaleY);
-
-        /**
-         * @brief Get the Global Bounds object
-         * 
-         * @return sf::FloatRect global bounds of the object.
-         */
-        sf::FloatRect getGlobalBounds() const override;
-
-        /**
-         * @brief Override of the move function.
-         * 
-         * @param xOffset amount to move in the x direction.
-         * @param yOffset amount to move in the y direction.
-         */
-        void move(float xOffset, float yOffset) override;
-
-        /**
-         * @brief Override of the move function.
-         * 
-         * @param offset amount to move given a float 2D vector.
-         */
-        void move(sf::Vector2f offset) override;
-
-         /**
-         * @brief Override of the getPosition function.
-         * 
-         * @return sf::Vector2f position of the object
-         */
-        sf::Vector2f getPosition() override;
+        Player(float x, float y, float speed, float gravity, float jumpSpeed);
 
         /**
          * @brief Get the Movement of an object
@@ -117,18 +72,15 @@ class Player : public sf::Sprite, public Collider {
          * @param std::vector<sf::FloatRect> collideable objects to check for collision
          * @return bool of whether the collide object collides with the object.
          */
-        bool checkCollision(std::vector<sf::FloatRect> objectsToCheck);
+        bool checkCollision(const std::vector<sf::FloatRect>& objectsToCheck);
 
     private:
         float _speed; // Speed of the player
         float _gravity; // Amount that gravity affects the player
         float _jumpSpeed; // Power of the jump of the player
         float jumpVelocity; // Current jump velocity
-        float _windowWidth; // Width of the game window
-        float _windowHeight; // Height of the game window
         bool isJumping; // Is the character currently jumping?
         bool onPlatform; // Is the player on a platform?
         Collider* collidingPlatform; // Pointer to the collider of the platform the player is on
         sf::Vector2f totalMovement; // Total movement of the player
-        sf::Texture texture; // Texture of the platform
 };
\ No newline at end of file
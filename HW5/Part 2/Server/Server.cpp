@@ -1,192 +1,820 @@
 #include "Server.hpp"
 
 /**
- * @brief Will take a client message in the format ClientID,playerPositionX,playerPositionY
+ * @brief Add the state of an object to the world state
  * 
- * @param message message to parse
- * @return std::vector<std::string> vector list of parsed message
+ * @param state world state being built
+ * @param object object to add
  */
-std::vector<std::string> parseClientMessage(std::string message) {
-    std::vector<std::string> output;
-
-    std::istringstream iss(message);
-    std::string parsed;
-
-    while(std::getline(iss, parsed, ',')) {
-        output.push_back(parsed);
+void addObjectState(WorldState& state, GameObject* object) {
+    if(object && object->getNetworkId() != NETWORK_NO_ID) {
+        sf::Vector2f objectPos = object->getCollider()->getPosition();
+        sf::FloatRect objectBounds = object->getCollider()->getGlobalBounds();
+        state.entities.push_back(makeEntityState(SnapshotRecordType::OBJECT, object->getNetworkId(), object->getName(), 0, objectPos.x, objectPos.y, objectBounds.width, objectBounds.height));
     }
-
-    return output;
 }
 
 /**
- * @brief Create a Object Message object string
+ * @brief Add the state of a client's player to the world state
  * 
- * @param object object to convert into string
- * @return std::string string format of object
+ * @param state world state being built
+ * @param client client to add
  */
-std::string createObjectMessage(GameObject* object) {
-    if(object) {
-        sf::Vector2f objectPos = object->getCollider()->getPosition();
-        return "Object," + object->getName() + "," + std::to_string(objectPos.x) + "," + std::to_string(objectPos.y) + "\n";
+void addPlayerState(WorldState& state, PlayerClient* client) {
+    if(client->networkId == NETWORK_NO_ID) {
+        return;
     }
-    else {
-        return "";
+    sf::Vector2f playerPos = client->player->getPosition();
+    sf::FloatRect playerBounds = client->player->getGlobalBounds();
+    state.entities.push_back(makeEntityState(SnapshotRecordType::PLAYER, client->networkId, client->name, client->isActive ? 1 : 0, playerPos.x, playerPos.y, playerBounds.width, playerBounds.height));
+}
+
+/**
+ * @brief Queue every input in a client update that hasn't been received yet, they are simulated on the
+ * next tick. Clients resend unacknowledged inputs, so most of them will have been seen before.
+ * 
+ * @param update update from the client
+ * @param netState networking state of the client
+ */
+void queueClientInputs(const ClientUpdate& update, ClientNetState& netState) {
+    for(size_t i = 0; i < update.inputCount; i++) {
+        const InputCommand& input = update.inputs[i];
+        uint32_t lastQueued = netState.pendingInputs.empty() ? netState.lastInputSequence : netState.pendingInputs.back().sequence;
+        if(input.sequence <= lastQueued) {
+            continue;
+        }
+        if(netState.pendingInputs.size() >= INPUT_HISTORY_SIZE) {
+            break; // Client is sending faster than it could possibly play
+        }
+        netState.pendingInputs.push_back(input);
     }
 }
 
 /**
- * @brief Create a Player Message object string
+ * @brief Move a client's player to where the client update says it should be
  * 
- * @param client client to convert into string
- * @return std::string string format of player
+ * @param update update from the client
+ * @param netState networking state of the client
+ * @param player player to move
  */
-std::string createPlayerMessage(PlayerClient* client) {
-    sf::Vector2f playerPos = client->player->getPosition();
-    std::string isActiveString;
-    if(client->isActive) {
-        isActiveString = "true";
+void moveClientPlayer(const ClientUpdate& update, ClientNetState& netState, Player* player) {
+    if(AUTHORITATIVE_MOVEMENT) {
+        queueClientInputs(update, netState);
     }
     else {
-        isActiveString = "false";
+        player->setPosition(update.x, update.y);
     }
-    return "Player," + client->name + "," + isActiveString + "," + std::to_string(playerPos.x) + "," + std::to_string(playerPos.y) + "\n";
 }
 
 /**
- * @brief Create a Event Message object string
+ * @brief Get the time since a tick started
  * 
- * @param event event to convert into string
- * @return std::string string format of an event
+ * @param start when the tick started
+ * @return float microseconds since the start
  */
-std::string createEventMessage(Event* e) {
-    EventType eventType = e->getEventType();
-    std::string eventTypeString;
-    std::string eventParams;
-    if(eventType == EventType::EVENT_CLIENT_DISCONNECT) {
-        eventTypeString = "ClientDisconnect";
-        eventParams = *static_cast<std::string*>(e->getVarient(ParamType::CLIENT_NAME).getValue());
+float microsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Get the current server time
+ * 
+ * @return double seconds of a monotonic clock
+ */
+double getServerTime() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Push a player sideways out of a world object, the way clients keep their player between the
+ * sidebars. Resolving along the smaller overlap instead would push the short player out through the
+ * floor once a tick's inputs have moved it further into a sidebar than it is tall.
+ * 
+ * @param player player to move
+ * @param wall world object the player overlaps
+ */
+void pushOutSideways(Player* player, const Collider& wall) {
+    sf::FloatRect playerBounds = player->getCollisionBounds();
+    sf::FloatRect wallBounds = wall.getCollisionBounds();
+    if(playerBounds.left + playerBounds.width / 2.f < wallBounds.left + wallBounds.width / 2.f) {
+        player->move(wallBounds.left - (playerBounds.left + playerBounds.width), 0.f);
     }
     else {
-        eventTypeString = "none";
+        player->move(wallBounds.left + wallBounds.width - playerBounds.left, 0.f);
     }
-    return "Event," + eventTypeString + "," + eventParams + "\n";
 }
 
 /**
- * @brief Construct a new Server object and set up replier and publisher sockets
+ * @brief Construct a new Server object and set up receiver and publisher sockets
  */
-Server::Server() {
+Server::Server() : messagePool(MESSAGE_POOL_SIZE, MESSAGE_BUFFER_CAPACITY), sessions(CLIENT_TIMEOUT), clientUpdates(CLIENT_UPDATE_QUEUE_SIZE), snapshotWriter(SnapshotMessageType::SNAPSHOT, 0), history(SNAPSHOT_HISTORY_SIZE) {
+    this->currentTick = 0;
+    this->lastSimulationMicros = 0.f;
+    this->lastPublishMicros = 0.f;
+    this->lastPublishAllocations = 0;
+    this->simulationTick = 0;
+    this->sendTimes.resize(SNAPSHOT_HISTORY_SIZE, 0.0);
+    this->droppedUpdates = 0;
+    resetConnectionStats(this->traffic);
+    this->startTime = std::chrono::steady_clock::now();
+    this->windowStart = this->startTime;
+    this->statsDumpCsv = false;
+    this->statsDumpInterval = 0.0;
     this->context = zmq::context_t{1};
-    this->replier = zmq::socket_t{context, zmq::socket_type::rep};
+    this->receiver = zmq::socket_t{context, zmq::socket_type::router};
     this->publisher = zmq::socket_t{context, zmq::socket_type::pub};
+    this->admin = zmq::socket_t{context, zmq::socket_type::rep};
 
-    this->replier.bind("tcp://*:5555");
+    this->receiver.setsockopt(ZMQ_RCVHWM, RECEIVER_HWM);
+    this->receiver.bind("tcp://*:5555");
     this->publisher.bind("tcp://*:5556");
+    this->admin.bind(ADMIN_ENDPOINT);
     std::cout << "Successfully started server!\n";
 }
 
 /**
- * @brief Function to be run by the replier socket
+ * @brief Function to be run by the receiver socket. Clients stream their state without waiting
+ * for a reply, so one slow client never holds up another. Messages are only decoded here, the tick
+ * thread applies them.
  */
-void Server::replierFunction() {
-    bool newClient = true;
-    while(true) {
-        // Listen for clients
-        zmq::message_t message;
-        replier.recv(message, zmq::recv_flags::none);
-        std::string clientMessage = std::string(static_cast<char*>(message.data()), message.size());
+void Server::receiverFunction() {
+    ClientUpdate update;
+    try {
+        while(true) {
+            // Listen for clients, the router puts the sender's identity in front of each message
+            zmq::message_t identity;
+            zmq::message_t message;
+            if(!receiver.recv(identity, zmq::recv_flags::none) || !identity.more()) {
+                continue;
+            }
+            if(!receiver.recv(message, zmq::recv_flags::none)) {
+                continue;
+            }
+            if(message.more()) {
+                // Not something a client sends, throw away the rest of it
+                zmq::message_t extra;
+                do {
+                    if(!receiver.recv(extra, zmq::recv_flags::none)) {
+                        break;
+                    }
+                } while(extra.more());
+                continue;
+            }
+            if(message.size() < SNAPSHOT_HEADER_SIZE) {
+                // Empty or cut short, there isn't even a header to read
+                continue;
+            }
 
-        // ClientID,x,y
-        std::vector<std::string> parsedClientMessage = parseClientMessage(clientMessage);
+            this->recorder.record(TrafficDirection::INBOUND, nullptr, 0, message.data(), message.size());
 
-        std::string clientID = parsedClientMessage[0];
-        bool isActiveClient;
-        if(parsedClientMessage[1] == "true") {
-            isActiveClient = true;
+            SnapshotReader clientMessage(message.data(), message.size());
+            if(!clientMessage.isValid() || clientMessage.getMessageType() != SnapshotMessageType::CLIENT_STATE) {
+                continue;
+            }
+            if(!readClientUpdate(clientMessage, update)) {
+                continue;
+            }
+            update.messageSize = static_cast<uint32_t>(message.size());
+
+            // If the tick thread is this far behind the update is dropped, the client resends its inputs anyway
+            if(!this->clientUpdates.push(update)) {
+                this->droppedUpdates++;
+            }
         }
-        else {
-            isActiveClient = false;
+    }
+    catch(const zmq::error_t& error) {
+        // The context shutting down ends the loop, anything else is a real failure
+        if(error.num() != ETERM) {
+            throw;
+        }
+    }
+}
+
+/**
+ * @brief Record every message received and published from now on into a traffic log for the
+ * replay tool. Call before the receive and tick threads start.
+ * 
+ * @param path path of the log file
+ * @return bool false if the log couldn't be created
+ */
+bool Server::startRecording(const std::string& path) {
+    if(!this->recorder.open(path)) {
+        return false;
+    }
+    std::cout << "Recording traffic to " << path << "\n";
+    return true;
+}
+
+/**
+ * @brief Apply every client update the receive threads have queued since the last tick, then
+ * disconnect every client that has gone quiet for too long
+ */
+void Server::processClientUpdates() {
+    ClientUpdate update;
+    uint64_t depth = 0;
+    while(this->clientUpdates.pop(update)) {
+        applyClientUpdate(update);
+        depth++;
+    }
+    this->windowStats.queueDepth.add(depth);
+
+    // A client that crashed or lost its connection never says it left, it just stops sending
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(!session.used) {
+            continue;
+        }
+        if(this->sessions.isTimedOut(session, now)) {
+            std::cout << "Client " << session.client.name << " timed out\n";
+            disconnectClient(session);
+        }
+        else if(session.netState.reliableEvents.isFull()) {
+            std::cout << "Client " << session.client.name << " stopped acknowledging events\n";
+            disconnectClient(session);
+        }
+    }
+}
+
+/**
+ * @brief Apply a client update, adding the client if it's new and removing it if it has left
+ * 
+ * @param update update from the client
+ */
+void Server::applyClientUpdate(const ClientUpdate& update) {
+    ClientSession* session = this->sessions.find(update.name);
+    bool isNew = session == nullptr;
+    if(isNew) {
+        session = this->sessions.add(update.name);
+        if(!session) {
+            return; // Name collides with a connected client's
         }
-        float xPos = stof(parsedClientMessage[2]);
-        float yPos = stof(parsedClientMessage[3]);
+    }
+    // Every message counts as a heartbeat, clients stream their state every frame
+    this->sessions.heartbeat(*session, std::chrono::steady_clock::now());
 
-        // Check if there are any existing clients
-        if(clients.empty()) {
-            // Create Player
-            Player* player = new Player(300, 400, "player.png", (300 / 2) - 22.f, 400 - 40.f, 100.f, 50.f, 300.f, 1.f, 1.f);
-            player->setCollisionEnabled(true);
-            player->setPosition(xPos, yPos);
-            clients.push_back(PlayerClient{clientID, player, isActiveClient});
+    // Remember the last snapshot this client has, future snapshots are sent as a delta against it
+    ClientNetState& netState = session->netState;
+    countInbound(netState.traffic, update.messageSize);
+    countInbound(this->traffic, update.messageSize);
+    if(update.ackedTick != netState.ackedTick && this->history.find(update.ackedTick)) {
+        // Measured from our own send times, a client can only make it longer by acknowledging late
+        // and shots never rewind more than LAG_MAX_REWIND
+        double sample = getServerTime() - this->sendTimes[update.ackedTick % this->sendTimes.size()];
+        netState.roundTripTime = netState.roundTripTime == 0.0 ? sample : netState.roundTripTime + (sample - netState.roundTripTime) * ROUND_TRIP_SMOOTHING;
+        this->windowStats.roundTripMicros.add(static_cast<uint64_t>(sample * 1000000.0));
+    }
+    netState.ackedTick = update.ackedTick;
+    netState.lastSentTime = update.timestamp;
+    netState.reliableEvents.acknowledge(update.eventAck);
+    netState.capabilities = update.capabilities;
+
+    // Only send the client what is around its view
+    if(update.hasView) {
+        netState.view = makeInterestArea(SNAPSHOT_NO_TICK, update.viewLeft, update.viewTop, update.viewWidth, update.viewHeight, INTEREST_MARGIN);
+    }
+
+    if(!isNew) {
+        if(update.isActive) {
+            moveClientPlayer(update, netState, session->client.player);
+            applyShots(*session, update);
         }
         else {
-            // See if client already exists
-            int i = 0;
-            for(PlayerClient client: clients) {
-                if(client.name == clientID) {
-                    if(isActiveClient) {
-                        client.player->setPosition(xPos, yPos);
-                    }
-                    else {
-                        client.player->setCollisionEnabled(false);
-                        clients.erase(clients.begin() + i);
-                        this->replier.send(zmq::buffer("Client Disconnected"), zmq::send_flags::none);
-                        events.push_back(new EventClientDisconnect(client.name, &this->clients));
-                        goto ClientDisconnect;
-                    }
-                    newClient = false;
-                    break;
-                }
-                i++;
+            disconnectClient(*session);
+        }
+        return;
+    }
+
+    // Create Player
+    Player* player = new Player((300 / 2) - PLAYER_WIDTH, 400 - 40.f, 100.f, 50.f, 300.f);
+    player->setCollisionEnabled(true);
+    player->setPosition(update.x, update.y);
+    moveClientPlayer(update, netState, player);
+    session->client.player = player;
+    session->client.isActive = update.isActive;
+    session->overlapProxy = this->overlapPairs.insert(player, nullptr, player->getCollisionBounds(), OVERLAP_PLAYER, OVERLAP_WORLD | OVERLAP_DEATH_ZONE);
+    session->client.networkId = this->networkIds.allocate(this->currentTick);
+}
+
+/**
+ * @brief Check the shots in a client update and tell every client about each player they hit
+ * 
+ * @param shooter session of the client that fired
+ * @param update update from the client
+ */
+void Server::applyShots(const ClientSession& shooter, const ClientUpdate& update) {
+    for(size_t i = 0; i < update.shotCount; i++) {
+        const ShotReport& shot = update.shots[i];
+        if(shot.targetId == shooter.client.networkId || !checkShot(shooter, shot.targetId, shot.bounds)) {
+            continue;
+        }
+        // Only players can be hurt, a shot that hit a world object just stops
+        for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+            const ClientSession& target = this->sessions.at(slot);
+            if(target.used && target.client.networkId == shot.targetId) {
+                broadcastEvent(SnapshotEventType::PLAYER_HIT, target.client.name);
+                break;
             }
-            if(newClient) {
-                // Create Player
-                Player* player = new Player(300, 400, "player.png", (300 / 2) - 22.f, 400 - 40.f, 100.f, 50.f, 300.f, 1.f, 1.f);
-                player->setCollisionEnabled(true);
-                player->setPosition(xPos, yPos);
-                clients.push_back(PlayerClient{clientID, player, isActiveClient});
+        }
+    }
+}
+
+/**
+ * @brief Remove a client's session, its player and its network id
+ * 
+ * @param session session of the client
+ */
+void Server::removeSession(ClientSession& session) {
+    this->overlapPairs.remove(session.overlapProxy);
+    session.overlapProxy = SWEEP_NO_PROXY;
+    session.client.player->setCollisionEnabled(false);
+    delete session.client.player;
+    session.client.player = nullptr;
+    this->networkIds.release(session.client.networkId, this->currentTick);
+    this->sessions.remove(session);
+}
+
+/**
+ * @brief Remove a client that has left or stopped responding and tell every other client
+ * 
+ * @param session session of the client
+ */
+void Server::disconnectClient(ClientSession& session) {
+    std::string name = session.client.name;
+    removeSession(session);
+    broadcastEvent(SnapshotEventType::CLIENT_DISCONNECT, name);
+}
+
+/**
+ * @brief Send an event to every client over its reliable event channel
+ * 
+ * @param type type of the event
+ * @param name name the event is about
+ */
+void Server::broadcastEvent(SnapshotEventType type, const std::string& name) {
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        // A full channel means the client has stopped acknowledging, it is dropped on the next tick
+        if(session.used) {
+            session.netState.reliableEvents.push(type, name);
+        }
+    }
+}
+
+/**
+ * @brief Give an object a network id so it is replicated to clients
+ * 
+ * @param object object that has spawned
+ */
+void Server::spawnObject(GameObject* object) {
+    object->setNetworkId(this->networkIds.allocate(this->currentTick));
+}
+
+/**
+ * @brief Simulate every connected player for one tick. Runs the inputs received since the last
+ * tick, resolves collisions with the world and kills and respawns players in a death zone.
+ * 
+ * @param dt fixed length of the tick in seconds, clients are moved for at most this long each tick
+ * @param objects world objects players collide with
+ * @param deathZones areas that kill a player
+ * @param spawnPoints where players respawn
+ */
+void Server::simulateFunction(float dt, std::vector<GameObject*>* objects, std::vector<DeathZone*>* deathZones, std::vector<SpawnPoint*>* spawnPoints) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    uint64_t startAllocations = getThreadAllocations();
+    processClientUpdates();
+    if(!AUTHORITATIVE_MOVEMENT) {
+        recordLagHistory(objects);
+        this->lastSimulationMicros = microsSince(start);
+        this->windowStats.simulationMicros.add(static_cast<uint64_t>(this->lastSimulationMicros));
+        this->windowStats.simulationAllocations.add(getThreadAllocations() - startAllocations);
+        return;
+    }
+
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(!session.used) {
+            continue;
+        }
+        PlayerClient& client = session.client;
+        ClientNetState& netState = session.netState;
+
+        // A client is only moved for as long as the server has been running, inputs claiming more time
+        // than that wait for later ticks instead of speeding the player up
+        netState.inputBudget = std::min(netState.inputBudget + dt, INPUT_BUDGET_MAX);
+        size_t simulated = 0;
+        while(simulated < netState.pendingInputs.size()) {
+            const InputCommand& input = netState.pendingInputs[simulated];
+            float elapsed = getInputElapsed(input);
+            if(elapsed > netState.inputBudget) {
+                break;
             }
+            netState.inputBudget -= elapsed;
+            simulateInput(client.player, input);
+            netState.lastInputSequence = input.sequence;
+            simulated++;
         }
+        netState.pendingInputs.erase(netState.pendingInputs.begin(), netState.pendingInputs.begin() + simulated);
+    }
 
-        newClient = true;
+    // Only the world pushes players, players pass through each other like they do on the clients. A
+    // player is pushed back out every tick it overlaps the world, the collision event is only raised
+    // when it first touches something.
+    updateOverlapPairs(objects, deathZones);
+    this->killedPlayers.clear();
+    for(const OverlapPair& pair : this->overlapChanges) {
+        if(pair.state == OverlapState::END) {
+            continue;
+        }
+        // Players only pair with the world and death zones, so one side is always a player
+        const SweepProxy* playerProxy = &this->overlapPairs.getProxy(pair.proxyA);
+        const SweepProxy* otherProxy = &this->overlapPairs.getProxy(pair.proxyB);
+        if(playerProxy->category != OVERLAP_PLAYER) {
+            std::swap(playerProxy, otherProxy);
+        }
+        Player* player = static_cast<Player*>(playerProxy->collider);
 
-        this->replier.send(zmq::buffer("Reply Success!"), zmq::send_flags::none);
+        if(otherProxy->category == OVERLAP_WORLD) {
+            pushOutSideways(player, *otherProxy->collider);
+            if(pair.state == OverlapState::BEGIN) {
+                this->eventManager.registerEvent(new EventCollisionHandler(&this->eventManager, new EventCollision(player, static_cast<GameObject*>(otherProxy->owner))));
+            }
+        }
+        else if(!spawnPoints->empty() && std::find(this->killedPlayers.begin(), this->killedPlayers.end(), player) == this->killedPlayers.end()) {
+            // There is no window or camera on the server, the spawn only moves the player
+            this->killedPlayers.push_back(player);
+            this->eventManager.registerEvent(new EventDeathHandler(&this->eventManager, new EventDeath(player, spawnPoints, nullptr, nullptr, nullptr, nullptr)));
+        }
+    }
+    this->eventManager.raise();
 
-        ClientDisconnect:;
+    // Clients correct their prediction to where their player ended up after the whole tick, snapped
+    // so the server keeps simulating from exactly the position the client is sent
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(session.used) {
+            Player* player = session.client.player;
+            player->setPosition(snapPosition(player->getPosition().x, POSITION_ORIGIN_X), snapPosition(player->getPosition().y, POSITION_ORIGIN_Y));
+            session.netState.inputAckPosition = player->getPosition();
+        }
     }
+    recordLagHistory(objects);
+    this->lastSimulationMicros = microsSince(start);
+    this->windowStats.simulationMicros.add(static_cast<uint64_t>(this->lastSimulationMicros));
+    this->windowStats.simulationAllocations.add(getThreadAllocations() - startAllocations);
 }
 
 /**
- * @brief Function to be run by the publisher socket
+ * @brief Bring the bounds of every player, world object and death zone up to date and find which pairs of
+ * them began, kept or stopped overlapping since the last tick
  * 
- * @param objects objects to publish
+ * @param objects world objects
+ * @param deathZones areas that kill a player
  */
-void Server::publishFunction(std::vector<GameObject*>* objects) {
-    using namespace std::chrono_literals;
+void Server::updateOverlapPairs(std::vector<GameObject*>* objects, std::vector<DeathZone*>* deathZones) {
+    // The world lists only ever grow, anything added since the last tick gets a proxy
+    for(size_t i = 0; i < objects->size(); i++) {
+        GameObject* object = (*objects)[i];
+        if(i == this->objectProxies.size()) {
+            uint32_t proxy = SWEEP_NO_PROXY;
+            if(object) {
+                proxy = this->overlapPairs.insert(object->getCollider(), object, object->getCollider()->getCollisionBounds(), OVERLAP_WORLD, OVERLAP_PLAYER);
+            }
+            this->objectProxies.push_back(proxy);
+        }
+        else if(this->objectProxies[i] != SWEEP_NO_PROXY && object->getCollider()->hasCollisionMoved()) {
+            this->overlapPairs.update(this->objectProxies[i], object->getCollider()->getCollisionBounds());
+        }
+    }
+    for(size_t i = 0; i < deathZones->size(); i++) {
+        DeathZone* deathZone = (*deathZones)[i];
+        if(i == this->deathZoneProxies.size()) {
+            this->deathZoneProxies.push_back(this->overlapPairs.insert(deathZone, deathZone, deathZone->getCollisionBounds(), OVERLAP_DEATH_ZONE, OVERLAP_PLAYER));
+        }
+        else if(deathZone->hasCollisionMoved()) {
+            this->overlapPairs.update(this->deathZoneProxies[i], deathZone->getCollisionBounds());
+        }
+    }
 
-    std::string message; // message to publish
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(session.used && session.client.player->hasCollisionMoved()) {
+            this->overlapPairs.update(session.overlapProxy, session.client.player->getCollisionBounds());
+        }
+    }
+    // Players that stood still keep the bounds the sweep already has, the flags start over for the next tick
+    colliderStore.clearFlags(COLLIDER_FLAG_MOVED);
+    this->overlapPairs.updatePairs(this->overlapChanges);
+}
 
+/**
+ * @brief Record the bounds of every replicated object and player at the tick that just ran
+ * 
+ * @param objects world objects
+ */
+void Server::recordLagHistory(std::vector<GameObject*>* objects) {
+    this->lagCompensator.beginTick(this->simulationTick++, getServerTime());
     for(GameObject* object : *objects) {
-        message += createObjectMessage(object);
+        if(object && object->getNetworkId() != NETWORK_NO_ID) {
+            this->lagCompensator.record(object->getNetworkId(), object->getCollider()->getGlobalBounds());
+        }
     }
-    int i = 0;
-    for(PlayerClient client : clients) {
-        message += createPlayerMessage(&client);
-        if(!client.isActive) {
-            clients.erase(clients.begin() + i);
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(session.used && session.client.networkId != NETWORK_NO_ID) {
+            this->lagCompensator.record(session.client.networkId, session.client.player->getGlobalBounds());
         }
-        i++;
     }
-    int j = 0;
-    for(Event* eventHandler : events) {
-        message += createEventMessage(eventHandler);
-        events.erase(events.begin() + j);
-        j++;
+}
+
+/**
+ * @brief Check a shot a client fired against where the target was on the client's screen when it
+ * fired, rewinding by the client's measured round trip time and interpolation delay. Call from the
+ * tick thread when the client's shot arrives.
+ * 
+ * @param shooter session of the client that fired
+ * @param targetId network id of the entity shot at
+ * @param shot bounds of the projectile
+ * @return bool whether the shot hit
+ */
+bool Server::checkShot(const ClientSession& shooter, uint16_t targetId, const sf::FloatRect& shot) const {
+    double viewTime = this->lagCompensator.getRewindTime(getServerTime(), shooter.netState.roundTripTime, CLIENT_INTERPOLATION_DELAY);
+    return this->lagCompensator.checkHit(targetId, shot, viewTime);
+}
+
+/**
+ * @brief Function to be run by the publisher socket every send tick
+ * 
+ * @param objects objects to publish
+ * @param tick send tick being published
+ */
+void Server::publishFunction(std::vector<GameObject*>* objects, uint32_t tick) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    uint64_t startAllocations = getThreadAllocations();
+    processClientUpdates();
+    this->currentTick = tick;
+    this->sendTimes[tick % this->sendTimes.size()] = getServerTime();
+
+    // Record the state of the world at this tick
+    WorldState& current = this->history.beginTick(tick);
+    for(GameObject* object : *objects) {
+        addObjectState(current, object);
+    }
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(session.used) {
+            addPlayerState(current, &session.client);
+        }
+    }
+    sortWorldState(current);
+
+    // Send each client only what changed around its view since the last snapshot it acknowledged
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(!session.used) {
+            continue;
+        }
+        PlayerClient& client = session.client;
+        ClientNetState& netState = session.netState;
+        const WorldState* baseline = this->history.find(netState.ackedTick);
+        const InterestArea& baselineArea = netState.sentAreas[netState.ackedTick % netState.sentAreas.size()];
+        if(baselineArea.tick != netState.ackedTick) {
+            baseline = nullptr;
+        }
+
+        InterestArea& currentArea = netState.sentAreas[tick % netState.sentAreas.size()];
+        currentArea = netState.view;
+        currentArea.tick = tick;
+
+        if(baseline) {
+            this->snapshotWriter.reset(SnapshotMessageType::SNAPSHOT_DELTA, tick, baseline->tick);
+            writeDeltaSnapshot(this->snapshotWriter, *baseline, baselineArea, current, currentArea);
+        }
+        else {
+            // Client hasn't acknowledged anything yet or fell too far behind, resync with a full snapshot
+            this->snapshotWriter.reset(SnapshotMessageType::SNAPSHOT, tick);
+            writeFullSnapshot(this->snapshotWriter, current, currentArea);
+        }
+        // Every event the client hasn't acknowledged, so a lost snapshot never loses one
+        netState.reliableEvents.write(this->snapshotWriter);
+        if(AUTHORITATIVE_MOVEMENT && netState.lastInputSequence != 0) {
+            // Lets the client correct its prediction of its own player
+            this->snapshotWriter.addInputAck(client.name, netState.lastInputSequence, netState.inputAckPosition.x, netState.inputAckPosition.y);
+        }
+        if(netState.capabilities & CAPABILITY_SERVER_STATS) {
+            this->snapshotWriter.addServerStats(this->lastSimulationMicros, this->lastPublishMicros, this->sessions.getSessionCount(), this->lastPublishAllocations);
+        }
+        this->snapshotWriter.setTimestamp(netState.lastSentTime);
+
+        // Hand the encoded snapshot to ZMQ as is, the buffer comes back to the pool once it has been sent.
+        // Large ones, mostly full snapshots when a client joins or resyncs, are compressed into it instead.
+        MessageBuffer* buffer = this->messagePool.acquire();
+        bool compress = COMPRESS_SNAPSHOTS && (netState.capabilities & CAPABILITY_COMPRESSION) && this->snapshotWriter.size() >= COMPRESSION_THRESHOLD;
+        if(!compress || !this->snapshotCompressor.compress(this->snapshotWriter.data(), this->snapshotWriter.size(), buffer->data)) {
+            this->snapshotWriter.swapBuffer(buffer->data);
+        }
+        this->recorder.record(TrafficDirection::OUTBOUND, netState.topic.data(), netState.topic.size(), buffer->data.data(), buffer->data.size());
+        countOutbound(netState.traffic, netState.topic.size() + buffer->data.size());
+        countOutbound(this->traffic, netState.topic.size() + buffer->data.size());
+        zmq::message_t snapshot(buffer->data.data(), buffer->data.size(), MessageBufferPool::release, buffer);
+        this->publisher.send(zmq::buffer(netState.topic), zmq::send_flags::sndmore);
+        this->publisher.send(snapshot, zmq::send_flags::none);
     }
-    // Send the reply to the client
-    this->publisher.send(zmq::buffer(message), zmq::send_flags::none);
 
-    // Sleepy time                      zᶻ
-    // to avoid going too fast   ૮˶- ﻌ -˶ა⌒)ᦱ
-    std::this_thread::sleep_for(10ms);
+    // Inactive clients have been sent their final state
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(session.used && !session.client.isActive) {
+            removeSession(session);
+        }
+    }
+    this->lastPublishMicros = microsSince(start);
+    this->windowStats.publishMicros.add(static_cast<uint64_t>(this->lastPublishMicros));
+    this->lastPublishAllocations = static_cast<uint32_t>(getThreadAllocations() - startAllocations);
+    this->windowStats.publishAllocations.add(this->lastPublishAllocations);
+
+    // Outside of the measured time, answering a query or writing out the recording shouldn't show up as a slow tick
+    updateStats();
+    serveAdminRequests();
+    this->recorder.flushIfDue();
+}
+
+/**
+ * @brief End the stats window once it has run for STATS_WINDOW_SECONDS, turning its counts into rates,
+ * and write the stats to the dump file if one is due
+ */
+void Server::updateStats() {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - this->windowStart).count();
+    if(seconds < STATS_WINDOW_SECONDS) {
+        return;
+    }
+    rollConnectionStats(this->traffic, seconds);
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(session.used) {
+            rollConnectionStats(session.netState.traffic, seconds);
+        }
+    }
+    this->reportedStats = this->windowStats;
+    this->windowStats = ServerStats();
+    this->windowStart = now;
+
+    if(this->statsDump.is_open() && now >= this->nextStatsDump) {
+        if(this->statsDumpCsv) {
+            writeStatsCsv(this->statsDump, false);
+        }
+        else {
+            writeStatsJson(this->statsDump);
+            this->statsDump << "\n";
+        }
+        this->statsDump.flush();
+        this->nextStatsDump = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(this->statsDumpInterval));
+    }
+}
+
+/**
+ * @brief Answer every query waiting on the admin socket without blocking
+ */
+void Server::serveAdminRequests() {
+    zmq::message_t request;
+    while(this->admin.recv(request, zmq::recv_flags::dontwait)) {
+        std::string reply = runAdminCommand(request.to_string());
+        this->admin.send(zmq::buffer(reply), zmq::send_flags::none);
+    }
+}
+
+/**
+ * @brief Run an admin command
+ * 
+ * @param command "stats", "csv", "dump <seconds> <path>" or "dump off"
+ * @return std::string reply, JSON unless the command asked for CSV
+ */
+std::string Server::runAdminCommand(const std::string& command) {
+    std::istringstream words(command);
+    std::string name;
+    words >> name;
+
+    std::ostringstream reply;
+    if(name == "stats") {
+        writeStatsJson(reply);
+    }
+    else if(name == "csv") {
+        writeStatsCsv(reply, true);
+    }
+    else if(name == "dump") {
+        std::string argument;
+        words >> argument;
+        if(argument == "off") {
+            this->statsDump.close();
+            return "{\"ok\":true}";
+        }
+
+        double interval = std::atof(argument.c_str());
+        std::string path;
+        words >> path;
+        if(interval <= 0.0 || path.empty()) {
+            return "{\"error\":\"expected dump <seconds> <path> or dump off\"}";
+        }
+        this->statsDump.close();
+        this->statsDump.clear();
+        this->statsDump.open(path, std::ios::out | std::ios::trunc);
+        if(!this->statsDump.is_open()) {
+            return "{\"error\":\"could not create the dump file\"}";
+        }
+        this->statsDumpCsv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+        this->statsDumpInterval = interval;
+        this->nextStatsDump = std::chrono::steady_clock::now();
+        if(this->statsDumpCsv) {
+            writeStatsCsv(this->statsDump, true);
+            this->statsDump.flush();
+        }
+        std::cout << "Dumping stats to " << path << " every " << interval << " s\n";
+        return "{\"ok\":true}";
+    }
+    else {
+        return "{\"error\":\"unknown command, expected stats, csv or dump\"}";
+    }
+    return reply.str();
+}
+
+/**
+ * @brief Write the stats of the last window as one JSON object
+ * 
+ * @param out stream to write to
+ */
+void Server::writeStatsJson(std::ostream& out) {
+    out << "{\"uptime\":" << std::chrono::duration<double>(std::chrono::steady_clock::now() - this->startTime).count()
+        << ",\"window\":" << STATS_WINDOW_SECONDS
+        << ",\"clients\":" << this->sessions.getSessionCount()
+        << ",\"droppedUpdates\":" << this->droppedUpdates.load() << ",";
+    writeConnectionStatsJson(out, this->traffic);
+    out << ",\"simulationMicros\":";
+    this->reportedStats.simulationMicros.writeJson(out);
+    out << ",\"publishMicros\":";
+    this->reportedStats.publishMicros.writeJson(out);
+    out << ",\"queueDepth\":";
+    this->reportedStats.queueDepth.writeJson(out);
+    out << ",\"roundTripMicros\":";
+    this->reportedStats.roundTripMicros.writeJson(out);
+    out << ",\"simulationAllocations\":";
+    this->reportedStats.simulationAllocations.writeJson(out);
+    out << ",\"publishAllocations\":";
+    this->reportedStats.publishAllocations.writeJson(out);
+    out << ",\"messagePoolGrowth\":" << this->messagePool.getGrowth();
+
+    out << ",\"sessions\":[";
+    bool first = true;
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(!session.used) {
+            continue;
+        }
+        out << (first ? "{" : ",{") << "\"name\":";
+        writeJsonString(out, session.client.name);
+        out << ",\"roundTripMicros\":" << static_cast<uint64_t>(session.netState.roundTripTime * 1000000.0)
+            << ",\"unackedEvents\":" << session.netState.reliableEvents.size()
+            << ",\"compressed\":" << ((session.netState.capabilities & CAPABILITY_COMPRESSION) ? "true" : "false") << ",";
+        writeConnectionStatsJson(out, session.netState.traffic);
+        out << "}";
+        first = false;
+    }
+    out << "]}";
+}
+
+/**
+ * @brief Write the stats of the last window as CSV, a row for every client and one for the server
+ * 
+ * @param out stream to write to
+ * @param header whether to start with the column names
+ */
+void Server::writeStatsCsv(std::ostream& out, bool header) {
+    if(header) {
+        out << "uptime,client,messagesInPerSecond,bytesInPerSecond,messagesOutPerSecond,bytesOutPerSecond,bytesIn,bytesOut,roundTripMicros,"
+            << "clients,droppedUpdates,simulationP99Micros,publishMeanMicros,publishP99Micros,queueDepthMax,"
+            << "simulationAllocationsMax,publishAllocationsMean,publishAllocationsMax,messagePoolGrowth\n";
+    }
+    double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->startTime).count();
+    for(size_t slot = 0; slot < this->sessions.slotCount(); slot++) {
+        ClientSession& session = this->sessions.at(slot);
+        if(!session.used) {
+            continue;
+        }
+        const ConnectionStats& stats = session.netState.traffic;
+        // A name could hold anything, keep it from breaking the row
+        std::string name = session.client.name;
+        std::replace_if(name.begin(), name.end(), [](char c) { return c == ',' || c == '"' || c == '\n' || c == '\r'; }, '_');
+        out << uptime << "," << name << "," << stats.messagesInRate << "," << stats.bytesInRate << ","
+            << stats.messagesOutRate << "," << stats.bytesOutRate << "," << stats.bytesIn << "," << stats.bytesOut << ","
+            << static_cast<uint64_t>(session.netState.roundTripTime * 1000000.0) << ",,,,,,,,,,\n";
+    }
+    // The server's row has the median round trip time of every client and the server wide columns
+    const ServerStats& timings = this->reportedStats;
+    out << uptime << ",*," << this->traffic.messagesInRate << "," << this->traffic.bytesInRate << ","
+        << this->traffic.messagesOutRate << "," << this->traffic.bytesOutRate << "," << this->traffic.bytesIn << "," << this->traffic.bytesOut << ","
+        << timings.roundTripMicros.getPercentile(50) << "," << this->sessions.getSessionCount() << "," << this->droppedUpdates.load() << ","
+        << timings.simulationMicros.getPercentile(99) << "," << timings.publishMicros.getMean() << ","
+        << timings.publishMicros.getPercentile(99) << "," << timings.queueDepth.getMax() << ","
+        << timings.simulationAllocations.getMax() << "," << timings.publishAllocations.getMean() << ","
+        << timings.publishAllocations.getMax() << "," << this->messagePool.getGrowth() << "\n";
 }
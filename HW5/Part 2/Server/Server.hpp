@@ -5,12 +5,43 @@
 #include <thread>
 #include <iostream>
 #include <vector>
+#include <map>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
 #include <zmq.hpp>
 
 #include "Player.hpp"
 #include "GameObject.hpp"
 #include "Timeline.hpp"
 #include "EventManager.hpp"
+#include "Snapshot.hpp"
+#include "SnapshotHistory.hpp"
+#include "InputHistory.hpp"
+#include "HiddenObjects.hpp"
+#include "NetworkIdAllocator.hpp"
+#include "MessageBufferPool.hpp"
+#include "ClientUpdateQueue.hpp"
+#include "SessionTable.hpp"
+#include "LagCompensator.hpp"
+#include "SnapshotCompression.hpp"
+#include "TrafficLog.hpp"
+#include "NetStats.hpp"
+#include "SweepAndPrune.hpp"
+#include "AllocationCounter.hpp"
+
+const float INTEREST_MARGIN = 64.f; // Distance outside of a client's view that is still sent to it
+const int RECEIVER_HWM = 1000; // Max client messages queued on the receiver before new ones are dropped
+const bool AUTHORITATIVE_MOVEMENT = true; // Simulate players from their inputs on the server instead of trusting their positions
+const float INPUT_BUDGET_MAX = 0.25f; // Most server time a client can save up for inputs that arrive late
+const bool COMPRESS_SNAPSHOTS = true; // Compress snapshots of at least COMPRESSION_THRESHOLD bytes for clients that can read them
+const double CLIENT_INTERPOLATION_DELAY = 0.1; // Same as INTERPOLATION_DELAY in the client, how far behind it draws remote entities
+const char* const ADMIN_ENDPOINT = "tcp://127.0.0.1:5557"; // Where the admin socket answers stats queries, only reachable from this machine
+const double ROUND_TRIP_SMOOTHING = 0.1; // How much of each new round trip sample goes into a client's measured round trip time
+const uint32_t OVERLAP_PLAYER = 1; // Overlap category of players
+const uint32_t OVERLAP_WORLD = 2; // Overlap category of world objects that push players out of them
+const uint32_t OVERLAP_DEATH_ZONE = 4; // Overlap category of areas that kill players
 
 /**
  * @brief Server class responsible for handling server calls and clients
@@ -18,27 +49,191 @@
 class Server {
     public:
         /**
-         * @brief Construct a new Server object and set up replier and publisher sockets
+         * @brief Construct a new Server object and set up receiver and publisher sockets
          */
         Server();
 
         /**
-         * @brief Function to be run by the replier socket
+         * @brief Function to be run by the receiver socket. Clients stream their state without waiting
+         * for a reply, so one slow client never holds up another. Messages are only decoded here, the tick
+         * thread applies them.
+         */
+        void receiverFunction();
+
+        /**
+         * @brief Record every message received and published from now on into a traffic log for the
+         * replay tool. Call before the receive and tick threads start.
+         * 
+         * @param path path of the log file
+         * @return bool false if the log couldn't be created
+         */
+        bool startRecording(const std::string& path);
+
+        /**
+         * @brief Give an object a network id so it is replicated to clients. Call from the tick thread.
+         * 
+         * @param object object that has spawned
          */
-        void replierFunction();
+        void spawnObject(GameObject* object);
 
         /**
-         * @brief Function to be run by the publisher socket
+         * @brief Simulate every connected player for one tick. Runs the inputs received since the last
+         * tick, resolves collisions with the world and kills and respawns players in a death zone.
+         * 
+         * @param dt fixed length of the tick in seconds, clients are moved for at most this long each tick
+         * @param objects world objects players collide with
+         * @param deathZones areas that kill a player
+         * @param spawnPoints where players respawn
+         */
+        void simulateFunction(float dt, std::vector<GameObject*>* objects, std::vector<DeathZone*>* deathZones, std::vector<SpawnPoint*>* spawnPoints);
+
+        /**
+         * @brief Function to be run by the publisher socket every send tick
          * 
          * @param objects objects to publish
+         * @param tick send tick being published
+         */
+        void publishFunction(std::vector<GameObject*>* objects, uint32_t tick);
+
+        /**
+         * @brief Check a shot a client fired against where the target was on the client's screen when it
+         * fired, rewinding by the client's measured round trip time and interpolation delay. Call from the
+         * tick thread when the client's shot arrives.
+         * 
+         * @param shooter session of the client that fired
+         * @param targetId network id of the entity shot at
+         * @param shot bounds of the projectile
+         * @return bool whether the shot hit
          */
-        void publishFunction(std::vector<GameObject*>* objects);
+        bool checkShot(const ClientSession& shooter, uint16_t targetId, const sf::FloatRect& shot) const;
 
     private:
+        /**
+         * @brief Apply every client update the receive threads have queued since the last tick
+         */
+        void processClientUpdates();
+
+        /**
+         * @brief Record the bounds of every replicated object and player at the tick that just ran
+         * 
+         * @param objects world objects
+         */
+        void recordLagHistory(std::vector<GameObject*>* objects);
+
+        /**
+         * @brief Bring the bounds of every player, world object and death zone up to date and find which
+         * pairs of them began, kept or stopped overlapping since the last tick
+         * 
+         * @param objects world objects
+         * @param deathZones areas that kill a player
+         */
+        void updateOverlapPairs(std::vector<GameObject*>* objects, std::vector<DeathZone*>* deathZones);
+
+        /**
+         * @brief Apply a client update, adding the client if it's new and removing it if it has left
+         * 
+         * @param update update from the client
+         */
+        void applyClientUpdate(const ClientUpdate& update);
+
+        /**
+         * @brief Check the shots in a client update and tell every client about each player they hit
+         * 
+         * @param shooter session of the client that fired
+         * @param update update from the client
+         */
+        void applyShots(const ClientSession& shooter, const ClientUpdate& update);
+
+        /**
+         * @brief Remove a client's session, its player and its network id
+         * 
+         * @param session session of the client
+         */
+        void removeSession(ClientSession& session);
+
+        /**
+         * @brief Remove a client that has left or stopped responding and tell every other client
+         * 
+         * @param session session of the client
+         */
+        void disconnectClient(ClientSession& session);
+
+        /**
+         * @brief Send an event to every client over its reliable event channel
+         * 
+         * @param type type of the event
+         * @param name name the event is about
+         */
+        void broadcastEvent(SnapshotEventType type, const std::string& name);
+
+        /**
+         * @brief End the stats window once it has run for STATS_WINDOW_SECONDS, turning its counts into rates,
+         * and write the stats to the dump file if one is due
+         */
+        void updateStats();
+
+        /**
+         * @brief Answer every query waiting on the admin socket without blocking
+         */
+        void serveAdminRequests();
+
+        /**
+         * @brief Run an admin command
+         * 
+         * @param command "stats", "csv", "dump <seconds> <path>" or "dump off"
+         * @return std::string reply, JSON unless the command asked for CSV
+         */
+        std::string runAdminCommand(const std::string& command);
+
+        /**
+         * @brief Write the stats of the last window as one JSON object
+         * 
+         * @param out stream to write to
+         */
+        void writeStatsJson(std::ostream& out);
+
+        /**
+         * @brief Write the stats of the last window as CSV, a row for every client and one for the server
+         * 
+         * @param out stream to write to
+         * @param header whether to start with the column names
+         */
+        void writeStatsCsv(std::ostream& out, bool header);
+
+        MessageBufferPool messagePool; // Snapshot buffers handed to ZMQ, declared first so it outlives the sockets using them
         zmq::context_t context; // ZMQ socket context
-        zmq::socket_t replier; // Replier socket
+        zmq::socket_t receiver; // Router socket every client streams its state to
         zmq::socket_t publisher; // Publisher socket
-        std::vector<PlayerClient> clients; // Clients currently in the server
-        std::vector<Event*> events; // Events currently in the server
+        SessionTable sessions; // Clients currently in the server, looked up by the hash of their name
+        ClientUpdateQueue clientUpdates; // Decoded client messages from the receive thread, the only state it shares with the tick thread
+        EventManager eventManager; // Runs the collision, death and spawn events of the simulation
+        SweepAndPrune overlapPairs; // Players, world objects and death zones, finds which of them overlap each tick
+        std::vector<OverlapPair> overlapChanges; // Pairs found by the latest tick, reused every tick
+        std::vector<uint32_t> objectProxies; // Overlap proxy of each world object, in the order of the objects list
+        std::vector<uint32_t> deathZoneProxies; // Overlap proxy of each death zone, in the order of the death zones list
+        std::vector<Player*> killedPlayers; // Players already sent back to a spawn point this tick
+        SnapshotWriter snapshotWriter; // Reused buffer each client's snapshot is written into
+        SnapshotCompressor snapshotCompressor; // Compresses large snapshots, its hash table is cleared for each one but only allocated once
+        TrafficRecorder recorder; // Writes every message received and published while recording
+        SnapshotHistory history; // Recently published world states that deltas are made against
+        NetworkIdAllocator networkIds; // Gives every replicated object and player its network id
+        uint32_t currentTick; // Latest send tick, released network ids are timed by it
+        float lastSimulationMicros; // Length of the latest simulation tick in microseconds
+        LagCompensator lagCompensator; // Recent bounds of every replicated entity, shots are checked against them
+        uint32_t simulationTick; // Simulation ticks run so far
+        std::vector<double> sendTimes; // Server time each recent send tick was published at, a tick is stored at tick % size
+        float lastPublishMicros; // Length of the latest send tick in microseconds
+        uint32_t lastPublishAllocations; // Heap allocations the latest send tick made
+        zmq::socket_t admin; // Reply socket stats are queried through, served from the tick thread
+        std::atomic<uint64_t> droppedUpdates; // Client messages the receive thread dropped because the tick thread was behind
+        ConnectionStats traffic; // Messages and bytes of every client added together
+        ServerStats windowStats; // Timings of the window being measured
+        ServerStats reportedStats; // Timings of the last full window, what queries and dumps report
+        std::chrono::steady_clock::time_point startTime; // When the server started
+        std::chrono::steady_clock::time_point windowStart; // When the window being measured started
+        std::ofstream statsDump; // File the stats are periodically written to, closed when not dumping
+        bool statsDumpCsv; // Whether the dump file is CSV instead of JSON lines
+        double statsDumpInterval; // Seconds between writes to the dump file
+        std::chrono::steady_clock::time_point nextStatsDump; // When the dump file is next written
 
 };
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "SessionTable.hpp"
+
+/**
+ * @brief Hash a client's name
+ *
+ * @param name name zero padded to SNAPSHOT_NAME_LENGTH
+ * @return uint64_t 64 bit FNV-1a hash of the name
+ */
+uint64_t hashClientId(const char* name) {
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < SNAPSHOT_NAME_LENGTH; i++) {
+        hash ^= static_cast<uint8_t>(name[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Construct a new Session Table object
+ *
+ * @param timeout seconds a client can go without sending anything before it times out
+ */
+SessionTable::SessionTable(double timeout) {
+    this->timeout = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeout));
+}
+
+/**
+ * @brief Find the session of a client
+ *
+ * @param name name zero padded to SNAPSHOT_NAME_LENGTH
+ * @return ClientSession* the session, nullptr if the client isn't connected
+ */
+ClientSession* SessionTable::find(const char* name) {
+    auto found = this->slotsById.find(hashClientId(name));
+    if(found == this->slotsById.end()) {
+        return nullptr;
+    }
+    ClientSession& session = this->sessions[found->second];
+    if(std::memcmp(session.name, name, SNAPSHOT_NAME_LENGTH) != 0) {
+        return nullptr; // Another client's name has the same hash
+    }
+    return &session;
+}
+
+/**
+ * @brief Add a session for a new client. Its networking state is reset and its player is left unset.
+ * References to other sessions stay valid only until the next add.
+ *
+ * @param name name zero padded to SNAPSHOT_NAME_LENGTH
+ * @return ClientSession* the new session, nullptr if a connected client's name has the same hash
+ */
+ClientSession* SessionTable::add(const char* name) {
+    uint64_t idHash = hashClientId(name);
+    if(this->slotsById.count(idHash) != 0) {
+        return nullptr;
+    }
+
+    size_t slot;
+    if(!this->freeSlots.empty()) {
+        slot = this->freeSlots.back();
+        this->freeSlots.pop_back();
+    }
+    else {
+        slot = this->sessions.size();
+        this->sessions.emplace_back();
+    }
+
+    ClientSession& session = this->sessions[slot];
+    session.used = true;
+    session.idHash = idHash;
+    std::memcpy(session.name, name, SNAPSHOT_NAME_LENGTH);
+
+    size_t nameLength = 0;
+    while(nameLength < SNAPSHOT_NAME_LENGTH && name[nameLength] != '\0') {
+        nameLength++;
+    }
+    session.client.name.assign(name, nameLength);
+    session.client.player = nullptr;
+    session.client.isActive = false;
+    session.client.networkId = NETWORK_NO_ID;
+    session.overlapProxy = SWEEP_NO_PROXY;
+
+    // Vectors keep their memory from the slot's last client
+    ClientNetState& netState = session.netState;
+    netState.ackedTick = SNAPSHOT_NO_TICK;
+    netState.lastSentTime = 0;
+    netState.lastInputSequence = 0;
+    netState.pendingInputs.clear();
+    netState.inputBudget = 0.f;
+    netState.inputAckPosition = sf::Vector2f(0.f, 0.f);
+    netState.view.tick = SNAPSHOT_NO_TICK;
+    netState.view.enabled = false; // Send everything until the client tells us what it can see
+    netState.sentAreas.assign(SNAPSHOT_HISTORY_SIZE, netState.view);
+    netState.topic = getClientTopic(session.client.name);
+    netState.reliableEvents.reset();
+    netState.capabilities = 0;
+    netState.roundTripTime = 0.0;
+    resetConnectionStats(netState.traffic);
+
+    this->slotsById[idHash] = slot;
+    return &session;
+}
+
+/**
+ * @brief Remove a session, its slot is reused by a later client
+ *
+ * @param session session to remove
+ */
+void SessionTable::remove(ClientSession& session) {
+    if(!session.used) {
+        return;
+    }
+    session.used = false;
+    this->slotsById.erase(session.idHash);
+    this->freeSlots.push_back(&session - this->sessions.data());
+}
+
+/**
+ * @brief Record that a message from a client was just applied
+ *
+ * @param session session of the client
+ * @param now current time
+ */
+void SessionTable::heartbeat(ClientSession& session, std::chrono::steady_clock::time_point now) {
+    session.lastHeard = now;
+}
+
+/**
+ * @brief Check if a client has gone too long without sending anything
+ *
+ * @param session session of the client
+ * @param now current time
+ * @return bool whether the client has timed out
+ */
+bool SessionTable::isTimedOut(const ClientSession& session, std::chrono::steady_clock::time_point now) const {
+    return now - session.lastHeard > this->timeout;
+}
+
+/**
+ * @brief Get the number of connected clients
+ *
+ * @return size_t number of sessions
+ */
+size_t SessionTable::getSessionCount() const {
+    return this->sessions.size() - this->freeSlots.size();
+}
+
+/**
+ * @brief Get the number of slots, used or not. Loop over every slot and skip the unused ones.
+ *
+ * @return size_t number of slots
+ */
+size_t SessionTable::slotCount() const {
+    return this->sessions.size();
+}
+
+/**
+ * @brief Get the session in a slot
+ *
+ * @param slot index of the slot
+ * @return ClientSession& session in the slot, check used before touching it
+ */
+ClientSession& SessionTable::at(size_t slot) {
+    return this->sessions[slot];
+}
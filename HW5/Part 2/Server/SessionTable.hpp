@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Event.hpp"
+#include "Snapshot.hpp"
+#include "SnapshotHistory.hpp"
+#include "InputHistory.hpp"
+#include "EventChannel.hpp"
+#include "NetStats.hpp"
+#include "SweepAndPrune.hpp"
+
+const double CLIENT_TIMEOUT = 5.0; // Seconds a client can go without sending anything before it is disconnected
+
+/**
+ * @brief Networking state the server keeps for each client
+ */
+struct ClientNetState {
+    uint32_t ackedTick; // Last snapshot tick the client has acknowledged
+    uint32_t lastSentTime; // Timestamp of the newest message received from the client, echoed back in snapshots
+    uint32_t lastInputSequence; // Sequence number of the last input simulated for the client, 0 if none
+    std::vector<InputCommand> pendingInputs; // Inputs received but not simulated yet
+    float inputBudget; // Seconds of input the client may still be simulated for, grows with server time
+    sf::Vector2f inputAckPosition; // Position of the client's player after its last simulated input
+    InterestArea view; // Area the client is currently interested in
+    std::vector<InterestArea> sentAreas; // Area each recent snapshot was filtered by, a tick is stored at tick % size
+    std::string topic; // Topic the client's snapshots are published under
+    EventSender reliableEvents; // Events the client hasn't acknowledged yet, resent in every snapshot
+    uint8_t capabilities; // CAPABILITY_ bits of the client, compressed snapshots are only sent if it can read them
+    ConnectionStats traffic; // Messages and bytes received from and sent to the client
+    double roundTripTime; // Smoothed seconds between publishing a snapshot and the client acknowledging it, 0 until measured
+};
+
+/**
+ * @brief A connected client, its player and everything the server tracks for it
+ */
+struct ClientSession {
+    bool used; // Whether the slot holds a client
+    uint64_t idHash; // Hash of the client's name the session is looked up by
+    char name[SNAPSHOT_NAME_LENGTH]; // Zero padded name of the client
+    PlayerClient client; // Client and its player
+    ClientNetState netState; // Networking state of the client
+    uint32_t overlapProxy; // Proxy of the player in the server's overlap pairs, SWEEP_NO_PROXY until it has a player
+    std::chrono::steady_clock::time_point lastHeard; // When the last message from the client was applied, its heartbeat
+};
+
+/**
+ * @brief Hash a client's name
+ *
+ * @param name name zero padded to SNAPSHOT_NAME_LENGTH
+ * @return uint64_t 64 bit FNV-1a hash of the name
+ */
+uint64_t hashClientId(const char* name);
+
+/**
+ * @brief Every connected client, looked up by the hash of its name. Sessions live in fixed slots that are
+ * reused through a free list, so removing one never moves another.
+ */
+class SessionTable {
+    public:
+        /**
+         * @brief Construct a new Session Table object
+         *
+         * @param timeout seconds a client can go without sending anything before it times out
+         */
+        SessionTable(double timeout);
+
+        /**
+         * @brief Find the session of a client
+         *
+         * @param name name zero padded to SNAPSHOT_NAME_LENGTH
+         * @return ClientSession* the session, nullptr if the client isn't connected
+         */
+        ClientSession* find(const char* name);
+
+        /**
+         * @brief Add a session for a new client. Its networking state is reset and its player is left unset.
+         * References to other sessions stay valid only until the next add.
+         *
+         * @param name name zero padded to SNAPSHOT_NAME_LENGTH
+         * @return ClientSession* the new session, nullptr if a connected client's name has the same hash
+         */
+        ClientSession* add(const char* name);
+
+        /**
+         * @brief Remove a session, its slot is reused by a later client
+         *
+         * @param session session to remove
+         */
+        void remove(ClientSession& session);
+
+        /**
+         * @brief Record that a message from a client was just applied
+         *
+         * @param session session of the client
+         * @param now current time
+         */
+        void heartbeat(ClientSession& session, std::chrono::steady_clock::time_point now);
+
+        /**
+         * @brief Check if a client has gone too long without sending anything
+         *
+         * @param session session of the client
+         * @param now current time
+         * @return bool whether the client has timed out
+         */
+        bool isTimedOut(const ClientSession& session, std::chrono::steady_clock::time_point now) const;
+
+        /**
+         * @brief Get the number of connected clients
+         *
+         * @return size_t number of sessions
+         */
+        size_t getSessionCount() const;
+
+        /**
+         * @brief Get the number of slots, used or not. Loop over every slot and skip the unused ones.
+         *
+         * @return size_t number of slots
+         */
+        size_t slotCount() const;
+
+        /**
+         * @brief Get the session in a slot
+         *
+         * @param slot index of the slot
+         * @return ClientSession& session in the slot, check used before touching it
+         */
+        ClientSession& at(size_t slot);
+
+    private:
+        std::vector<ClientSession> sessions; // Slot of every session, used or not
+        std::vector<size_t> freeSlots; // Slots that aren't used
+        std::unordered_map<uint64_t, size_t> slotsById; // Slot of each client by the hash of its name
+        std::chrono::steady_clock::duration timeout; // Time without a message before a client times out
+};
@@ -0,0 +1,369 @@
+#include "SnapshotHistory.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Compare two entities by network id
+ *
+ * @param id network id of the first entity
+ * @param otherId network id of the second entity
+ * @return int less than, equal to or greater than 0 like memcmp
+ */
+static int compareEntityKey(uint16_t id, uint16_t otherId) {
+    return static_cast<int>(id) - static_cast<int>(otherId);
+}
+
+/**
+ * @brief Write a record for the state of an entity
+ *
+ * @param writer writer to add the record to
+ * @param entity entity to write
+ * @param fieldMask fields of the entity to write
+ */
+static void writeEntity(SnapshotWriter& writer, const EntityState& entity, uint8_t fieldMask) {
+    writer.addRecord(entity.type, fieldMask, entity.id, entity.name, SNAPSHOT_NAME_LENGTH, entity.flags, entity.x, entity.y);
+}
+
+/**
+ * @brief Create the state of an entity from a record containing every field
+ *
+ * @param record record to read
+ * @return EntityState state of the entity
+ */
+static EntityState entityFromRecord(const SnapshotRecordView& record) {
+    EntityState entity;
+    entity.type = record.getType();
+    entity.id = record.getId();
+    std::memcpy(entity.name, record.getNameData(), SNAPSHOT_NAME_LENGTH);
+    entity.flags = record.getFlags();
+    entity.x = record.getX();
+    entity.y = record.getY();
+    entity.width = 0.f;
+    entity.height = 0.f;
+    entity.changedFields = FIELD_ALL;
+    return entity;
+}
+
+/**
+ * @brief Read the next object or player record, skipping events, acks and stats
+ *
+ * @param reader snapshot to read from
+ * @param record view to set to the record
+ * @return bool false once every entity record has been read
+ */
+static bool nextEntityRecord(SnapshotReader& reader, SnapshotRecordView& record) {
+    while(reader.nextRecord(record)) {
+        if(record.getType() == SnapshotRecordType::OBJECT || record.getType() == SnapshotRecordType::PLAYER) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Create the state of an entity. The position is snapped to what clients will decode, so
+ * deltas are made against exactly what the clients have.
+ *
+ * @param type type of the entity
+ * @param id network id of the entity
+ * @param name name of the entity
+ * @param flags flags of the entity
+ * @param x x position
+ * @param y y position
+ * @param width width of the entity
+ * @param height height of the entity
+ * @return EntityState state of the entity
+ */
+EntityState makeEntityState(SnapshotRecordType type, uint16_t id, const std::string& name, uint8_t flags, float x, float y, float width, float height) {
+    EntityState entity;
+    entity.type = type;
+    entity.id = id;
+    std::memset(entity.name, 0, SNAPSHOT_NAME_LENGTH);
+    std::memcpy(entity.name, name.data(), std::min(name.size(), SNAPSHOT_NAME_LENGTH));
+    entity.flags = flags;
+    entity.x = snapPosition(x, POSITION_ORIGIN_X);
+    entity.y = snapPosition(y, POSITION_ORIGIN_Y);
+    entity.width = width;
+    entity.height = height;
+    entity.changedFields = FIELD_ALL;
+    return entity;
+}
+
+/**
+ * @brief Create an interest area from a client's view, grown by a margin on every side
+ *
+ * @param tick tick the area is used for
+ * @param left left of the view
+ * @param top top of the view
+ * @param width width of the view
+ * @param height height of the view
+ * @param margin distance outside of the view that is still of interest
+ * @return InterestArea area of interest
+ */
+InterestArea makeInterestArea(uint32_t tick, float left, float top, float width, float height, float margin) {
+    InterestArea area;
+    area.tick = tick;
+    area.enabled = true;
+    area.left = left - margin;
+    area.top = top - margin;
+    area.right = left + width + margin;
+    area.bottom = top + height + margin;
+    return area;
+}
+
+/**
+ * @brief Check if an entity overlaps an interest area
+ *
+ * @param area area of interest
+ * @param entity entity to check
+ * @return bool whether the entity should be sent
+ */
+bool isInInterestArea(const InterestArea& area, const EntityState& entity) {
+    if(!area.enabled) {
+        return true;
+    }
+    return entity.x <= area.right && entity.x + entity.width >= area.left && entity.y <= area.bottom && entity.y + entity.height >= area.top;
+}
+
+/**
+ * @brief Get the name of an entity as a string
+ *
+ * @param entity entity to get the name of
+ * @return std::string name of the entity
+ */
+std::string getEntityName(const EntityState& entity) {
+    size_t length = 0;
+    while(length < SNAPSHOT_NAME_LENGTH && entity.name[length] != '\0') {
+        length++;
+    }
+    return std::string(entity.name, length);
+}
+
+/**
+ * @brief Compare the name of an entity without copying it
+ *
+ * @param entity entity to compare
+ * @param name name to compare to
+ * @return bool whether the names match
+ */
+bool entityNameEquals(const EntityState& entity, const std::string& name) {
+    if(name.size() > SNAPSHOT_NAME_LENGTH || std::memcmp(entity.name, name.data(), name.size()) != 0) {
+        return false;
+    }
+    return name.size() == SNAPSHOT_NAME_LENGTH || entity.name[name.size()] == '\0';
+}
+
+/**
+ * @brief Sort the entities of a world state so it can be delta compressed
+ *
+ * @param state state to sort
+ */
+void sortWorldState(WorldState& state) {
+    std::sort(state.entities.begin(), state.entities.end(), [](const EntityState& a, const EntityState& b) {
+        return a.id < b.id;
+    });
+}
+
+/**
+ * @brief Construct a new Snapshot History object
+ *
+ * @param capacity number of ticks to keep
+ */
+SnapshotHistory::SnapshotHistory(size_t capacity) {
+    this->states.resize(capacity);
+    for(WorldState& state : this->states) {
+        state.tick = SNAPSHOT_NO_TICK;
+    }
+}
+
+/**
+ * @brief Get the slot for a new tick, replacing the oldest one. The slot's entity list is cleared
+ * but keeps its memory.
+ *
+ * @param tick tick being stored
+ * @return WorldState& state to fill in
+ */
+WorldState& SnapshotHistory::beginTick(uint32_t tick) {
+    WorldState& state = this->states[tick % this->states.size()];
+    state.tick = tick;
+    state.entities.clear();
+    return state;
+}
+
+/**
+ * @brief Find the state stored for a tick
+ *
+ * @param tick tick to find
+ * @return const WorldState* the state, or nullptr if it is no longer in the history
+ */
+const WorldState* SnapshotHistory::find(uint32_t tick) const {
+    if(tick == SNAPSHOT_NO_TICK) {
+        return nullptr;
+    }
+    const WorldState& state = this->states[tick % this->states.size()];
+    if(state.tick != tick) {
+        return nullptr;
+    }
+    return &state;
+}
+
+/**
+ * @brief Write every entity of a state within the interest area as a full snapshot
+ *
+ * @param writer writer to add the records to
+ * @param current state to write
+ * @param currentArea area the receiver is interested in
+ */
+void writeFullSnapshot(SnapshotWriter& writer, const WorldState& current, const InterestArea& currentArea) {
+    for(const EntityState& entity : current.entities) {
+        if(isInInterestArea(currentArea, entity)) {
+            writeEntity(writer, entity, FIELD_ALL);
+        }
+    }
+}
+
+/**
+ * @brief Write only the entities and fields that changed between two states. Entities are compared as
+ * the receiver saw them, so one that leaves the interest area is sent as removed and one that enters it
+ * is sent in full.
+ *
+ * @param writer writer to add the records to
+ * @param baseline state the receiver already has
+ * @param baselineArea area the baseline was filtered by when it was sent
+ * @param current state to send
+ * @param currentArea area the receiver is interested in now
+ */
+void writeDeltaSnapshot(SnapshotWriter& writer, const WorldState& baseline, const InterestArea& baselineArea, const WorldState& current, const InterestArea& currentArea) {
+    size_t b = 0;
+    size_t c = 0;
+
+    // Both lists are sorted, so walk them together like a merge
+    while(true) {
+        // Skip anything the receiver didn't have or shouldn't get
+        while(b < baseline.entities.size() && !isInInterestArea(baselineArea, baseline.entities[b])) {
+            b++;
+        }
+        while(c < current.entities.size() && !isInInterestArea(currentArea, current.entities[c])) {
+            c++;
+        }
+        if(b >= baseline.entities.size() && c >= current.entities.size()) {
+            break;
+        }
+
+        if(b >= baseline.entities.size()) {
+            writeEntity(writer, current.entities[c++], FIELD_ALL);
+            continue;
+        }
+        if(c >= current.entities.size()) {
+            writeEntity(writer, baseline.entities[b++], FIELD_REMOVED);
+            continue;
+        }
+
+        const EntityState& old = baseline.entities[b];
+        const EntityState& now = current.entities[c];
+        int compare = compareEntityKey(old.id, now.id);
+        if(compare < 0) {
+            writeEntity(writer, old, FIELD_REMOVED);
+            b++;
+        }
+        else if(compare > 0) {
+            writeEntity(writer, now, FIELD_ALL);
+            c++;
+        }
+        else {
+            uint8_t fieldMask = 0;
+            if(old.flags != now.flags) {
+                fieldMask |= FIELD_FLAGS;
+            }
+            if(old.x != now.x) {
+                fieldMask |= FIELD_X;
+            }
+            if(old.y != now.y) {
+                fieldMask |= FIELD_Y;
+            }
+            if(fieldMask != 0) {
+                writeEntity(writer, now, fieldMask);
+            }
+            b++;
+            c++;
+        }
+    }
+}
+
+/**
+ * @brief Rebuild the full world state from a received snapshot. Event records are skipped.
+ *
+ * @param reader received snapshot
+ * @param history previously received states, used as the baseline of a delta
+ * @param out state to fill in, changedFields is set for every entity
+ * @param removed filled with the entities that were removed from the snapshot
+ * @return bool false if the snapshot is a delta against a state that is no longer in the history
+ */
+bool readWorldState(SnapshotReader reader, const SnapshotHistory& history, WorldState& out, std::vector<EntityState>& removed) {
+    out.tick = reader.getTick();
+    out.entities.clear();
+    removed.clear();
+
+    SnapshotRecordView record;
+    if(reader.getMessageType() != SnapshotMessageType::SNAPSHOT_DELTA) {
+        while(nextEntityRecord(reader, record)) {
+            out.entities.push_back(entityFromRecord(record));
+        }
+        return true;
+    }
+
+    const WorldState* baseline = history.find(reader.getBaseTick());
+    if(!baseline) {
+        return false;
+    }
+
+    // Records were written in the same order as the baseline, so merge them into it
+    size_t b = 0;
+    bool hasRecord = nextEntityRecord(reader, record);
+    while(b < baseline->entities.size() || hasRecord) {
+        int compare;
+        if(!hasRecord) {
+            compare = -1;
+        }
+        else if(b >= baseline->entities.size()) {
+            compare = 1;
+        }
+        else {
+            compare = compareEntityKey(baseline->entities[b].id, record.getId());
+        }
+
+        if(compare < 0) {
+            // Unchanged since the baseline
+            out.entities.push_back(baseline->entities[b++]);
+            out.entities.back().changedFields = 0;
+        }
+        else if(compare > 0) {
+            // New since the baseline
+            if(!record.hasField(FIELD_REMOVED)) {
+                out.entities.push_back(entityFromRecord(record));
+            }
+            hasRecord = nextEntityRecord(reader, record);
+        }
+        else {
+            EntityState entity = baseline->entities[b++];
+            if(record.hasField(FIELD_REMOVED)) {
+                removed.push_back(entity);
+            }
+            else {
+                if(record.hasField(FIELD_FLAGS)) {
+                    entity.flags = record.getFlags();
+                }
+                if(record.hasField(FIELD_X)) {
+                    entity.x = record.getX();
+                }
+                if(record.hasField(FIELD_Y)) {
+                    entity.y = record.getY();
+                }
+                entity.changedFields = record.getFieldMask() & ~FIELD_QUANTIZED;
+                out.entities.push_back(entity);
+            }
+            hasRecord = nextEntityRecord(reader, record);
+        }
+    }
+    return true;
+}
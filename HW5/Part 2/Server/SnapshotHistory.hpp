@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Snapshot.hpp"
+
+const size_t SNAPSHOT_HISTORY_SIZE = 64; // Number of past snapshots kept to delta against
+
+/**
+ * @brief State of a single replicated entity within a snapshot
+ */
+struct EntityState {
+    SnapshotRecordType type; // Type of the entity
+    uint16_t id; // Network id of the entity, unique among every entity in a snapshot
+    char name[SNAPSHOT_NAME_LENGTH]; // Zero padded name of the entity
+    uint8_t flags; // isActive for players
+    float x; // X position
+    float y; // Y position
+    float width; // Width used for interest filtering, never sent
+    float height; // Height used for interest filtering, never sent
+    uint8_t changedFields; // FIELD_* values that changed when this state was read from a message
+};
+
+/**
+ * @brief Every replicated entity at a tick, sorted by network id so two states can be compared in one pass
+ */
+struct WorldState {
+    uint32_t tick; // Tick of the snapshot, SNAPSHOT_NO_TICK when the slot is unused
+    std::vector<EntityState> entities; // Sorted entity states
+};
+
+/**
+ * @brief Area of the world a client is interested in. Entities outside of it are not sent to the client.
+ */
+struct InterestArea {
+    uint32_t tick; // Tick the area was used for
+    bool enabled; // When false every entity is of interest
+    float left; // Left edge of the area
+    float top; // Top edge of the area
+    float right; // Right edge of the area
+    float bottom; // Bottom edge of the area
+};
+
+/**
+ * @brief Create the state of an entity. The position is snapped to what clients will decode, so
+ * deltas are made against exactly what the clients have.
+ *
+ * @param type type of the entity
+ * @param id network id of the entity
+ * @param name name of the entity
+ * @param flags flags of the entity
+ * @param x x position
+ * @param y y position
+ * @param width width of the entity
+ * @param height height of the entity
+ * @return EntityState state of the entity
+ */
+EntityState makeEntityState(SnapshotRecordType type, uint16_t id, const std::string& name, uint8_t flags, float x, float y, float width = 0.f, float height = 0.f);
+
+/**
+ * @brief Create an interest area from a client's view, grown by a margin on every side
+ *
+ * @param tick tick the area is used for
+ * @param left left of the view
+ * @param top top of the view
+ * @param width width of the view
+ * @param height height of the view
+ * @param margin distance outside of the view that is still of interest
+ * @return InterestArea area of interest
+ */
+InterestArea makeInterestArea(uint32_t tick, float left, float top, float width, float height, float margin);
+
+/**
+ * @brief Check if an entity overlaps an interest area
+ *
+ * @param area area of interest
+ * @param entity entity to check
+ * @return bool whether the entity should be sent
+ */
+bool isInInterestArea(const InterestArea& area, const EntityState& entity);
+
+/**
+ * @brief Get the name of an entity as a string
+ *
+ * @param entity entity to get the name of
+ * @return std::string name of the entity
+ */
+std::string getEntityName(const EntityState& entity);
+
+/**
+ * @brief Compare the name of an entity without copying it
+ *
+ * @param entity entity to compare
+ * @param name name to compare to
+ * @return bool whether the names match
+ */
+bool entityNameEquals(const EntityState& entity, const std::string& name);
+
+/**
+ * @brief Sort the entities of a world state so it can be delta compressed
+ *
+ * @param state state to sort
+ */
+void sortWorldState(WorldState& state);
+
+/**
+ * @brief Ring of the most recent world states, indexed by tick
+ */
+class SnapshotHistory {
+    public:
+        /**
+         * @brief Construct a new Snapshot History object
+         *
+         * @param capacity number of ticks to keep
+         */
+        SnapshotHistory(size_t capacity);
+
+        /**
+         * @brief Get the slot for a new tick, replacing the oldest one. The slot's entity list is cleared
+         * but keeps its memory.
+         *
+         * @param tick tick being stored
+         * @return WorldState& state to fill in
+         */
+        WorldState& beginTick(uint32_t tick);
+
+        /**
+         * @brief Find the state stored for a tick
+         *
+         * @param tick tick to find
+         * @return const WorldState* the state, or nullptr if it is no longer in the history
+         */
+        const WorldState* find(uint32_t tick) const;
+
+    private:
+        std::vector<WorldState> states; // Ring of states, a tick is stored at tick % capacity
+};
+
+/**
+ * @brief Write every entity of a state within the interest area as a full snapshot
+ *
+ * @param writer writer to add the records to
+ * @param current state to write
+ * @param currentArea area the receiver is interested in
+ */
+void writeFullSnapshot(SnapshotWriter& writer, const WorldState& current, const InterestArea& currentArea);
+
+/**
+ * @brief Write only the entities and fields that changed between two states. Entities are compared as
+ * the receiver saw them, so one that leaves the interest area is sent as removed and one that enters it
+ * is sent in full.
+ *
+ * @param writer writer to add the records to
+ * @param baseline state the receiver already has
+ * @param baselineArea area the baseline was filtered by when it was sent
+ * @param current state to send
+ * @param currentArea area the receiver is interested in now
+ */
+void writeDeltaSnapshot(SnapshotWriter& writer, const WorldState& baseline, const InterestArea& baselineArea, const WorldState& current, const InterestArea& currentArea);
+
+/**
+ * @brief Rebuild the full world state from a received snapshot. Event records are skipped.
+ *
+ * @param reader received snapshot
+ * @param history previously received states, used as the baseline of a delta
+ * @param out state to fill in, changedFields is set for every entity
+ * @param removed filled with the entities that were removed from the snapshot
+ * @return bool false if the snapshot is a delta against a state that is no longer in the history
+ */
+bool readWorldState(SnapshotReader reader, const SnapshotHistory& history, WorldState& out, std::vector<EntityState>& removed);
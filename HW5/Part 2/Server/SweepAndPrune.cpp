@@ -0,0 +1,239 @@
+#include "SweepAndPrune.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Check whether one endpoint sorts before another. Right sides go before left sides at the same x,
+ * so bounds that only touch are never both active.
+ *
+ * @param a first endpoint
+ * @param b second endpoint
+ * @return bool whether a sorts before b
+ */
+static bool endpointBefore(const SweepEndpoint& a, const SweepEndpoint& b) {
+    if(a.value != b.value) {
+        return a.value < b.value;
+    }
+    return (a.proxy & SWEEP_MAX_ENDPOINT) > (b.proxy & SWEEP_MAX_ENDPOINT);
+}
+
+/**
+ * @brief Construct an empty Sweep And Prune object
+ */
+SweepAndPrune::SweepAndPrune() {
+    this->updateStamp = 0;
+    this->count = 0;
+    this->lastSwaps = 0;
+}
+
+/**
+ * @brief Add a collider. It pairs from the next update.
+ *
+ * @param collider collider to add
+ * @param owner whatever the collider belongs to
+ * @param bounds current bounds of the collider
+ * @param category bits saying what kind of collider it is
+ * @param mask categories it pairs with
+ * @return uint32_t proxy to update or remove the collider with
+ */
+uint32_t SweepAndPrune::insert(Collider* collider, void* owner, const sf::FloatRect& bounds, uint32_t category, uint32_t mask) {
+    uint32_t proxy;
+    if(!this->freeProxies.empty()) {
+        proxy = this->freeProxies.back();
+        this->freeProxies.pop_back();
+    }
+    else {
+        proxy = static_cast<uint32_t>(this->proxies.size());
+        this->proxies.push_back(SweepProxy());
+    }
+
+    SweepProxy& entry = this->proxies[proxy];
+    entry.collider = collider;
+    entry.owner = owner;
+    entry.bounds = bounds;
+    entry.category = category;
+    entry.mask = mask;
+    entry.activeIndex = SWEEP_NO_PROXY;
+
+    // Added at the end, the next sort moves them into place
+    this->endpoints.push_back(SweepEndpoint{bounds.left, proxy});
+    this->endpoints.push_back(SweepEndpoint{bounds.left + bounds.width, proxy | SWEEP_MAX_ENDPOINT});
+    this->count++;
+    return proxy;
+}
+
+/**
+ * @brief Move a collider to new bounds. The endpoints are only re-sorted on the next update.
+ *
+ * @param proxy proxy returned when the collider was added
+ * @param bounds new bounds of the collider
+ */
+void SweepAndPrune::update(uint32_t proxy, const sf::FloatRect& bounds) {
+    this->proxies[proxy].bounds = bounds;
+}
+
+/**
+ * @brief Remove a collider. Its pairs are dropped without ending, so nothing is told about a collider that
+ * may already be gone.
+ *
+ * @param proxy proxy returned when the collider was added
+ */
+void SweepAndPrune::remove(uint32_t proxy) {
+    this->endpoints.erase(std::remove_if(this->endpoints.begin(), this->endpoints.end(), [proxy](const SweepEndpoint& endpoint) {
+        return (endpoint.proxy & ~SWEEP_MAX_ENDPOINT) == proxy;
+    }), this->endpoints.end());
+
+    // Dropped now so a new collider given the same proxy doesn't carry them on
+    for(auto overlap = this->overlaps.begin(); overlap != this->overlaps.end();) {
+        if(static_cast<uint32_t>(overlap->first >> 32) == proxy || static_cast<uint32_t>(overlap->first) == proxy) {
+            overlap = this->overlaps.erase(overlap);
+        }
+        else {
+            ++overlap;
+        }
+    }
+
+    this->proxies[proxy].collider = nullptr;
+    this->proxies[proxy].owner = nullptr;
+    this->freeProxies.push_back(proxy);
+    this->count--;
+}
+
+/**
+ * @brief Re-sort the endpoints, sweep them for overlapping pairs and compare with the last update
+ *
+ * @param pairs cleared and filled with every pair that began, carried on or ended
+ */
+void SweepAndPrune::updatePairs(std::vector<OverlapPair>& pairs) {
+    pairs.clear();
+    sortEndpoints();
+    this->updateStamp++;
+    this->active.clear();
+
+    for(const SweepEndpoint& endpoint : this->endpoints) {
+        uint32_t proxy = endpoint.proxy & ~SWEEP_MAX_ENDPOINT;
+        SweepProxy& entry = this->proxies[proxy];
+        if(endpoint.proxy & SWEEP_MAX_ENDPOINT) {
+            if(entry.activeIndex != SWEEP_NO_PROXY) {
+                // Order in the active list doesn't matter, swap the last proxy into the gap
+                uint32_t last = this->active.back();
+                this->active[entry.activeIndex] = last;
+                this->proxies[last].activeIndex = entry.activeIndex;
+                this->active.pop_back();
+                entry.activeIndex = SWEEP_NO_PROXY;
+            }
+            continue;
+        }
+        if(entry.bounds.width <= 0.f || entry.bounds.height <= 0.f) {
+            continue; // Can't overlap anything
+        }
+
+        // Everything active starts at or before this left side and ends after it, so only y is left to check
+        for(uint32_t other : this->active) {
+            const SweepProxy& otherEntry = this->proxies[other];
+            if(!(entry.category & otherEntry.mask) || !(otherEntry.category & entry.mask)) {
+                continue;
+            }
+            if(entry.bounds.top >= otherEntry.bounds.top + otherEntry.bounds.height || otherEntry.bounds.top >= entry.bounds.top + entry.bounds.height) {
+                continue;
+            }
+
+            uint32_t proxyA = std::min(proxy, other);
+            uint32_t proxyB = std::max(proxy, other);
+            auto overlap = this->overlaps.find(getPairKey(proxyA, proxyB));
+            if(overlap == this->overlaps.end()) {
+                this->overlaps.emplace(getPairKey(proxyA, proxyB), this->updateStamp);
+                pairs.push_back(OverlapPair{proxyA, proxyB, OverlapState::BEGIN});
+            }
+            else {
+                overlap->second = this->updateStamp;
+                pairs.push_back(OverlapPair{proxyA, proxyB, OverlapState::PERSIST});
+            }
+        }
+        entry.activeIndex = static_cast<uint32_t>(this->active.size());
+        this->active.push_back(proxy);
+    }
+
+    // Pairs the sweep didn't see again have ended
+    for(auto overlap = this->overlaps.begin(); overlap != this->overlaps.end();) {
+        if(overlap->second != this->updateStamp) {
+            pairs.push_back(OverlapPair{static_cast<uint32_t>(overlap->first >> 32), static_cast<uint32_t>(overlap->first), OverlapState::END});
+            overlap = this->overlaps.erase(overlap);
+        }
+        else {
+            ++overlap;
+        }
+    }
+}
+
+/**
+ * @brief Get a proxy
+ *
+ * @param proxy proxy returned when the collider was added
+ * @return const SweepProxy& collider, owner and category of the proxy
+ */
+const SweepProxy& SweepAndPrune::getProxy(uint32_t proxy) const {
+    return this->proxies[proxy];
+}
+
+/**
+ * @brief Get the number of colliders in the sweep
+ *
+ * @return size_t number of colliders
+ */
+size_t SweepAndPrune::size() const {
+    return this->count;
+}
+
+/**
+ * @brief Get the number of pairs overlapping after the last update
+ *
+ * @return size_t number of pairs
+ */
+size_t SweepAndPrune::getPairCount() const {
+    return this->overlaps.size();
+}
+
+/**
+ * @brief Get the number of endpoint swaps the last update's sort did
+ *
+ * @return size_t swaps done
+ */
+size_t SweepAndPrune::getLastSwaps() const {
+    return this->lastSwaps;
+}
+
+/**
+ * @brief Get the key a pair is remembered under
+ *
+ * @param proxyA lower of the two proxies
+ * @param proxyB higher of the two proxies
+ * @return uint64_t key of the pair
+ */
+uint64_t SweepAndPrune::getPairKey(uint32_t proxyA, uint32_t proxyB) {
+    return (static_cast<uint64_t>(proxyA) << 32) | proxyB;
+}
+
+/**
+ * @brief Insertion sort the endpoints by x, right sides before left sides at the same x so bounds that only
+ * touch don't pair
+ */
+void SweepAndPrune::sortEndpoints() {
+    for(SweepEndpoint& endpoint : this->endpoints) {
+        const sf::FloatRect& bounds = this->proxies[endpoint.proxy & ~SWEEP_MAX_ENDPOINT].bounds;
+        endpoint.value = (endpoint.proxy & SWEEP_MAX_ENDPOINT) ? bounds.left + bounds.width : bounds.left;
+    }
+
+    // Nearly sorted from the last update, so each endpoint only moves past the few it crossed since
+    this->lastSwaps = 0;
+    for(size_t i = 1; i < this->endpoints.size(); i++) {
+        SweepEndpoint endpoint = this->endpoints[i];
+        size_t j = i;
+        while(j > 0 && endpointBefore(endpoint, this->endpoints[j - 1])) {
+            this->endpoints[j] = this->endpoints[j - 1];
+            j--;
+        }
+        this->lastSwaps += i - j;
+        this->endpoints[j] = endpoint;
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <SFML/Graphics/Rect.hpp>
+
+class Collider;
+
+const uint32_t SWEEP_NO_PROXY = UINT32_MAX; // Proxy of a collider that isn't in the sweep
+const uint32_t SWEEP_MAX_ENDPOINT = 0x80000000u; // Set on the proxy of an endpoint that is the right side of its bounds
+
+/**
+ * @brief How a pair of colliders changed since the last time pairs were updated
+ */
+enum class OverlapState {
+    BEGIN, PERSIST, END
+};
+
+/**
+ * @brief Two colliders whose bounds overlap, or stopped overlapping
+ */
+struct OverlapPair {
+    uint32_t proxyA; // Lower of the two proxies
+    uint32_t proxyB; // Higher of the two proxies
+    OverlapState state; // Whether the overlap began, carried on or ended
+};
+
+/**
+ * @brief A collider in the sweep
+ */
+struct SweepProxy {
+    Collider* collider; // Collider the proxy stands for, nullptr when the slot is free
+    void* owner; // Whatever the collider belongs to, handed back to whoever reads the pairs
+    sf::FloatRect bounds; // Bounds of the collider when it was last updated
+    uint32_t category; // Bits saying what kind of collider it is
+    uint32_t mask; // Categories it pairs with, both sides have to accept each other
+    uint32_t activeIndex; // Position in the active list while sweeping, SWEEP_NO_PROXY when not in it
+};
+
+/**
+ * @brief Left or right side of a proxy's bounds
+ */
+struct SweepEndpoint {
+    float value; // x coordinate of the side
+    uint32_t proxy; // Proxy the side belongs to, with SWEEP_MAX_ENDPOINT set for the right side
+};
+
+/**
+ * @brief Sweep and prune pair finder. Both sides of every collider are kept in a list sorted along x. The
+ * list is kept between updates and re-sorted with an insertion sort, and most colliders barely move
+ * between ticks, so the sort only does a few swaps. A single sweep along it then finds every pair
+ * overlapping on x, checked on y. Pairs are remembered so every update reports which began, carried on
+ * or ended.
+ */
+class SweepAndPrune {
+    public:
+        /**
+         * @brief Construct an empty Sweep And Prune object
+         */
+        SweepAndPrune();
+
+        /**
+         * @brief Add a collider. It pairs from the next update.
+         *
+         * @param collider collider to add
+         * @param owner whatever the collider belongs to
+         * @param bounds current bounds of the collider
+         * @param category bits saying what kind of collider it is
+         * @param mask categories it pairs with
+         * @return uint32_t proxy to update or remove the collider with
+         */
+        uint32_t insert(Collider* collider, void* owner, const sf::FloatRect& bounds, uint32_t category, uint32_t mask);
+
+        /**
+         * @brief Move a collider to new bounds. The endpoints are only re-sorted on the next update.
+         *
+         * @param proxy proxy returned when the collider was added
+         * @param bounds new bounds of the collider
+         */
+        void update(uint32_t proxy, const sf::FloatRect& bounds);
+
+        /**
+         * @brief Remove a collider. Its pairs are dropped without ending, so nothing is told about a
+         * collider that may already be gone.
+         *
+         * @param proxy proxy returned when the collider was added
+         */
+        void remove(uint32_t proxy);
+
+        /**
+         * @brief Re-sort the endpoints, sweep them for overlapping pairs and compare with the last update
+         *
+         * @param pairs cleared and filled with every pair that began, carried on or ended
+         */
+        void updatePairs(std::vector<OverlapPair>& pairs);
+
+        /**
+         * @brief Get a proxy
+         *
+         * @param proxy proxy returned when the collider was added
+         * @return const SweepProxy& collider, owner and category of the proxy
+         */
+        const SweepProxy& getProxy(uint32_t proxy) const;
+
+        /**
+         * @brief Get the number of colliders in the sweep
+         *
+         * @return size_t number of colliders
+         */
+        size_t size() const;
+
+        /**
+         * @brief Get the number of pairs overlapping after the last update
+         *
+         * @return size_t number of pairs
+         */
+        size_t getPairCount() const;
+
+        /**
+         * @brief Get the number of endpoint swaps the last update's sort did
+         *
+         * @return size_t swaps done
+         */
+        size_t getLastSwaps() const;
+
+    private:
+        /**
+         * @brief Get the key a pair is remembered under
+         *
+         * @param proxyA lower of the two proxies
+         * @param proxyB higher of the two proxies
+         * @return uint64_t key of the pair
+         */
+        static uint64_t getPairKey(uint32_t proxyA, uint32_t proxyB);
+
+        /**
+         * @brief Insertion sort the endpoints by x, right sides before left sides at the same x so bounds
+         * that only touch don't pair
+         */
+        void sortEndpoints();
+
+        std::vector<SweepProxy> proxies; // Every proxy, indexed by proxy
+        std::vector<uint32_t> freeProxies; // Slots of removed proxies, reused before the list grows
+        std::vector<SweepEndpoint> endpoints; // Both sides of every proxy, sorted by x after each update
+        std::vector<uint32_t> active; // Proxies whose left side the sweep has passed but not their right side
+        std::unordered_map<uint64_t, uint32_t> overlaps; // Update each overlapping pair was last seen in, by pair key
+        uint32_t updateStamp; // Incremented on every update
+        size_t count; // Colliders in the sweep
+        size_t lastSwaps; // Swaps the last sort did
+};
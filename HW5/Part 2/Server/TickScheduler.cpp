@@ -0,0 +1,137 @@
+#include "TickScheduler.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Clear the stats of a kind of tick
+ *
+ * @param stats stats to clear
+ */
+static void resetTickStats(TickStats& stats) {
+    stats.ticks = 0;
+    stats.overruns = 0;
+    stats.skipped = 0;
+    stats.totalMs = 0.0;
+    stats.maxMs = 0.0;
+}
+
+/**
+ * @brief Add the time of a tick to its stats
+ *
+ * @param stats stats to add to
+ * @param start when the tick started
+ */
+static void recordTick(TickStats& stats, std::chrono::steady_clock::time_point start) {
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats.ticks++;
+    stats.totalMs += ms;
+    stats.maxMs = std::max(stats.maxMs, ms);
+}
+
+/**
+ * @brief Print the stats of a kind of tick
+ *
+ * @param name name of the kind of tick
+ * @param stats stats to print
+ * @param seconds seconds the stats were collected over
+ */
+static void printTickStats(const char* name, const TickStats& stats, double seconds) {
+    double average = stats.ticks > 0 ? stats.totalMs / stats.ticks : 0.0;
+    std::cout << name << ": " << stats.ticks / seconds << " Hz, avg " << average << " ms, max " << stats.maxMs
+              << " ms, " << stats.overruns << " overruns, " << stats.skipped << " skipped\n";
+}
+
+/**
+ * @brief Construct a new Tick Scheduler object
+ *
+ * @param simulationRate simulation ticks per second
+ * @param sendRate network sends per second
+ * @param policy what to do when simulation ticks fall behind
+ */
+TickScheduler::TickScheduler(int simulationRate, int sendRate, TickPolicy policy) {
+    this->simulationInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / simulationRate));
+    this->sendInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / sendRate));
+    this->policy = policy;
+    resetTickStats(this->simulationStats);
+    resetTickStats(this->sendStats);
+}
+
+/**
+ * @brief Run ticks for as long as the server runs
+ *
+ * @param simulate called every simulation tick with the fixed tick length in seconds
+ * @param send called every send tick with the send tick number
+ */
+void TickScheduler::run(std::function<void(float)> simulate, std::function<void(uint32_t)> send) {
+    using clock = std::chrono::steady_clock;
+
+    float simulationSeconds = std::chrono::duration<float>(this->simulationInterval).count();
+    clock::time_point nextSimulation = clock::now();
+    clock::time_point nextSend = nextSimulation;
+    clock::time_point statsStart = nextSimulation;
+    uint32_t sendTick = 0;
+
+    while(true) {
+        clock::time_point now = clock::now();
+
+        // Simulation ticks, every one that is due
+        int steps = 0;
+        uint64_t dropped = 0;
+        while(now >= nextSimulation) {
+            int maxSteps = this->policy == TickPolicy::CATCH_UP ? MAX_CATCH_UP_TICKS : 1;
+            if(steps == maxSteps) {
+                // Too far behind, drop the rest and carry on from the next deadline
+                dropped = (now - nextSimulation) / this->simulationInterval + 1;
+                nextSimulation += this->simulationInterval * dropped;
+                this->simulationStats.skipped += dropped;
+                break;
+            }
+
+            clock::time_point start = clock::now();
+            simulate(simulationSeconds);
+            recordTick(this->simulationStats, start);
+            nextSimulation += this->simulationInterval;
+            steps++;
+        }
+        // Late whether the ticks were caught up or dropped
+        if(steps > 1 || dropped > 0) {
+            this->simulationStats.overruns++;
+        }
+
+        // Send ticks, an old state is never worth sending so missed sends are always skipped
+        if(now >= nextSend) {
+            uint64_t missed = (now - nextSend) / this->sendInterval;
+            if(missed > 0) {
+                this->sendStats.overruns++;
+                this->sendStats.skipped += missed;
+            }
+            sendTick += static_cast<uint32_t>(missed);
+
+            clock::time_point start = clock::now();
+            send(sendTick);
+            recordTick(this->sendStats, start);
+            sendTick++;
+            nextSend += this->sendInterval * (missed + 1);
+        }
+
+        double statsSeconds = std::chrono::duration<double>(now - statsStart).count();
+        if(TICK_STATS_INTERVAL > 0 && statsSeconds >= TICK_STATS_INTERVAL) {
+            printStats(statsSeconds);
+            statsStart = now;
+        }
+
+        std::this_thread::sleep_until(std::min(nextSimulation, nextSend));
+    }
+}
+
+/**
+ * @brief Print the tick stats and reset them
+ *
+ * @param seconds seconds the stats were collected over
+ */
+void TickScheduler::printStats(double seconds) {
+    printTickStats("Simulation", this->simulationStats, seconds);
+    printTickStats("Send", this->sendStats, seconds);
+    resetTickStats(this->simulationStats);
+    resetTickStats(this->sendStats);
+}
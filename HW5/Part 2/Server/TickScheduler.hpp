@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <functional>
+
+const int SIMULATION_RATE = 60; // Simulation ticks per second
+const int MAX_CATCH_UP_TICKS = 5; // Most simulation ticks run back to back to catch up before the rest are skipped
+const int TICK_STATS_INTERVAL = 5; // Seconds between printing tick stats, 0 to never print them
+
+/**
+ * @brief What the scheduler does when it falls behind on simulation ticks
+ */
+enum class TickPolicy {
+    CATCH_UP, // Run the missed ticks back to back, up to MAX_CATCH_UP_TICKS
+    SKIP // Run one tick and drop the rest
+};
+
+/**
+ * @brief Timing of one kind of tick since the stats were last reset
+ */
+struct TickStats {
+    uint64_t ticks; // Ticks that were run
+    uint64_t overruns; // Times the scheduler woke up a whole interval or more past a deadline
+    uint64_t skipped; // Ticks that were dropped to get back on schedule
+    double totalMs; // Total time spent running ticks
+    double maxMs; // Longest tick
+};
+
+/**
+ * @brief Runs the simulation and network sends at fixed rates. Deadlines are absolute, so the time a
+ * tick takes never pushes the following ticks back.
+ */
+class TickScheduler {
+    public:
+        /**
+         * @brief Construct a new Tick Scheduler object
+         *
+         * @param simulationRate simulation ticks per second
+         * @param sendRate network sends per second
+         * @param policy what to do when simulation ticks fall behind
+         */
+        TickScheduler(int simulationRate, int sendRate, TickPolicy policy);
+
+        /**
+         * @brief Run ticks for as long as the server runs
+         *
+         * @param simulate called every simulation tick with the fixed tick length in seconds
+         * @param send called every send tick with the send tick number
+         */
+        void run(std::function<void(float)> simulate, std::function<void(uint32_t)> send);
+
+    private:
+        /**
+         * @brief Print the tick stats and reset them
+         *
+         * @param seconds seconds the stats were collected over
+         */
+        void printStats(double seconds);
+
+        std::chrono::steady_clock::duration simulationInterval; // Time between simulation ticks
+        std::chrono::steady_clock::duration sendInterval; // Time between send ticks
+        TickPolicy policy; // What to do when simulation ticks fall behind
+        TickStats simulationStats; // Simulation tick stats since the last print
+        TickStats sendStats; // Send tick stats since the last print
+};
@@ -1,8 +1,5 @@
 #pragma once
 #include <iostream>
-#include <SFML/Graphics.hpp>
-#include <SFML/Window.hpp>
-#include <SFML/System/Clock.hpp>
 #include <cmath>
 #include <mutex>
 #include <chrono>
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Log of every message a server received and published, written by the server's recording mode and
+ * played back by the replay tool.
+ *
+ * The file is a header followed by records, all values little-endian. Records are stored back to back
+ * exactly as they went over the wire, so a reader maps the file into memory and reads messages in place
+ * without copying or parsing them first. A recording cut short by the server being killed ends at the
+ * last complete record.
+ *
+ * Header (16 bytes):
+ *  0  uint32 magic
+ *  4  uint32 version
+ *  8  uint64 reserved, 0
+ *
+ * Record (16 bytes plus the topic and message):
+ *  0  uint64 time (microseconds since the recording started)
+ *  8  uint8  direction
+ *  9  uint8  reserved, 0
+ *  10 uint16 topic size (the topic an outbound snapshot was published under, 0 for inbound messages)
+ *  12 uint32 message size
+ *  16 topic, then message
+ */
+
+const uint32_t TRAFFIC_LOG_MAGIC = 0x31465254; // "TRF1" when read as bytes
+const uint32_t TRAFFIC_LOG_VERSION = 1; // Bump whenever the layout changes
+const size_t TRAFFIC_LOG_HEADER_SIZE = 16; // Size of the file header in bytes
+const size_t TRAFFIC_RECORD_HEADER_SIZE = 16; // Size of a record before its topic and message
+const size_t TRAFFIC_LOG_BUFFER_SIZE = 1 << 20; // Bytes buffered before the recorder writes to the file
+const std::chrono::seconds TRAFFIC_LOG_FLUSH_INTERVAL(1); // Longest a record waits in the buffer, and most a killed server loses
+
+/**
+ * @brief Which way a recorded message went
+ */
+enum class TrafficDirection : uint8_t {
+    INBOUND = 1, OUTBOUND = 2
+};
+
+/**
+ * @brief A message read back from a traffic log, pointing into the mapped file
+ */
+struct TrafficRecord {
+    uint64_t time; // Microseconds since the recording started
+    TrafficDirection direction; // Whether the server received or published the message
+    const uint8_t* topic; // Topic an outbound message was published under
+    size_t topicSize; // Size of the topic, 0 for inbound messages
+    const uint8_t* data; // The message as it went over the wire
+    size_t size; // Size of the message
+};
+
+/**
+ * @brief Writes every message passed to it into a traffic log. Safe to call from the receive and tick
+ * threads at the same time, a lock is only taken while recording.
+ */
+class TrafficRecorder {
+    public:
+        /**
+         * @brief Construct a new Traffic Recorder object that doesn't record until opened
+         */
+        TrafficRecorder();
+
+        /**
+         * @brief Destroy the Traffic Recorder object, writing out everything recorded
+         */
+        ~TrafficRecorder();
+
+        /**
+         * @brief Start recording into a file, replacing it if it exists
+         *
+         * @param path path of the log file
+         * @return bool false if the file couldn't be created
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Check if the recorder is recording
+         *
+         * @return bool whether a log file is open
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Record a message, timed by when this is called
+         *
+         * @param direction whether the message was received or published
+         * @param topic topic the message was published under, nullptr for none
+         * @param topicSize size of the topic
+         * @param data the message
+         * @param size size of the message
+         */
+        void record(TrafficDirection direction, const void* topic, size_t topicSize, const void* data, size_t size);
+
+        /**
+         * @brief Write everything recorded so far to the file if TRAFFIC_LOG_FLUSH_INTERVAL has passed since
+         * the last time, so it survives the server being killed. Only one thread may call this.
+         */
+        void flushIfDue();
+
+        /**
+         * @brief Stop recording and close the file
+         */
+        void close();
+
+    private:
+        std::mutex mutex; // Guards the file between the receive and tick threads
+        std::FILE* file; // Log being written, nullptr when not recording
+        std::atomic<bool> recording; // Whether a log is open, checked without taking the lock
+        std::vector<char> fileBuffer; // Buffer the file writes through
+        std::chrono::steady_clock::time_point start; // When the recording started, record times are relative to it
+        std::chrono::steady_clock::time_point nextFlush; // When the buffer is next written to the file
+};
+
+/**
+ * @brief Reads a traffic log by mapping it into memory, every record points straight into the file
+ */
+class TrafficLogReader {
+    public:
+        /**
+         * @brief Construct a new Traffic Log Reader object with no log open
+         */
+        TrafficLogReader();
+
+        /**
+         * @brief Destroy the Traffic Log Reader object, unmapping the log
+         */
+        ~TrafficLogReader();
+
+        /**
+         * @brief Map a log file into memory
+         *
+         * @param path path of the log file
+         * @return bool false if the file can't be read or isn't a traffic log
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Read the next record
+         *
+         * @param record filled with the record, valid until the reader is closed
+         * @return bool false at the end of the log
+         */
+        bool next(TrafficRecord& record);
+
+        /**
+         * @brief Go back to the first record
+         */
+        void rewind();
+
+        /**
+         * @brief Get the size of the log
+         *
+         * @return size_t size of the file in bytes
+         */
+        size_t size() const;
+
+        /**
+         * @brief Unmap the log
+         */
+        void close();
+
+    private:
+        const uint8_t* mapped; // Start of the mapped file, nullptr when no log is open
+        size_t mappedSize; // Size of the mapped file
+        size_t offset; // Offset of the next record
+};
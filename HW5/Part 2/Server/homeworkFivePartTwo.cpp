@@ -1,6 +1,4 @@
 #include <iostream>
-#include <SFML/Graphics.hpp>
-#include <SFML/Window.hpp>
 #include <cmath>
 #include <zmq.hpp>
 
@@ -12,6 +10,7 @@
 #include "Thread.hpp"
 #include "Timeline.hpp"
 #include "Server.hpp"
+#include "TickScheduler.hpp"
 
 // Global window size
 int WINDOW_WIDTH = 300;
@@ -20,6 +19,8 @@ int WINDOW_HEIGHT = 400;
 Timeline gameTime = Timeline(1);
 
 std::vector<GameObject*> objects;
+std::vector<DeathZone*> deathZones;
+std::vector<SpawnPoint*> spawnPoints;
 
 /**
  * @brief Jayden Sansom, jksanso2
@@ -27,47 +28,51 @@ std::vector<GameObject*> objects;
  * 
  * @return int exit code
  */
-int main() {
+int main(int argc, char** argv) {
 
     // Mutex to handle locking, condition variable to handle notifications between threads
     std::mutex m;
     std::condition_variable cv;
 
     Server server = Server();
+    if(argc >= 3 && std::string(argv[1]) == "record" && !server.startRecording(argv[2])) {
+        std::cout << "Could not create " << argv[2] << "\n";
+        return 1;
+    }
     Thread reciverThread = Thread(0, nullptr, &m, &cv, [&]() {
-        server.replierFunction();
+        server.receiverFunction();
     });
     std::thread runReplier(run_wrapper, &reciverThread);
 
     // Create sidebar left
-    Platform* sidebar1 = new Platform(0.f, 0.f, 15.f, WINDOW_HEIGHT, sf::Color(0, 0, 0, 0));
+    Platform* sidebar1 = new Platform(0.f, 0.f, 15.f, WINDOW_HEIGHT);
     sidebar1->setCollisionEnabled(true);
     GameObject sidebar1Obj = GameObject("sidebar1", sidebar1);
+    server.spawnObject(&sidebar1Obj);
     objects.push_back(&sidebar1Obj);
 
     // Create sidebar right
-    Platform* sidebar2 = new Platform(WINDOW_WIDTH - 15.f, 0.f, 15.f, WINDOW_HEIGHT, sf::Color(0, 0, 0, 0));
+    Platform* sidebar2 = new Platform(WINDOW_WIDTH - 15.f, 0.f, 15.f, WINDOW_HEIGHT);
     sidebar2->setCollisionEnabled(true);
     GameObject sidebar2Obj = GameObject("sidebar2", sidebar2);
+    server.spawnObject(&sidebar2Obj);
     objects.push_back(&sidebar2Obj);
 
-    // Set up time variables
-    float previousTime = gameTime.getTime();
-    float currentTime, elapsed;
-
-    while(true) {
-        if(gameTime.isPaused()) {
-            elapsed = 0.f; // It just works "¯\_(ツ)_/¯ "
-        }
-        else {
-            currentTime = gameTime.getTime();
-            elapsed = (currentTime - previousTime) / 1000.f;
-        }
+    // Catch anything that ends up below the screen
+    DeathZone* deathZone = new DeathZone(-10000.f, WINDOW_HEIGHT + 100.f, 20000.f, 100.f);
+    deathZones.push_back(deathZone);
 
-        server.publishFunction(&objects);
+    // Same place the clients start their player
+    SpawnPoint* spawnPoint = new SpawnPoint((WINDOW_WIDTH / 2) - 22.f, WINDOW_HEIGHT - 40.f);
+    spawnPoints.push_back(spawnPoint);
 
-        previousTime = currentTime;
-    }
+    // Simulate and publish at fixed rates
+    TickScheduler scheduler(SIMULATION_RATE, SNAPSHOT_TICK_RATE, TickPolicy::CATCH_UP);
+    scheduler.run([&](float elapsed) {
+        server.simulateFunction(elapsed, &objects, &deathZones, &spawnPoints);
+    }, [&](uint32_t tick) {
+        server.publishFunction(&objects, tick);
+    });
 
     return 0; // Return on end
 }
\ No newline at end of file